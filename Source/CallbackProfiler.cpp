@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+	CallbackProfiler.cpp
+	Created: 24 Oct 2026 5:27:03pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "CallbackProfiler.h"
+
+CallbackProfiler::CallbackProfiler()
+	: ticksPerMicrosecond(juce::Time::getHighResolutionTicksPerSecond() / 1.0e6)
+{
+	clear();
+}
+
+void CallbackProfiler::prepare(double _sampleRate)
+{
+	sampleRate = _sampleRate;
+	resetPending = false;
+	clear();
+}
+
+void CallbackProfiler::beginCallback()
+{
+	if (resetPending.exchange(false))
+	{
+		clear();
+	}
+
+	callbackDeckTicks.fill(0);
+	callbackStart = juce::Time::getHighResolutionTicks();
+}
+
+void CallbackProfiler::addDeckTime(int deckIndex, juce::int64 ticks)
+{
+	if (juce::isPositiveAndBelow(deckIndex, numDecks))
+	{
+		callbackDeckTicks[static_cast<size_t>(deckIndex)] += ticks;
+	}
+}
+
+void CallbackProfiler::endCallback(int numSamples)
+{
+	const auto ticks = juce::Time::getHighResolutionTicks() - callbackStart;
+	const auto micros = static_cast<juce::uint32>(ticks / ticksPerMicrosecond);
+
+	const int bin = juce::jmin(numBins - 1, static_cast<int>(micros / binMicroseconds));
+	histogram[static_cast<size_t>(bin)].fetch_add(1, std::memory_order_relaxed);
+
+	// Longer than the block lasts and the device runs out of audio
+	const float blockMicros = static_cast<float>(numSamples * 1.0e6 / sampleRate);
+	blockMicroseconds.store(blockMicros, std::memory_order_relaxed);
+
+	if (numSamples > 0 && micros > blockMicros)
+	{
+		numDeadlineMisses.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	totalMicroseconds.fetch_add(micros, std::memory_order_relaxed);
+
+	if (micros > maxMicroseconds.load(std::memory_order_relaxed))
+	{
+		maxMicroseconds.store(micros, std::memory_order_relaxed);
+	}
+
+	for (size_t deck = 0; deck < numDecks; ++deck)
+	{
+		const auto deckMicros = static_cast<juce::uint32>(callbackDeckTicks[deck] / ticksPerMicrosecond);
+		deckTotalMicroseconds[deck].fetch_add(deckMicros, std::memory_order_relaxed);
+
+		if (deckMicros > deckMaxMicroseconds[deck].load(std::memory_order_relaxed))
+		{
+			deckMaxMicroseconds[deck].store(deckMicros, std::memory_order_relaxed);
+		}
+	}
+
+	// Counted last, so a snapshot never has more callbacks than times added
+	numCallbacks.fetch_add(1, std::memory_order_release);
+}
+
+void CallbackProfiler::reset()
+{
+	resetPending = true;
+}
+
+void CallbackProfiler::clear()
+{
+	for (auto& count : histogram)
+	{
+		count.store(0, std::memory_order_relaxed);
+	}
+
+	for (size_t deck = 0; deck < numDecks; ++deck)
+	{
+		deckTotalMicroseconds[deck].store(0, std::memory_order_relaxed);
+		deckMaxMicroseconds[deck].store(0, std::memory_order_relaxed);
+	}
+
+	numDeadlineMisses.store(0, std::memory_order_relaxed);
+	totalMicroseconds.store(0, std::memory_order_relaxed);
+	maxMicroseconds.store(0, std::memory_order_relaxed);
+	numCallbacks.store(0, std::memory_order_release);
+}
+
+CallbackProfiler::Snapshot CallbackProfiler::getSnapshot() const
+{
+	Snapshot snapshot;
+
+	snapshot.numCallbacks = numCallbacks.load(std::memory_order_acquire);
+	snapshot.numDeadlineMisses = numDeadlineMisses.load(std::memory_order_relaxed);
+	snapshot.blockMilliseconds = blockMicroseconds.load(std::memory_order_relaxed) / 1000.0;
+	snapshot.maxMilliseconds = maxMicroseconds.load(std::memory_order_relaxed) / 1000.0;
+
+	const double callbacks = static_cast<double>(juce::jmax<juce::uint64>(1, snapshot.numCallbacks));
+	snapshot.meanMilliseconds = totalMicroseconds.load(std::memory_order_relaxed) / callbacks / 1000.0;
+
+	for (size_t deck = 0; deck < numDecks; ++deck)
+	{
+		snapshot.deckMeanMilliseconds[deck] = deckTotalMicroseconds[deck].load(std::memory_order_relaxed) / callbacks / 1000.0;
+		snapshot.deckMaxMilliseconds[deck] = deckMaxMicroseconds[deck].load(std::memory_order_relaxed) / 1000.0;
+	}
+
+	for (size_t bin = 0; bin < numBins; ++bin)
+	{
+		snapshot.histogram[bin] = histogram[bin].load(std::memory_order_relaxed);
+	}
+
+	return snapshot;
+}
+
+double CallbackProfiler::Snapshot::getPercentileMilliseconds(double percentile) const
+{
+	juce::uint64 total = 0;
+
+	for (auto count : histogram)
+	{
+		total += count;
+	}
+
+	if (total == 0)
+	{
+		return 0.0;
+	}
+
+	const double wanted = total * juce::jlimit(0.0, 100.0, percentile) / 100.0;
+	juce::uint64 counted = 0;
+
+	for (int bin = 0; bin < numBins; ++bin)
+	{
+		counted += histogram[static_cast<size_t>(bin)];
+
+		if (counted >= wanted)
+		{
+			return (bin + 1) * binMicroseconds / 1000.0;
+		}
+	}
+
+	return numBins * binMicroseconds / 1000.0;
+}
+
+bool CallbackProfiler::exportCsv(const juce::File& file, int deviceXRuns) const
+{
+	const auto snapshot = getSnapshot();
+
+	juce::String csv;
+	csv << "name,value\n"
+		<< "callbacks," << juce::String(snapshot.numCallbacks) << "\n"
+		<< "deadline_misses," << juce::String(snapshot.numDeadlineMisses) << "\n"
+		<< "device_xruns," << deviceXRuns << "\n"
+		<< "block_ms," << juce::String(snapshot.blockMilliseconds, 3) << "\n"
+		<< "mean_ms," << juce::String(snapshot.meanMilliseconds, 3) << "\n"
+		<< "p50_ms," << juce::String(snapshot.getPercentileMilliseconds(50.0), 3) << "\n"
+		<< "p99_ms," << juce::String(snapshot.getPercentileMilliseconds(99.0), 3) << "\n"
+		<< "max_ms," << juce::String(snapshot.maxMilliseconds, 3) << "\n";
+
+	for (int deck = 0; deck < numDecks; ++deck)
+	{
+		const juce::String name = "deck_" + juce::String::charToString(static_cast<juce::juce_wchar>('a' + deck));
+
+		csv << name << "_mean_ms," << juce::String(snapshot.deckMeanMilliseconds[static_cast<size_t>(deck)], 3) << "\n"
+			<< name << "_max_ms," << juce::String(snapshot.deckMaxMilliseconds[static_cast<size_t>(deck)], 3) << "\n";
+	}
+
+	csv << "\nbin_start_ms,bin_end_ms,callbacks\n";
+
+	for (int bin = 0; bin < numBins; ++bin)
+	{
+		csv << juce::String(bin * binMicroseconds / 1000.0, 2) << ","
+			<< juce::String((bin + 1) * binMicroseconds / 1000.0, 2) << ","
+			<< juce::String(snapshot.histogram[static_cast<size_t>(bin)]) << "\n";
+	}
+
+	return file.replaceWithText(csv);
+}
@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+	CallbackProfiler.h
+	Created: 24 Oct 2026 5:27:03pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+/**
+ * CallbackProfiler class times every audio callback, and the part of it
+ * each deck takes, to catch the audio thread slowing down while playing.
+ *
+ * Callback durations are counted in a histogram of 50 microsecond bins,
+ * and a callback taking longer than its block lasts is counted as a
+ * deadline miss, the block the device would play late.
+ *
+ * The audio thread only adds to atomic counters, without locks or
+ * allocation. The message thread reads them at any time, so a snapshot
+ * taken mid-callback may be a callback behind in places, and resetting is
+ * left to the audio thread at its next callback.
+ */
+class CallbackProfiler
+{
+public:
+	/**
+	 * Number of decks timed.
+	 */
+	static constexpr int numDecks = 2;
+
+	/**
+	 * Number of histogram bins and the duration each covers. The last bin
+	 * also counts every longer callback.
+	 */
+	static constexpr int numBins = 400;
+	static constexpr double binMicroseconds = 50.0;
+
+	/**
+	 * Statistics read from the profiler.
+	 */
+	struct Snapshot
+	{
+		juce::uint64 numCallbacks = 0;
+		juce::uint64 numDeadlineMisses = 0;
+		double blockMilliseconds = 0.0;
+		double meanMilliseconds = 0.0;
+		double maxMilliseconds = 0.0;
+		std::array<double, numDecks> deckMeanMilliseconds{};
+		std::array<double, numDecks> deckMaxMilliseconds{};
+		std::array<juce::uint32, numBins> histogram{};
+
+		/**
+		 * Returns the duration a share of the callbacks finished within,
+		 * from the histogram.
+		 *
+		 * @param percentile	The share of callbacks, from 0 to 100.
+		 * @return				The upper edge of the bin it falls in, in milliseconds.
+		 */
+		double getPercentileMilliseconds(double percentile) const;
+	};
+
+	/**
+	 * Constructor for the CallbackProfiler class.
+	 */
+	CallbackProfiler();
+
+	/**
+	 * Sets the sample rate the block period is worked out from, and clears
+	 * the statistics. Call before callbacks start.
+	 *
+	 * @param sampleRate	The audio sample rate.
+	 */
+	void prepare(double sampleRate);
+
+	/**
+	 * Starts timing a callback. Called on the audio thread.
+	 */
+	void beginCallback();
+
+	/**
+	 * Adds time a deck took to render, during the current callback.
+	 * Called on the audio thread.
+	 *
+	 * @param deckIndex		The deck, below numDecks.
+	 * @param ticks			The time taken in high resolution ticks.
+	 */
+	void addDeckTime(int deckIndex, juce::int64 ticks);
+
+	/**
+	 * Finishes timing a callback. Called on the audio thread.
+	 *
+	 * @param numSamples	The samples the callback rendered.
+	 */
+	void endCallback(int numSamples);
+
+	/**
+	 * Clears the statistics at the next callback.
+	 */
+	void reset();
+
+	/**
+	 * Reads the statistics.
+	 *
+	 * @return The statistics so far.
+	 */
+	Snapshot getSnapshot() const;
+
+	/**
+	 * Writes the statistics to a CSV file: the totals as name and value
+	 * rows, then a row for each histogram bin.
+	 *
+	 * @param file				The file to write, replaced if it exists.
+	 * @param deviceXRuns		Under and overruns reported by the audio device, or -1 if unknown.
+	 * @return					True if the file was written.
+	 */
+	bool exportCsv(const juce::File& file, int deviceXRuns = -1) const;
+
+private:
+	/**
+	 * Clears every counter. Called on the audio thread.
+	 */
+	void clear();
+
+	/**
+	 * Sample rate, and the high resolution ticks per microsecond.
+	 */
+	double sampleRate = 44100.0;
+	const double ticksPerMicrosecond;
+
+	/**
+	 * Start of the current callback and each deck's time in it, audio thread only.
+	 */
+	juce::int64 callbackStart = 0;
+	std::array<juce::int64, numDecks> callbackDeckTicks{};
+
+	/**
+	 * Counters written by the audio thread.
+	 */
+	std::array<std::atomic<juce::uint32>, numBins> histogram;
+	std::atomic<juce::uint64> numCallbacks{ 0 };
+	std::atomic<juce::uint64> numDeadlineMisses{ 0 };
+	std::atomic<juce::uint64> totalMicroseconds{ 0 };
+	std::atomic<juce::uint32> maxMicroseconds{ 0 };
+	std::array<std::atomic<juce::uint64>, numDecks> deckTotalMicroseconds;
+	std::array<std::atomic<juce::uint32>, numDecks> deckMaxMicroseconds;
+	std::atomic<float> blockMicroseconds{ 0.0f };
+
+	/**
+	 * Set by reset, cleared by the audio thread once it has cleared the counters.
+	 */
+	std::atomic<bool> resetPending{ false };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CallbackProfiler)
+};
@@ -0,0 +1,235 @@
+/*
+  ==============================================================================
+
+	ChannelStrip.cpp
+	Created: 21 Oct 2026 10:52:40am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ChannelStrip.h"
+
+//==============================================================================
+ChannelStrip::ChannelStrip(DJAudioPlayer* _player, const juce::String& _deckName)
+	: player(_player), deckName(_deckName)
+{
+	const char* bandNames[DeckEQ::numBands] = { "HI", "MID", "LOW" };
+
+	for (int row = 0; row < DeckEQ::numBands; ++row)
+	{
+		// EQ knob, double-click returns to unity
+		auto& knob = eqKnobs[row];
+		addAndMakeVisible(knob);
+		knob.addListener(this);
+		knob.setRange(0.0, 2.0);
+		knob.setValue(1.0);
+		knob.setSliderStyle(juce::Slider::Rotary);
+		knob.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
+		knob.setDoubleClickReturnValue(true, 1.0);
+		knob.setMouseCursor(juce::MouseCursor::DraggingHandCursor);
+		knob.setLookAndFeel(&customDesign);
+
+		// Kill switch named after its band
+		auto& kill = killButtons[row];
+		addAndMakeVisible(kill);
+		kill.addListener(this);
+		kill.setButtonText(bandNames[row]);
+		kill.setTooltip("Kill the " + juce::String(bandNames[row]).toLowerCase() + " band");
+		kill.setClickingTogglesState(true);
+		kill.setColour(juce::TextButton::buttonColourId, juce::Colours::transparentBlack);
+		kill.setColour(juce::TextButton::buttonOnColourId, juce::Colours::red.withAlpha(0.7f));
+		kill.setColour(juce::TextButton::textColourOffId, juce::Colours::cyan);
+		kill.setColour(juce::TextButton::textColourOnId, juce::Colours::white);
+		kill.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+	}
+
+	// Filter knob, off at centre and double-click returns there
+	addAndMakeVisible(filterKnob);
+	filterKnob.addListener(this);
+	filterKnob.setRange(-1.0, 1.0);
+	filterKnob.setValue(0.0);
+	filterKnob.setSliderStyle(juce::Slider::Rotary);
+	filterKnob.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
+	filterKnob.setDoubleClickReturnValue(true, 0.0);
+	filterKnob.setTooltip("Filter: lowpass to the left, highpass to the right");
+	filterKnob.setMouseCursor(juce::MouseCursor::DraggingHandCursor);
+	filterKnob.setLookAndFeel(&customDesign);
+
+	// Resonance knob for the filter
+	addAndMakeVisible(resonanceKnob);
+	resonanceKnob.addListener(this);
+	resonanceKnob.setRange(0.0, 1.0);
+	resonanceKnob.setValue(0.0);
+	resonanceKnob.setSliderStyle(juce::Slider::Rotary);
+	resonanceKnob.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
+	resonanceKnob.setDoubleClickReturnValue(true, 0.0);
+	resonanceKnob.setTooltip("Filter resonance");
+	resonanceKnob.setMouseCursor(juce::MouseCursor::DraggingHandCursor);
+	resonanceKnob.setLookAndFeel(&customDesign);
+
+	// Effect switches, lit while the effect is in
+	const char* effectNames[DeckEffects::numEffects] = { "ECHO", "VERB", "FLNG", "CRSH" };
+	const char* effectTips[DeckEffects::numEffects] = { "Echo", "Reverb", "Flanger", "Bitcrusher" };
+
+	for (int effect = 0; effect < DeckEffects::numEffects; ++effect)
+	{
+		auto& button = effectButtons[effect];
+		addAndMakeVisible(button);
+		button.addListener(this);
+		button.setButtonText(effectNames[effect]);
+		button.setTooltip(effectTips[effect]);
+		button.setClickingTogglesState(true);
+		button.setColour(juce::TextButton::buttonColourId, juce::Colours::transparentBlack);
+		button.setColour(juce::TextButton::buttonOnColourId, juce::Colours::darkcyan);
+		button.setColour(juce::TextButton::textColourOffId, juce::Colours::cyan);
+		button.setColour(juce::TextButton::textColourOnId, juce::Colours::white);
+		button.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+	}
+
+	// Effects mix knob, halfway by default
+	addAndMakeVisible(effectsMixKnob);
+	effectsMixKnob.addListener(this);
+	effectsMixKnob.setRange(0.0, 1.0);
+	effectsMixKnob.setValue(0.5);
+	effectsMixKnob.setSliderStyle(juce::Slider::Rotary);
+	effectsMixKnob.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
+	effectsMixKnob.setDoubleClickReturnValue(true, 0.5);
+	effectsMixKnob.setTooltip("Effects mix");
+	effectsMixKnob.setMouseCursor(juce::MouseCursor::DraggingHandCursor);
+	effectsMixKnob.setLookAndFeel(&customDesign);
+
+	// Headphone cue switch
+	addAndMakeVisible(cueButton);
+	cueButton.addListener(this);
+	cueButton.setButtonText("CUE");
+	cueButton.setTooltip("Hear the deck in the headphones");
+	cueButton.setClickingTogglesState(true);
+	cueButton.setColour(juce::TextButton::buttonColourId, juce::Colours::transparentBlack);
+	cueButton.setColour(juce::TextButton::buttonOnColourId, juce::Colours::orange.withAlpha(0.8f));
+	cueButton.setColour(juce::TextButton::textColourOffId, juce::Colours::cyan);
+	cueButton.setColour(juce::TextButton::textColourOnId, juce::Colours::white);
+	cueButton.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+}
+
+ChannelStrip::~ChannelStrip()
+{
+	for (auto& knob : eqKnobs)
+	{
+		knob.setLookAndFeel(nullptr);
+	}
+
+	filterKnob.setLookAndFeel(nullptr);
+	resonanceKnob.setLookAndFeel(nullptr);
+	effectsMixKnob.setLookAndFeel(nullptr);
+}
+
+void ChannelStrip::paint(juce::Graphics& g)
+{
+	g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId));
+
+	g.setColour(juce::Colours::darkcyan);
+	g.drawRect(getLocalBounds(), 1);
+
+	g.setColour(juce::Colours::cyan);
+	g.setFont(customDesign.getSelectedFont().withHeight(14.0f));
+	g.drawText(deckName, getWidth() / 20, 0, getWidth() * 6 / 10, getHeight() / 10, juce::Justification::centredLeft, false);
+}
+
+void ChannelStrip::resized()
+{
+	float rowH = getHeight() * 0.1f;
+	float margin = getWidth() * 0.05f;
+	float knobW = getWidth() * 0.6f;
+
+	// Cue switch on the right of the name
+	cueButton.setBounds(knobW, rowH * 0.15f, getWidth() - knobW - margin, rowH * 0.7f);
+
+	// One row per band under the name
+	for (int row = 0; row < DeckEQ::numBands; ++row)
+	{
+		float y = rowH * (1.0f + row * 1.5f);
+		eqKnobs[row].setBounds(margin, y, knobW - margin, rowH * 1.4f);
+		killButtons[row].setBounds(knobW, y + rowH * 0.35f, getWidth() - knobW - margin, rowH * 0.7f);
+	}
+
+	// Filter under the EQ, with its resonance beside it
+	float filterY = rowH * (1.0f + DeckEQ::numBands * 1.5f + 0.3f);
+	filterKnob.setBounds(margin, filterY, knobW - margin, rowH * 1.6f);
+	resonanceKnob.setBounds(knobW, filterY + rowH * 0.4f, getWidth() - knobW - margin, rowH * 0.8f);
+
+	// Effects at the bottom, switches in two pairs beside the mix knob
+	float effectsY = filterY + rowH * 1.7f;
+	float mixW = getWidth() * 0.35f;
+	float effectW = (getWidth() - mixW - margin * 2) * 0.5f;
+	float effectH = (getHeight() - effectsY - margin) * 0.5f;
+	effectsMixKnob.setBounds(margin, effectsY, mixW - margin, effectH * 2);
+
+	for (int effect = 0; effect < DeckEffects::numEffects; ++effect)
+	{
+		effectButtons[effect].setBounds(mixW + effectW * (effect % 2), effectsY + effectH * (effect / 2),
+			effectW - 1, effectH - 1);
+	}
+}
+
+void ChannelStrip::buttonClicked(juce::Button* button)
+{
+	if (button == &cueButton)
+	{
+		DBG("< CUE > button was clicked << " << (button->getToggleState() ? "Cued" : "Uncued") << " >>");
+
+		if (onCueChanged)
+		{
+			onCueChanged(button->getToggleState());
+		}
+		return;
+	}
+
+	for (int row = 0; row < DeckEQ::numBands; ++row)
+	{
+		if (button == &killButtons[row])
+		{
+			DBG("< " << button->getButtonText() << " KILL > button was clicked << "
+				<< (button->getToggleState() ? "Killed" : "Restored") << " >>");
+			player->setEQKill(rowBands[row], button->getToggleState());
+			return;
+		}
+	}
+
+	for (int effect = 0; effect < DeckEffects::numEffects; ++effect)
+	{
+		if (button == &effectButtons[effect])
+		{
+			DBG("< " << button->getButtonText() << " > button was clicked << "
+				<< (button->getToggleState() ? "On" : "Off") << " >>");
+			player->setEffectEnabled(static_cast<DeckEffects::Effect>(effect), button->getToggleState());
+			return;
+		}
+	}
+}
+
+void ChannelStrip::sliderValueChanged(juce::Slider* slider)
+{
+	for (int row = 0; row < DeckEQ::numBands; ++row)
+	{
+		if (slider == &eqKnobs[row])
+		{
+			player->setEQGain(rowBands[row], slider->getValue());
+			return;
+		}
+	}
+
+	if (slider == &filterKnob)
+	{
+		player->setFilter(slider->getValue());
+	}
+	else if (slider == &resonanceKnob)
+	{
+		player->setFilterResonance(slider->getValue());
+	}
+	else if (slider == &effectsMixKnob)
+	{
+		player->setEffectsMix(slider->getValue());
+	}
+}
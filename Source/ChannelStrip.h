@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+	ChannelStrip.h
+	Created: 21 Oct 2026 10:52:40am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DJAudioPlayer.h"
+#include "CustomDesign.h"
+
+//==============================================================================
+/**
+ * ChannelStrip class is the mixer channel of one deck, shown between the decks.
+ * It holds the deck's EQ knobs, each with a kill switch, its filter
+ * knob with a resonance knob, its effect switches with a mix knob, and
+ * its headphone cue switch.
+ */
+class ChannelStrip : public juce::Component,
+	public juce::Button::Listener,
+	public juce::Slider::Listener
+{
+public:
+	/**
+	 * Constructor for the ChannelStrip class.
+	 *
+	 * @param _player		Pointer to the deck's DJAudioPlayer.
+	 * @param _deckName		Name shown at the top of the strip.
+	 */
+	ChannelStrip(DJAudioPlayer* _player, const juce::String& _deckName);
+
+	/**
+	 * Destructor for the ChannelStrip class.
+	 */
+	~ChannelStrip() override;
+
+	/**
+	 * Paint method override to draw the strip's outline and name.
+	 *
+	 * @param g Graphics context to perform drawing operations.
+	 */
+	void paint(juce::Graphics& g) override;
+
+	/**
+	 * Resized method override to lay the controls out in rows.
+	 */
+	void resized() override;
+
+	/**
+	 * ButtonClicked method override to handle the kill and effect switches.
+	 *
+	 * @param button Pointer to the clicked button.
+	 */
+	void buttonClicked(juce::Button* button) override;
+
+	/**
+	 * Handles the EQ, filter and effect knobs.
+	 *
+	 * @param slider The slider whose value has changed.
+	 */
+	void sliderValueChanged(juce::Slider* slider) override;
+
+	/**
+	 * Called when the deck is sent to or taken off the headphone cue.
+	 */
+	std::function<void(bool)> onCueChanged;
+
+private:
+	/**
+	 * Pointer to the deck's audio player.
+	 */
+	DJAudioPlayer* player;
+
+	/**
+	 * Name shown at the top of the strip.
+	 */
+	juce::String deckName;
+
+	/**
+	 * EQ knobs and kill switches, from the high band down as on a mixer.
+	 */
+	juce::Slider eqKnobs[DeckEQ::numBands];
+	juce::TextButton killButtons[DeckEQ::numBands];
+
+	/**
+	 * Band of each row, top to bottom.
+	 */
+	static constexpr DeckEQ::Band rowBands[DeckEQ::numBands] = { DeckEQ::High, DeckEQ::Mid, DeckEQ::Low };
+
+	/**
+	 * Filter knob, lowpass to the left and highpass to the right, and its resonance.
+	 */
+	juce::Slider filterKnob;
+	juce::Slider resonanceKnob;
+
+	/**
+	 * Effect switches and the knob setting how much of the effects is heard.
+	 */
+	juce::TextButton effectButtons[DeckEffects::numEffects];
+	juce::Slider effectsMixKnob;
+
+	/**
+	 * Headphone cue switch, beside the name.
+	 */
+	juce::TextButton cueButton;
+
+	/**
+	 * Custom design for the knobs and buttons.
+	 */
+	CustomDesign customDesign;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChannelStrip)
+};
@@ -9,12 +9,13 @@
 */
 
 #include "DJAudioPlayer.h"
+#include "IntegratedLoudness.h"
 
 DJAudioPlayer::DJAudioPlayer(juce::AudioFormatManager& _formatManager)
 	: formatManager(_formatManager), 
 	sampleRate(44100.0)
 {
-
+	hotCues.fill(-1);
 }
 
 DJAudioPlayer::~DJAudioPlayer()
@@ -25,19 +26,32 @@ DJAudioPlayer::~DJAudioPlayer()
 void DJAudioPlayer::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
 {
 	this->sampleRate = sampleRate;
-	transportSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-	resampleSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
+	deckSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
+	eq.prepare(sampleRate);
+	filter.prepare(samplesPerBlockExpected, sampleRate);
+	effects.prepare(samplesPerBlockExpected, sampleRate);
 }
 
 void DJAudioPlayer::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
 {
-	resampleSource.getNextAudioBlock(bufferToFill);
+	deckSource.getNextAudioBlock(bufferToFill);
+
+	// Ramp the loudness trim so a late analysis does not click
+	const float newAutoGain = autoGain;
+	for (int channel = 0; channel < bufferToFill.buffer->getNumChannels(); ++channel)
+	{
+		bufferToFill.buffer->applyGainRamp(channel, bufferToFill.startSample, bufferToFill.numSamples, lastAutoGain, newAutoGain);
+	}
+	lastAutoGain = newAutoGain;
+
+	eq.process(bufferToFill);
+	filter.process(bufferToFill);
+	effects.process(bufferToFill);
 }
 
 void DJAudioPlayer::releaseResources()
 {
-	transportSource.releaseResources();
-	resampleSource.releaseResources();
+	deckSource.releaseResources();
 }
 
 void DJAudioPlayer::loadURL(juce::URL audioURL)
@@ -45,21 +59,42 @@ void DJAudioPlayer::loadURL(juce::URL audioURL)
 	// Create audio reader from the URL
 	auto* reader = formatManager.createReaderFor(audioURL.createInputStream(false));
 	
-	// Check if the reader is not null pointer which means successfully created
-	if (reader != nullptr)
+	// A file that cannot be read leaves the current track and its state as they were
+	if (reader == nullptr)
 	{
-		// Create new audio format reader source
-		std::unique_ptr<juce::AudioFormatReaderSource> newSource(new juce::AudioFormatReaderSource(reader, true));
-		
-		// Set the source for transport source and release the unique pointer
-		transportSource.setSource(newSource.get(), 0, nullptr, reader->sampleRate);
-		readerSource.reset(newSource.release());
+		DBG("DJAudioPlayer::loadURL cannot read " << audioURL.toString(false));
+		return;
 	}
 
+	// Decode the track in the background, the cache owns the reader
+	auto track = std::make_unique<TrackCache>(std::unique_ptr<juce::AudioFormatReader>(reader));
+	track->setWaitForChunks(waitForAudio);
+	deckSource.setTrack(std::move(track));
+
+	// Hot cues and loops belong to the previous track
+	hotCues.fill(-1);
+	loopIn = -1;
+	activeLoop = {};
+	loopRolling = false;
+
+	// Reverse stays on across audio tracks
+	censoring = false;
+	updateDirection();
+
+	// Tempo and loudness of the new track are unknown until set
+	bpm = 0.0;
+	effects.setTempo(0.0);
+	autoGain = 1.0f;
+
 	// Get the title to display the title name on top of the DeckGUI when track are loaded
 	audioTrackTitle = getTitle(audioURL);
 }
 
+void DJAudioPlayer::setWaitForAudio(bool shouldWait)
+{
+	waitForAudio = shouldWait;
+}
+
 // Sets audio player's gain (volume)
 void DJAudioPlayer::setGain(double gain)
 {
@@ -68,10 +103,15 @@ void DJAudioPlayer::setGain(double gain)
 		DBG("DJAudioPlayer::setGain gain should be between 0 and 1");
 	}
 	else {
-		transportSource.setGain(gain);
+		this->gain = static_cast<float>(gain);
 	}
 }
 
+float DJAudioPlayer::getGain() const
+{
+	return gain;
+}
+
 // Sets playback speed
 void DJAudioPlayer::setSpeed(double ratio)
 {
@@ -80,14 +120,16 @@ void DJAudioPlayer::setSpeed(double ratio)
 		DBG("DJAudioPlayer::setSpeed ratio should be between 0 and 3");
 	}
 	else {
-		resampleSource.setResamplingRatio(ratio);
+		deckSource.setSpeed(ratio);
+		speedRatio = ratio;
+		effects.setTempo(bpm * ratio);
 	}
 }
 
 // Sets playback position in sec
 void DJAudioPlayer::setPosition(double posInSecs)
 {
-	transportSource.setPosition(posInSecs);
+	deckSource.jumpTo(static_cast<juce::int64>(posInSecs * deckSource.getSourceSampleRate()));
 }
 
 // Sets playback position relative to total length
@@ -99,16 +141,305 @@ void DJAudioPlayer::setPositionRelative(double pos)
 	}
 	else 
 	{
-		// Calculate the position in sec relative to the total length 
-		double posInSecs = transportSource.getLengthInSeconds() * pos;
-		setPosition(posInSecs);
+		// Calculate the position in samples relative to the total length
+		deckSource.jumpTo(static_cast<juce::int64>(deckSource.getLengthInSamples() * pos));
 	}
 }
 
 // Return the playback position relative to the total length
 double DJAudioPlayer::getPositionRelative()
 {
-	return transportSource.getCurrentPosition() / transportSource.getLengthInSeconds();
+	const juce::int64 length = deckSource.getLengthInSamples();
+	return length > 0 ? static_cast<double>(deckSource.getPosition()) / length : 0.0;
+}
+
+void DJAudioPlayer::setBpm(double _bpm)
+{
+	bpm = juce::jmax(0.0, _bpm);
+	effects.setTempo(bpm * speedRatio);
+}
+
+void DJAudioPlayer::setTrackLoudness(float loudness)
+{
+	// Silent or unanalysed audio tracks are left alone
+	if (loudness <= IntegratedLoudness::silence)
+	{
+		autoGain = 1.0f;
+		return;
+	}
+
+	const float trimDb = juce::jlimit(-maxCutDb, maxBoostDb, targetLoudness - loudness);
+	autoGain = juce::Decibels::decibelsToGain(trimDb);
+}
+
+bool DJAudioPlayer::isPlaying() const
+{
+	return deckSource.isPlaying();
+}
+
+// Beat position and tempo of the track as heard at the output
+bool DJAudioPlayer::getBeatClock(double& beatPosition, double& beatsPerSample) const
+{
+	const double beatsPerSecond = bpm / 60.0;
+
+	if (beatsPerSecond <= 0.0 || !deckSource.isPlaying())
+	{
+		return false;
+	}
+
+	beatPosition = deckSource.getPosition() / deckSource.getSourceSampleRate() * beatsPerSecond;
+	beatsPerSample = beatsPerSecond * speedRatio / sampleRate;
+	return true;
+}
+
+double DJAudioPlayer::getLastSeekLatencyMs() const
+{
+	return deckSource.getLastSeekLatencyMs();
+}
+
+juce::uint32 DJAudioPlayer::getNumSeeksApplied() const
+{
+	return deckSource.getNumSeeksApplied();
+}
+
+juce::int64 DJAudioPlayer::getPositionInSamples() const
+{
+	return deckSource.getPosition();
+}
+
+void DJAudioPlayer::setHotCue(int cueIndex, juce::int64 position)
+{
+	if (!juce::isPositiveAndBelow(cueIndex, numHotCues))
+	{
+		DBG("DJAudioPlayer::setHotCue cueIndex should be between 0 and " << numHotCues - 1);
+		return;
+	}
+
+	hotCues[static_cast<size_t>(cueIndex)] = position < 0 ? -1 : position;
+
+	// Keep the audio just after the cue decoded, so jumping to it never plays silence
+	if (auto* track = deckSource.getTrack())
+	{
+		const juce::Range<juce::int64> region = position < 0
+			? juce::Range<juce::int64>()
+			: juce::Range<juce::int64>(position, position + 2 * TrackCache::chunkSize);
+
+		track->setPinnedRegion(cueIndex, region);
+	}
+}
+
+juce::int64 DJAudioPlayer::getHotCue(int cueIndex) const
+{
+	return juce::isPositiveAndBelow(cueIndex, numHotCues) ? hotCues[static_cast<size_t>(cueIndex)] : -1;
+}
+
+void DJAudioPlayer::jumpToHotCue(int cueIndex)
+{
+	const juce::int64 position = getHotCue(cueIndex);
+
+	if (position >= 0)
+	{
+		deckSource.jumpTo(position);
+	}
+}
+
+void DJAudioPlayer::setEQGain(DeckEQ::Band band, double gain)
+{
+	if (gain < 0 || gain > 2.0)
+	{
+		DBG("DJAudioPlayer::setEQGain gain should be between 0 and 2");
+	}
+	else
+	{
+		eq.setGain(band, static_cast<float>(gain));
+	}
+}
+
+void DJAudioPlayer::setEQKill(DeckEQ::Band band, bool kill)
+{
+	eq.setKill(band, kill);
+}
+
+void DJAudioPlayer::setFilter(double position)
+{
+	if (position < -1.0 || position > 1.0)
+	{
+		DBG("DJAudioPlayer::setFilter position should be between -1 and 1");
+	}
+	else
+	{
+		filter.setPosition(static_cast<float>(position));
+	}
+}
+
+void DJAudioPlayer::setFilterResonance(double resonance)
+{
+	if (resonance < 0 || resonance > 1.0)
+	{
+		DBG("DJAudioPlayer::setFilterResonance resonance should be between 0 and 1");
+	}
+	else
+	{
+		filter.setResonance(static_cast<float>(resonance));
+	}
+}
+
+void DJAudioPlayer::setEffectEnabled(DeckEffects::Effect effect, bool enabled)
+{
+	effects.setEnabled(effect, enabled);
+}
+
+void DJAudioPlayer::setEffectsMix(double mix)
+{
+	if (mix < 0 || mix > 1.0)
+	{
+		DBG("DJAudioPlayer::setEffectsMix mix should be between 0 and 1");
+	}
+	else
+	{
+		effects.setMix(static_cast<float>(mix));
+	}
+}
+
+void DJAudioPlayer::setReverse(bool shouldReverse)
+{
+	reverse = shouldReverse;
+	updateDirection();
+}
+
+void DJAudioPlayer::setCensor(bool shouldCensor)
+{
+	censoring = shouldCensor;
+	updateDirection();
+}
+
+void DJAudioPlayer::updateDirection()
+{
+	if (censoring)
+	{
+		deckSource.setDirection(DeckSource::Direction::Censor);
+	}
+	else
+	{
+		deckSource.setDirection(reverse ? DeckSource::Direction::Reverse : DeckSource::Direction::Forward);
+	}
+}
+
+void DJAudioPlayer::startScratch()
+{
+	deckSource.setScratchVelocity(0.0);
+	deckSource.setScratching(true);
+}
+
+void DJAudioPlayer::setScratchVelocity(double velocity)
+{
+	deckSource.setScratchVelocity(velocity);
+}
+
+void DJAudioPlayer::stopScratch()
+{
+	deckSource.setScratching(false);
+}
+
+void DJAudioPlayer::setLoopIn()
+{
+	loopIn = deckSource.getPosition();
+}
+
+void DJAudioPlayer::setLoopOut()
+{
+	const juce::int64 loopOut = deckSource.getPosition();
+
+	if (loopIn < 0 || loopOut <= loopIn)
+	{
+		DBG("DJAudioPlayer::setLoopOut loop out should be after loop in");
+		return;
+	}
+
+	setLoop({ loopIn, loopOut }, false);
+}
+
+bool DJAudioPlayer::setAutoLoop(double beats)
+{
+	const juce::Range<juce::int64> loop = getBeatLoop(beats);
+
+	if (loop.isEmpty())
+	{
+		DBG("DJAudioPlayer::setAutoLoop tempo of the audio track is unknown");
+		return false;
+	}
+
+	setLoop(loop, false);
+	return true;
+}
+
+bool DJAudioPlayer::startLoopRoll(double beats)
+{
+	const juce::Range<juce::int64> loop = getBeatLoop(beats);
+
+	if (loop.isEmpty())
+	{
+		DBG("DJAudioPlayer::startLoopRoll tempo of the audio track is unknown");
+		return false;
+	}
+
+	setLoop(loop, true);
+	return true;
+}
+
+void DJAudioPlayer::stopLoopRoll()
+{
+	if (loopRolling)
+	{
+		setLoop({}, false);
+	}
+}
+
+void DJAudioPlayer::exitLoop()
+{
+	setLoop({}, false);
+}
+
+bool DJAudioPlayer::isLoopActive() const
+{
+	return !activeLoop.isEmpty();
+}
+
+void DJAudioPlayer::setLoop(juce::Range<juce::int64> loop, bool roll)
+{
+	activeLoop = loop;
+	loopRolling = roll && !loop.isEmpty();
+	deckSource.setLoop(loop, roll);
+
+	// Keep the loop, and the audio faded out across its seam, in memory
+	if (auto* track = deckSource.getTrack())
+	{
+		const juce::Range<juce::int64> region = loop.isEmpty()
+			? juce::Range<juce::int64>()
+			: loop.withEnd(loop.getEnd() + 1024);
+
+		track->setPinnedRegion(numHotCues, region);
+	}
+}
+
+juce::Range<juce::int64> DJAudioPlayer::getBeatLoop(double beats) const
+{
+	const double sourceRate = deckSource.getSourceSampleRate();
+
+	if (bpm <= 0.0 || sourceRate <= 0.0)
+	{
+		return {};
+	}
+
+	// Beats are counted from the start of the audio track, loops shorter
+	// than a beat start on the nearest division at or before the playhead
+	const double beatLength = 60.0 / bpm * sourceRate;
+	const double loopLength = juce::jlimit(0.25, 32.0, beats) * beatLength;
+	const double grid = juce::jmin(loopLength, beatLength);
+	const double loopStart = std::floor(deckSource.getPosition() / grid) * grid;
+
+	return { static_cast<juce::int64>(std::llround(loopStart)),
+		static_cast<juce::int64>(std::llround(loopStart + loopLength)) };
 }
 
 juce::String DJAudioPlayer::getTitle(const juce::URL& audioURL)
@@ -119,34 +450,33 @@ juce::String DJAudioPlayer::getTitle(const juce::URL& audioURL)
 // Play the track
 void DJAudioPlayer::start()
 {
-	transportSource.start();
+	deckSource.start();
 }
 
 // Pause the track
 void DJAudioPlayer::pause()
 {
-	transportSource.stop();
+	deckSource.stop();
 }
 
 // Stop the track
 void DJAudioPlayer::stop()
 {
-	transportSource.setPosition(0);
-	transportSource.stop();
+	deckSource.stop();
+	deckSource.jumpTo(0);
 }
 
 // Fast forward 10 sec
 void DJAudioPlayer::fastForward()
 {
-	auto position = transportSource.getNextReadPosition();
-	
-	// Calculate new position and fast forward by 10 sec
-	auto newPosition = position + (sampleRate * 10.0);
+	// 10 sec in samples of the audio file, whatever the device sample rate
+	auto offset = static_cast<juce::int64>(deckSource.getSourceSampleRate() * 10.0);
 
 	// Check if the pos is within the length of audio
-	if (newPosition <= transportSource.getTotalLength())
+	if (deckSource.getPosition() + offset <= deckSource.getLengthInSamples())
 	{
-		transportSource.setNextReadPosition(newPosition);
+		// Offset from where the audio thread actually is when it applies the seek
+		deckSource.seekBy(offset);
 	}
 	else
 	{
@@ -158,15 +488,13 @@ void DJAudioPlayer::fastForward()
 // Rewind backward 10 sec
 void DJAudioPlayer::rewind()
 {
-	auto position = transportSource.getNextReadPosition();
-
-	// Calculate new position and rewind backward by 10 sec
-	auto newPosition = position - (sampleRate * 10.0);
+	// 10 sec in samples of the audio file, whatever the device sample rate
+	auto offset = static_cast<juce::int64>(deckSource.getSourceSampleRate() * 10.0);
 
 	// Ensure the position is not before the start of the audio
-	if (newPosition >= 0)
+	if (deckSource.getPosition() - offset >= 0)
 	{
-		transportSource.setNextReadPosition(newPosition);
+		deckSource.seekBy(-offset);
 	}
 	else
 	{
@@ -178,7 +506,7 @@ void DJAudioPlayer::rewind()
 // Replay audio track
 void DJAudioPlayer::replay(bool replayEnable)
 {
-	if (readerSource != nullptr)
+	if (deckSource.getTrack() != nullptr)
 	{
 		if (replayEnable)
 		{
@@ -190,7 +518,7 @@ void DJAudioPlayer::replay(bool replayEnable)
 		}
 
 		// Set replay looping based on the replayEnable status
-		readerSource->setLooping(replayEnable);
+		deckSource.setLooping(replayEnable);
 	}
 	else
 	{
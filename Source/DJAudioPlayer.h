@@ -10,6 +10,12 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include "DeckSource.h"
+#include "DeckEQ.h"
+#include "DeckFilter.h"
+#include "DeckEffects.h"
 
 /**
  * The DJAudioPlayer class represents an audio player which 
@@ -19,6 +25,15 @@
 class DJAudioPlayer : public juce::AudioSource
 {
 public:
+	/**
+	 * Number of hot cues per audio track.
+	 */
+	static constexpr int numHotCues = 8;
+
+	/**
+	 * Hot cue positions in samples of the audio file, -1 if not set.
+	 */
+	using HotCues = std::array<juce::int64, numHotCues>;
 
 	DJAudioPlayer(juce::AudioFormatManager& _formatManager);
 	~DJAudioPlayer();
@@ -48,19 +63,37 @@ public:
 	void releaseResources() override;
 
 	/** 
-	 * Loads audio from the given URL.
+	 * Loads audio from the given URL. If it cannot be read, the deck keeps
+	 * its current track, hot cues and loops.
 	 * 
 	 * @param audioURL The audio's URL to load.
 	 */
 	void loadURL(juce::URL audioURL);
 
+	/**
+	 * Makes the deck wait for audio that is still being decoded instead of
+	 * playing silence, for audio tracks loaded afterwards. Only for offline
+	 * rendering, never when playing to an audio device.
+	 *
+	 * @param shouldWait	True to wait for the audio.
+	 */
+	void setWaitForAudio(bool shouldWait);
+
 	/** 
 	 * Sets the gain of the audio player.
+	 * It is applied by the mixer, so the deck can be cued before its fader.
 	 * 
 	 * @param gain The gain value to set.
 	 */
 	void setGain(double gain);
 
+	/**
+	 * Returns the gain of the audio player, for the mixer.
+	 *
+	 * @return The gain between 0 and 1.
+	 */
+	float getGain() const;
+
 	/** 
 	 * Sets the playback 
 	 
@@ -123,6 +156,207 @@ public:
 	 */
 	void replay(bool replayEnable);
 
+	/**
+	 * Sets the tempo of the loaded audio track, or 0 if unknown.
+	 * Loading a new audio track resets it to 0.
+	 *
+	 * @param bpm The audio track's beats per minute.
+	 */
+	void setBpm(double bpm);
+
+	/**
+	 * Sets the analysed loudness of the loaded audio track. The deck is
+	 * trimmed so every track plays at about the same loudness before the EQ.
+	 * Loading a new audio track resets the trim until this is called again.
+	 *
+	 * @param loudness	The integrated loudness in LUFS, or -infinity if unknown.
+	 */
+	void setTrackLoudness(float loudness);
+
+	/**
+	 * Returns true if the audio track is playing.
+	 *
+	 * @return True if playing.
+	 */
+	bool isPlaying() const;
+
+	/**
+	 * Reads the beat position of the next sample to be played.
+	 * Beats are counted from the start of the audio track.
+	 *
+	 * @param beatPosition		Set to the beat position of the next output sample.
+	 * @param beatsPerSample	Set to the beats advanced per output sample at the current speed.
+	 * @return					False if the audio track's tempo is unknown or it is not playing.
+	 */
+	bool getBeatClock(double& beatPosition, double& beatsPerSample) const;
+
+	/**
+	 * Returns how long the last seek, jump or hot cue waited for the audio thread.
+	 *
+	 * @return The seek latency in milliseconds.
+	 */
+	double getLastSeekLatencyMs() const;
+
+	/**
+	 * Returns how many times seeks have been applied by the audio thread,
+	 * which changes once the latency of a new seek has been measured.
+	 *
+	 * @return The count of applied seeks.
+	 */
+	juce::uint32 getNumSeeksApplied() const;
+
+	/**
+	 * Returns the playback position.
+	 *
+	 * @return The position in samples of the audio file.
+	 */
+	juce::int64 getPositionInSamples() const;
+
+	/**
+	 * Sets or clears a hot cue of the loaded audio track.
+	 * The audio around a hot cue is kept decoded so jumping to it is instant.
+	 *
+	 * @param cueIndex		The hot cue, below numHotCues.
+	 * @param position		The cue position in samples of the audio file, or -1 to clear it.
+	 */
+	void setHotCue(int cueIndex, juce::int64 position);
+
+	/**
+	 * Returns a hot cue of the loaded audio track.
+	 *
+	 * @param cueIndex		The hot cue, below numHotCues.
+	 * @return				The cue position in samples of the audio file, or -1 if not set.
+	 */
+	juce::int64 getHotCue(int cueIndex) const;
+
+	/**
+	 * Jumps to a hot cue at the start of the next audio block.
+	 *
+	 * @param cueIndex		The hot cue, below numHotCues.
+	 */
+	void jumpToHotCue(int cueIndex);
+
+	/**
+	 * Sets the gain of one band of the deck's EQ.
+	 *
+	 * @param band		The EQ band.
+	 * @param gain		Linear gain between 0 and 2, 1 leaves the band unchanged.
+	 */
+	void setEQGain(DeckEQ::Band band, double gain);
+
+	/**
+	 * Kills or restores one band of the deck's EQ.
+	 *
+	 * @param band		The EQ band.
+	 * @param kill		True to silence the band.
+	 */
+	void setEQKill(DeckEQ::Band band, bool kill);
+
+	/**
+	 * Sets the deck's filter knob.
+	 *
+	 * @param position		-1 for the lowest lowpass, 0 for no filter, 1 for the highest highpass.
+	 */
+	void setFilter(double position);
+
+	/**
+	 * Sets the resonance of the deck's filter.
+	 *
+	 * @param resonance		0 for none to 1 for the most.
+	 */
+	void setFilterResonance(double resonance);
+
+	/**
+	 * Switches one of the deck's effects in or out.
+	 *
+	 * @param effect		The effect.
+	 * @param enabled		True to switch the effect in.
+	 */
+	void setEffectEnabled(DeckEffects::Effect effect, bool enabled);
+
+	/**
+	 * Sets how much of the deck's effects is heard.
+	 *
+	 * @param mix		0 for none to 1 for fully wet.
+	 */
+	void setEffectsMix(double mix);
+
+	/**
+	 * Plays the audio track backwards or forwards.
+	 *
+	 * @param shouldReverse		True to play backwards.
+	 */
+	void setReverse(bool shouldReverse);
+
+	/**
+	 * Plays backwards while held, like reverse, but resumes from where
+	 * forward playback would have been when released.
+	 *
+	 * @param shouldCensor		True while the censor is held.
+	 */
+	void setCensor(bool shouldCensor);
+
+	/**
+	 * Starts scratching, the deck follows the scratch velocity until stopScratch.
+	 */
+	void startScratch();
+
+	/**
+	 * Sets how fast the jog wheel is moving the audio track.
+	 *
+	 * @param velocity	Speed relative to normal playback, negative to play backwards.
+	 */
+	void setScratchVelocity(double velocity);
+
+	/**
+	 * Stops scratching, the deck carries on playing or stays paused as before.
+	 */
+	void stopScratch();
+
+	/**
+	 * Marks the playback position as the start of the next loop.
+	 */
+	void setLoopIn();
+
+	/**
+	 * Loops from the loop in point to the playback position.
+	 */
+	void setLoopOut();
+
+	/**
+	 * Loops a number of beats, starting on the beat at or before the playback position.
+	 *
+	 * @param beats		The loop length in beats, 1/4 to 32.
+	 * @return			False if the audio track's tempo is unknown.
+	 */
+	bool setAutoLoop(double beats);
+
+	/**
+	 * Starts a loop roll of a number of beats. Playback carries on underneath
+	 * and resumes from there when the roll stops.
+	 *
+	 * @param beats		The loop length in beats, 1/4 to 32.
+	 * @return			False if the audio track's tempo is unknown.
+	 */
+	bool startLoopRoll(double beats);
+
+	/**
+	 * Stops the loop roll, returning to where playback would have been.
+	 */
+	void stopLoopRoll();
+
+	/**
+	 * Leaves the loop, playing on from the playback position.
+	 */
+	void exitLoop();
+
+	/**
+	 * Returns true if a loop is set.
+	 *
+	 * @return True if looping.
+	 */
+	bool isLoopActive() const;
+
 	/**
 	 * Retrieves the audio track's title from the given URL.
 	 *
@@ -137,28 +371,103 @@ public:
 	juce::String audioTrackTitle;
 
 private:
+	/**
+	 * Plays a loop and keeps it in memory.
+	 *
+	 * @param loop		Source sample range to repeat, or an empty range to leave the loop.
+	 * @param roll		True for a loop roll.
+	 */
+	void setLoop(juce::Range<juce::int64> loop, bool roll);
+
+	/**
+	 * Passes the reverse and censor state on to the deck.
+	 */
+	void updateDirection();
+
+	/**
+	 * Works out a loop of a number of beats on the audio track's beat grid.
+	 *
+	 * @param beats		The loop length in beats.
+	 * @return			The loop in source samples, or an empty range if the tempo is unknown.
+	 */
+	juce::Range<juce::int64> getBeatLoop(double beats) const;
+
 	/**
 	 * The AudioFormatManager used for audio file handling.
 	 */
 	juce::AudioFormatManager& formatManager;
 
 	/**
-	 * The source to read audio format.
+	 * Whether audio tracks are loaded to wait for their audio.
 	 */
-	std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
-	
+	bool waitForAudio = false;
+
 	/**
-	 * The transport source for audio playback.
+	 * Plays the audio track from its decoded cache.
 	 */
-	juce::AudioTransportSource transportSource;
+	DeckSource deckSource;
 
 	/**
-	 * The resampling audio source for the sample rate conversion.
+	 * Tone control applied after playback.
 	 */
-	juce::ResamplingAudioSource resampleSource{ &transportSource, false, 2 };
-	
+	DeckEQ eq;
+
+	/**
+	 * Filter sweep applied after the EQ.
+	 */
+	DeckFilter filter;
+
+	/**
+	 * Effect rack applied last.
+	 */
+	DeckEffects effects;
+
+	/**
+	 * Fader gain, applied by the mixer.
+	 */
+	std::atomic<float> gain{ 1.0f };
+
+	/**
+	 * Loudness trim of the audio track, and the trim applied at the end of the last block.
+	 */
+	std::atomic<float> autoGain{ 1.0f };
+	float lastAutoGain = 1.0f;
+
+	/**
+	 * Loudness every audio track is trimmed to, and the most it may be cut or
+	 * boosted. Quiet tracks are only boosted a little, so their peaks keep
+	 * their headroom instead of hitting the master limiter.
+	 */
+	static constexpr float targetLoudness = -14.0f;
+	static constexpr float maxCutDb = 12.0f;
+	static constexpr float maxBoostDb = 4.0f;
+
+	/**
+	 * Hot cues of the loaded audio track in samples, -1 if not set.
+	 */
+	HotCues hotCues;
+
+	/**
+	 * Loop in point in samples, -1 if not set, and the loop being played.
+	 */
+	juce::int64 loopIn = -1;
+	juce::Range<juce::int64> activeLoop;
+	bool loopRolling = false;
+
+	/**
+	 * Reverse and censor state.
+	 */
+	bool reverse = false;
+	bool censoring = false;
+
 	/**
 	 * The audio sample rate.
 	 */
 	double sampleRate;
+
+	/**
+	 * Tempo and playback speed, read by the audio thread for the beat clock.
+	 */
+	std::atomic<double> bpm{ 0.0 };
+	std::atomic<double> speedRatio{ 1.0 };
 };
\ No newline at end of file
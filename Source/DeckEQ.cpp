@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+	DeckEQ.cpp
+	Created: 21 Oct 2026 9:34:17am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "DeckEQ.h"
+
+DeckEQ::DeckEQ()
+{
+	for (int band = 0; band < numBands; ++band)
+	{
+		gains[band] = 1.0f;
+		kills[band] = false;
+		smoothedGains[band].setCurrentAndTargetValue(1.0f);
+	}
+}
+
+DeckEQ::~DeckEQ()
+{
+
+}
+
+void DeckEQ::Crossover::prepare(double frequency, double sampleRate)
+{
+	// Butterworth TPT state variable filter, two in series make a Linkwitz-Riley crossover
+	const double g = std::tan(juce::MathConstants<double>::pi * juce::jmin(frequency, sampleRate * 0.45) / sampleRate);
+	const double k = juce::MathConstants<double>::sqrt2;
+	const double coefficient1 = 1.0 / (1.0 + g * (g + k));
+
+	a1 = static_cast<float>(coefficient1);
+	a2 = static_cast<float>(g * coefficient1);
+	a3 = static_cast<float>(g * g * coefficient1);
+
+	reset();
+}
+
+void DeckEQ::Crossover::reset()
+{
+	splitIc1.fill(0.0f);
+	splitIc2.fill(0.0f);
+	ic1.fill(0.0f);
+	ic2.fill(0.0f);
+}
+
+template <size_t numLanes>
+void DeckEQ::tptStep(const Crossover& crossover, std::array<float, numLanes>& ic1, std::array<float, numLanes>& ic2,
+	const float* input, float* lowpass, float* highpass)
+{
+	const float k = juce::MathConstants<float>::sqrt2;
+
+	for (size_t lane = 0; lane < numLanes; ++lane)
+	{
+		const float v3 = input[lane] - ic2[lane];
+		const float v1 = crossover.a1 * ic1[lane] + crossover.a2 * v3;
+		const float v2 = ic2[lane] + crossover.a2 * ic1[lane] + crossover.a3 * v3;
+		ic1[lane] = 2.0f * v1 - ic1[lane];
+		ic2[lane] = 2.0f * v2 - ic2[lane];
+
+		lowpass[lane] = v2;
+		highpass[lane] = input[lane] - k * v1 - v2;
+	}
+}
+
+void DeckEQ::prepare(double sampleRate)
+{
+	lowSplit.prepare(lowCrossover, sampleRate);
+	highSplit.prepare(highCrossover, sampleRate);
+
+	// Gains glide over 20ms
+	for (auto& gain : smoothedGains)
+	{
+		gain.reset(sampleRate, 0.02);
+	}
+}
+
+void DeckEQ::setGain(Band band, float gain)
+{
+	gains[band] = juce::jlimit(0.0f, 2.0f, gain);
+}
+
+void DeckEQ::setKill(Band band, bool kill)
+{
+	kills[band] = kill;
+}
+
+void DeckEQ::process(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+	// Filter tails must not decay into denormals
+	juce::ScopedNoDenormals noDenormals;
+
+	for (int band = 0; band < numBands; ++band)
+	{
+		smoothedGains[band].setTargetValue(kills[band] ? 0.0f : gains[band].load());
+	}
+
+	auto& buffer = *bufferToFill.buffer;
+	const int numChannels = juce::jmin(2, buffer.getNumChannels());
+
+	if (numChannels == 0)
+	{
+		return;
+	}
+
+	// A mono buffer runs the second channel's lanes on a copy of the first
+	float* channels[2];
+	for (int channel = 0; channel < 2; ++channel)
+	{
+		channels[channel] = buffer.getWritePointer(juce::jmin(channel, numChannels - 1), bufferToFill.startSample);
+	}
+
+	// Four lane arrays hold the lowpass of each channel, then the highpass of each channel
+	alignas(16) float input[2], split[4], lowpass[4], highpass[4], mid[4];
+
+	for (int i = 0; i < bufferToFill.numSamples; ++i)
+	{
+		const float lowGain = smoothedGains[Low].getNextValue();
+		const float midGain = smoothedGains[Mid].getNextValue();
+		const float highGain = smoothedGains[High].getNextValue();
+
+		input[0] = channels[0][i];
+		input[1] = channels[1][i];
+
+		// Split off the low band, lowpass lanes 0-1 are the low band, highpass lanes 2-3 the rest
+		tptStep(lowSplit, lowSplit.splitIc1, lowSplit.splitIc2, input, split, split + 2);
+		tptStep(lowSplit, lowSplit.ic1, lowSplit.ic2, split, lowpass, highpass);
+
+		// Split the rest, lowpass lanes 0-1 are the mid band, highpass lanes 2-3 the high band
+		tptStep(highSplit, highSplit.splitIc1, highSplit.splitIc2, highpass + 2, split, split + 2);
+		tptStep(highSplit, highSplit.ic1, highSplit.ic2, split, mid, highpass);
+
+		const float* low = lowpass;
+		const float* high = highpass + 2;
+
+		for (int channel = 0; channel < numChannels; ++channel)
+		{
+			channels[channel][i] = lowGain * low[channel] + midGain * mid[channel] + highGain * high[channel];
+		}
+	}
+}
@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+	DeckEQ.h
+	Created: 21 Oct 2026 9:34:17am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+/**
+ * DeckEQ class is a 3-band isolator EQ with kill switches for one deck.
+ *
+ * The input is split into bands by two Linkwitz-Riley crossovers, each a
+ * pair of second order TPT state variable filters in series, so a killed
+ * band drops away at 24dB per octave and the bands add back up flat at
+ * unity. Filters at the same stage of both channels run as lanes of one
+ * loop without branches, which the compiler can vectorise.
+ *
+ * Band gains glide to their new values. Nothing is allocated after prepare.
+ */
+class DeckEQ
+{
+public:
+	/**
+	 * The bands of the EQ.
+	 */
+	enum Band { Low, Mid, High, numBands };
+
+	/**
+	 * Constructor for the DeckEQ class.
+	 */
+	DeckEQ();
+
+	/**
+	 * Destructor for the DeckEQ class.
+	 */
+	~DeckEQ();
+
+	/**
+	 * Works out the filter coefficients for the sample rate and clears the filters.
+	 *
+	 * @param sampleRate	The audio sample rate.
+	 */
+	void prepare(double sampleRate);
+
+	/**
+	 * Applies the EQ to a block of audio in place. Called on the audio thread.
+	 *
+	 * @param bufferToFill	The block to process, only the first two channels are used.
+	 */
+	void process(const juce::AudioSourceChannelInfo& bufferToFill);
+
+	/**
+	 * Sets the gain of a band.
+	 *
+	 * @param band		The band to set.
+	 * @param gain		Linear gain between 0 and 2, 1 leaves the band unchanged.
+	 */
+	void setGain(Band band, float gain);
+
+	/**
+	 * Silences or restores a band, keeping its gain for when the kill is released.
+	 *
+	 * @param band		The band to kill.
+	 * @param kill		True to silence the band.
+	 */
+	void setKill(Band band, bool kill);
+
+private:
+	/**
+	 * One crossover: shared coefficients and the state of each of its filters.
+	 * The first filter of each channel splits the signal, the second filters
+	 * again the lowpass and the highpass of both channels.
+	 */
+	struct Crossover
+	{
+		float a1 = 0.0f, a2 = 0.0f, a3 = 0.0f;
+		alignas(16) std::array<float, 2> splitIc1{}, splitIc2{};
+		alignas(16) std::array<float, 4> ic1{}, ic2{};
+
+		void prepare(double frequency, double sampleRate);
+		void reset();
+	};
+
+	/**
+	 * Runs one step of several filters with the same coefficients.
+	 *
+	 * @param input		Input of each filter.
+	 * @param lowpass	Set to the lowpass output of each filter.
+	 * @param highpass	Set to the highpass output of each filter.
+	 */
+	template <size_t numLanes>
+	static void tptStep(const Crossover& crossover, std::array<float, numLanes>& ic1, std::array<float, numLanes>& ic2,
+		const float* input, float* lowpass, float* highpass);
+
+	/**
+	 * Crossover frequencies between the bands, in Hz.
+	 */
+	static constexpr double lowCrossover = 250.0;
+	static constexpr double highCrossover = 2500.0;
+
+	Crossover lowSplit, highSplit;
+
+	/**
+	 * Band gains set by the message thread, and the gains being glided.
+	 */
+	std::array<std::atomic<float>, numBands> gains;
+	std::array<std::atomic<bool>, numBands> kills;
+	std::array<juce::SmoothedValue<float>, numBands> smoothedGains;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckEQ)
+};
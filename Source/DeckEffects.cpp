@@ -0,0 +1,350 @@
+/*
+  ==============================================================================
+
+	DeckEffects.cpp
+	Created: 21 Oct 2026 4:05:12pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "DeckEffects.h"
+
+DeckEffects::DeckEffects()
+{
+	for (auto& effectEnabled : enabled)
+	{
+		effectEnabled = false;
+	}
+}
+
+DeckEffects::~DeckEffects()
+{
+
+}
+
+void DeckEffects::prepare(int samplesPerBlockExpected, double _sampleRate)
+{
+	sampleRate = _sampleRate;
+
+	// Long enough for the echo at the slowest tempo, and the flanger's deepest sweep
+	echoLine.prepare(static_cast<int>(std::ceil(60.0 / slowestTempo * echoBeats * sampleRate)) + 1);
+	flangerLine.prepare(static_cast<int>(std::ceil(sampleRate * 0.01)) + 1);
+
+	reverb.setSampleRate(sampleRate);
+	juce::Reverb::Parameters parameters;
+	parameters.roomSize = 0.75f;
+	parameters.damping = 0.4f;
+	parameters.wetLevel = 0.25f;
+	parameters.dryLevel = 0.0f;
+	parameters.width = 1.0f;
+	reverb.setParameters(parameters);
+	reverbBuffer.setSize(2, juce::jmax(1, samplesPerBlockExpected));
+
+	// Echo delay glides over 50ms, its repeats lose their top above 3kHz
+	echoDelaySmoothing = static_cast<float>(1.0 - std::exp(-1.0 / (sampleRate * 0.05)));
+	echoDampingCoefficient = static_cast<float>(1.0 - std::exp(-juce::MathConstants<double>::twoPi * 3000.0 / sampleRate));
+
+	// Effects glide in and out over 50ms
+	for (int effect = 0; effect < numEffects; ++effect)
+	{
+		amounts[effect].reset(sampleRate, 0.05);
+		amounts[effect].setCurrentAndTargetValue(0.0f);
+		running[effect] = false;
+		resetEffect(static_cast<Effect>(effect));
+	}
+}
+
+void DeckEffects::setEnabled(Effect effect, bool shouldEnable)
+{
+	enabled[effect] = shouldEnable;
+}
+
+void DeckEffects::setMix(float newMix)
+{
+	mix = juce::jlimit(0.0f, 1.0f, newMix);
+}
+
+void DeckEffects::setTempo(double bpm)
+{
+	tempo = juce::jmax(0.0, bpm);
+}
+
+void DeckEffects::resetEffect(Effect effect)
+{
+	switch (effect)
+	{
+	case Echo:
+		echoLine.clear();
+		echoDamping.fill(0.0f);
+		echoDelay = 0.0f;
+		break;
+	case Reverb:
+		reverb.reset();
+		break;
+	case Flanger:
+		flangerLine.clear();
+		flangerPhase = 0.0;
+		break;
+	case Bitcrush:
+		crushHoldRemaining = 0;
+		break;
+	default:
+		break;
+	}
+}
+
+void DeckEffects::process(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+	const float newMix = mix;
+	bool anyRunning = false;
+
+	for (int effect = 0; effect < numEffects; ++effect)
+	{
+		const float target = enabled[effect] ? newMix : 0.0f;
+
+		// Start from clean state when switched in
+		if (!running[effect] && target > 0.0f)
+		{
+			resetEffect(static_cast<Effect>(effect));
+			running[effect] = true;
+		}
+
+		amounts[effect].setTargetValue(target);
+		anyRunning = anyRunning || running[effect];
+	}
+
+	if (!anyRunning)
+	{
+		return;
+	}
+
+	juce::ScopedNoDenormals noDenormals;
+
+	auto& buffer = *bufferToFill.buffer;
+	const int numChannels = juce::jmin(2, buffer.getNumChannels());
+	float* channels[2] = { nullptr, nullptr };
+
+	for (int channel = 0; channel < numChannels; ++channel)
+	{
+		channels[channel] = buffer.getWritePointer(channel, bufferToFill.startSample);
+	}
+
+	const double bpm = tempo > 0.0 ? tempo.load() : defaultTempo;
+	const double beatSamples = 60.0 / bpm * sampleRate;
+
+	if (running[Bitcrush])
+	{
+		processBitcrush(channels, numChannels, bufferToFill.numSamples);
+	}
+
+	if (running[Flanger])
+	{
+		processFlanger(channels, numChannels, bufferToFill.numSamples, beatSamples);
+	}
+
+	if (running[Echo])
+	{
+		processEcho(channels, numChannels, bufferToFill.numSamples, beatSamples);
+	}
+
+	if (running[Reverb])
+	{
+		processReverb(channels, numChannels, bufferToFill.numSamples);
+	}
+}
+
+void DeckEffects::processBitcrush(float* const* channels, int numChannels, int numSamples)
+{
+	auto& amount = amounts[Bitcrush];
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		// Sample and hold at a lower rate, quantised to fewer levels
+		if (crushHoldRemaining == 0)
+		{
+			for (int channel = 0; channel < numChannels; ++channel)
+			{
+				crushHeld[channel] = std::round(channels[channel][i] * crushLevels) / crushLevels;
+			}
+
+			crushHoldRemaining = crushHold;
+		}
+
+		--crushHoldRemaining;
+		const float wet = amount.getNextValue();
+
+		for (int channel = 0; channel < numChannels; ++channel)
+		{
+			const float dry = channels[channel][i];
+			channels[channel][i] = dry + wet * (crushHeld[channel] - dry);
+		}
+	}
+
+	running[Bitcrush] = amount.isSmoothing() || amount.getTargetValue() > 0.0f;
+}
+
+void DeckEffects::processFlanger(float* const* channels, int numChannels, int numSamples, double beatSamples)
+{
+	auto& amount = amounts[Flanger];
+
+	// Sweeps between 1ms and 5ms, the right channel a quarter cycle behind the left
+	const double phaseIncrement = 1.0 / (beatSamples * flangerBeats);
+	const float minDelay = static_cast<float>(sampleRate * 0.001);
+	const float sweepDepth = static_cast<float>(sampleRate * 0.004);
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const float wet = amount.getNextValue();
+
+		for (int channel = 0; channel < numChannels; ++channel)
+		{
+			const double phase = flangerPhase - 0.25 * channel;
+			const float sweep = 0.5f - 0.5f * static_cast<float>(std::cos(juce::MathConstants<double>::twoPi * phase));
+
+			const float dry = channels[channel][i];
+			const float delayed = flangerLine.read(channel, minDelay + sweepDepth * sweep);
+			flangerLine.write(channel, dry + flangerFeedback * delayed);
+
+			channels[channel][i] = dry + wet * (0.5f * (dry + delayed) - dry);
+		}
+
+		flangerLine.advance();
+
+		flangerPhase += phaseIncrement;
+		if (flangerPhase >= 1.0)
+		{
+			flangerPhase -= 1.0;
+		}
+	}
+
+	running[Flanger] = amount.isSmoothing() || amount.getTargetValue() > 0.0f;
+}
+
+void DeckEffects::processEcho(float* const* channels, int numChannels, int numSamples, double beatSamples)
+{
+	auto& amount = amounts[Echo];
+	const float targetDelay = static_cast<float>(juce::jlimit(1.0, static_cast<double>(echoLine.buffer.getNumSamples() - 2),
+		beatSamples * echoBeats));
+
+	// Switched in at the current tempo, then glides to tempo changes
+	if (echoDelay <= 0.0f)
+	{
+		echoDelay = targetDelay;
+	}
+
+	float peak = 0.0f;
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		// The amount feeds the echo, so repeats carry on after it is switched off
+		const float send = amount.getNextValue();
+		echoDelay += (targetDelay - echoDelay) * echoDelaySmoothing;
+
+		for (int channel = 0; channel < numChannels; ++channel)
+		{
+			const float dry = channels[channel][i];
+			const float delayed = echoLine.read(channel, echoDelay);
+
+			echoDamping[channel] += (delayed - echoDamping[channel]) * echoDampingCoefficient;
+			echoLine.write(channel, dry * send + echoFeedback * echoDamping[channel]);
+
+			channels[channel][i] = dry + delayed;
+			peak = juce::jmax(peak, std::abs(delayed));
+		}
+
+		echoLine.advance();
+	}
+
+	running[Echo] = amount.isSmoothing() || amount.getTargetValue() > 0.0f || peak > tailThreshold;
+}
+
+void DeckEffects::processReverb(float* const* channels, int numChannels, int numSamples)
+{
+	auto& amount = amounts[Reverb];
+	const int maxBlockSize = reverbBuffer.getNumSamples();
+	float* reverbChannels[2] = { reverbBuffer.getWritePointer(0), reverbBuffer.getWritePointer(1) };
+	float peak = 0.0f;
+
+	// In pieces if the block is longer than expected
+	for (int start = 0; start < numSamples; start += maxBlockSize)
+	{
+		const int blockSize = juce::jmin(maxBlockSize, numSamples - start);
+
+		// The amount feeds the reverb, so its tail carries on after it is switched off
+		for (int i = 0; i < blockSize; ++i)
+		{
+			const float send = amount.getNextValue();
+
+			for (int channel = 0; channel < numChannels; ++channel)
+			{
+				reverbChannels[channel][i] = channels[channel][start + i] * send;
+			}
+		}
+
+		if (numChannels == 2)
+		{
+			reverb.processStereo(reverbChannels[0], reverbChannels[1], blockSize);
+		}
+		else
+		{
+			reverb.processMono(reverbChannels[0], blockSize);
+		}
+
+		for (int channel = 0; channel < numChannels; ++channel)
+		{
+			for (int i = 0; i < blockSize; ++i)
+			{
+				channels[channel][start + i] += reverbChannels[channel][i];
+				peak = juce::jmax(peak, std::abs(reverbChannels[channel][i]));
+			}
+		}
+	}
+
+	running[Reverb] = amount.isSmoothing() || amount.getTargetValue() > 0.0f || peak > tailThreshold;
+}
+
+void DeckEffects::DelayLine::prepare(int maxDelaySamples)
+{
+	buffer.setSize(2, maxDelaySamples + 2);
+	clear();
+}
+
+void DeckEffects::DelayLine::clear()
+{
+	buffer.clear();
+	writeIndex = 0;
+}
+
+float DeckEffects::DelayLine::read(int channel, float delaySamples) const
+{
+	const int size = buffer.getNumSamples();
+	float readPosition = static_cast<float>(writeIndex) - delaySamples;
+
+	if (readPosition < 0.0f)
+	{
+		readPosition += static_cast<float>(size);
+	}
+
+	// Linear interpolation between the two samples either side
+	const int index = static_cast<int>(readPosition);
+	const float fraction = readPosition - static_cast<float>(index);
+	const float* data = buffer.getReadPointer(channel);
+	const float a = data[index];
+	const float b = data[index + 1 < size ? index + 1 : 0];
+
+	return a + fraction * (b - a);
+}
+
+void DeckEffects::DelayLine::write(int channel, float sample)
+{
+	buffer.setSample(channel, writeIndex, sample);
+}
+
+void DeckEffects::DelayLine::advance()
+{
+	if (++writeIndex == buffer.getNumSamples())
+	{
+		writeIndex = 0;
+	}
+}
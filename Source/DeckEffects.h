@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+	DeckEffects.h
+	Created: 21 Oct 2026 4:05:12pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+/**
+ * DeckEffects class is the insert effect rack of one deck: echo, reverb,
+ * flanger and bitcrusher, each switched in and out while playing.
+ *
+ * The signal runs through the bitcrusher, flanger, echo and reverb in that
+ * order. Effects glide in and out rather than switching, and the echo and
+ * reverb keep ringing out after being switched off, only stopping once
+ * their tails have died away. The echo repeats and the flanger sweep follow
+ * the deck's tempo.
+ *
+ * Delay lines and the reverb are allocated in prepare, nothing is allocated
+ * while processing, and effects that are off cost nothing.
+ */
+class DeckEffects
+{
+public:
+	/**
+	 * The effects of the rack.
+	 */
+	enum Effect { Echo, Reverb, Flanger, Bitcrush, numEffects };
+
+	/**
+	 * Constructor for the DeckEffects class.
+	 */
+	DeckEffects();
+
+	/**
+	 * Destructor for the DeckEffects class.
+	 */
+	~DeckEffects();
+
+	/**
+	 * Allocates the delay lines and clears the effects.
+	 *
+	 * @param samplesPerBlockExpected	The expected samples number per block.
+	 * @param sampleRate				The audio sample rate.
+	 */
+	void prepare(int samplesPerBlockExpected, double sampleRate);
+
+	/**
+	 * Applies the effects to a block of audio in place. Called on the audio thread.
+	 *
+	 * @param bufferToFill	The block to process, only the first two channels are used.
+	 */
+	void process(const juce::AudioSourceChannelInfo& bufferToFill);
+
+	/**
+	 * Switches an effect in or out.
+	 *
+	 * @param effect	The effect to switch.
+	 * @param enabled	True to switch the effect in.
+	 */
+	void setEnabled(Effect effect, bool enabled);
+
+	/**
+	 * Sets how much of the effects is heard.
+	 *
+	 * @param mix	0 for none to 1 for fully wet.
+	 */
+	void setMix(float mix);
+
+	/**
+	 * Sets the tempo the effects are synced to.
+	 *
+	 * @param bpm	Beats per minute as heard, or 0 if unknown.
+	 */
+	void setTempo(double bpm);
+
+private:
+	/**
+	 * Stereo delay line read at fractional delays.
+	 */
+	struct DelayLine
+	{
+		juce::AudioBuffer<float> buffer;
+		int writeIndex = 0;
+
+		void prepare(int maxDelaySamples);
+		void clear();
+		float read(int channel, float delaySamples) const;
+		void write(int channel, float sample);
+		void advance();
+	};
+
+	/**
+	 * Runs one effect over a block, wet share gliding from the effect's amount.
+	 */
+	void processBitcrush(float* const* channels, int numChannels, int numSamples);
+	void processFlanger(float* const* channels, int numChannels, int numSamples, double beatSamples);
+	void processEcho(float* const* channels, int numChannels, int numSamples, double beatSamples);
+	void processReverb(float* const* channels, int numChannels, int numSamples);
+
+	/**
+	 * Clears an effect's state before it is switched in.
+	 */
+	void resetEffect(Effect effect);
+
+	/**
+	 * Controls set by the message thread.
+	 */
+	std::array<std::atomic<bool>, numEffects> enabled;
+	std::atomic<float> mix{ 0.5f };
+	std::atomic<double> tempo{ 0.0 };
+
+	/**
+	 * Wet share of each effect being glided, and whether it is still running.
+	 */
+	std::array<juce::SmoothedValue<float>, numEffects> amounts;
+	std::array<bool, numEffects> running{};
+
+	/**
+	 * Echo delay line, delay being glided to the tempo and feedback damping.
+	 */
+	DelayLine echoLine;
+	float echoDelay = 0.0f;
+	float echoDelaySmoothing = 1.0f;
+	float echoDampingCoefficient = 1.0f;
+	std::array<float, 2> echoDamping{};
+
+	/**
+	 * Reverb and the block it is fed with.
+	 */
+	juce::Reverb reverb;
+	juce::AudioBuffer<float> reverbBuffer;
+
+	/**
+	 * Flanger delay line and sweep phase in cycles.
+	 */
+	DelayLine flangerLine;
+	double flangerPhase = 0.0;
+
+	/**
+	 * Bitcrusher held samples and samples left to hold them.
+	 */
+	std::array<float, 2> crushHeld{};
+	int crushHoldRemaining = 0;
+
+	double sampleRate = 44100.0;
+
+	/**
+	 * Tempo used when the track's is unknown.
+	 */
+	static constexpr double defaultTempo = 120.0;
+
+	/**
+	 * Echo repeat time, flanger sweep time, and the shortest beat covered.
+	 */
+	static constexpr double echoBeats = 0.75;
+	static constexpr double flangerBeats = 8.0;
+	static constexpr double slowestTempo = 40.0;
+
+	/**
+	 * Echo and flanger feedback, and the bitcrusher's levels either side of
+	 * zero and samples each level is held for.
+	 */
+	static constexpr float echoFeedback = 0.45f;
+	static constexpr float flangerFeedback = 0.6f;
+	static constexpr float crushLevels = 32.0f;
+	static constexpr int crushHold = 4;
+
+	/**
+	 * Output level under which a switched off echo or reverb is treated as silent.
+	 */
+	static constexpr float tailThreshold = 1.0e-4f;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckEffects)
+};
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+	DeckFilter.cpp
+	Created: 21 Oct 2026 2:18:55pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "DeckFilter.h"
+
+DeckFilter::DeckFilter()
+{
+	smoothedPosition.setCurrentAndTargetValue(0.0f);
+}
+
+DeckFilter::~DeckFilter()
+{
+
+}
+
+void DeckFilter::prepare(int samplesPerBlockExpected, double _sampleRate)
+{
+	sampleRate = _sampleRate;
+
+	filter.prepare({ sampleRate, static_cast<juce::uint32>(juce::jmax(1, samplesPerBlockExpected)), 2 });
+	filter.setType(juce::dsp::StateVariableTPTFilterType::highpass);
+	filter.setResonance(juce::MathConstants<float>::sqrt2 * 0.5f);
+	filter.reset();
+	filterResonance = 0.0f;
+	updateCutoff(0.0f);
+
+	// The knob glides over 30ms
+	smoothedPosition.reset(sampleRate / subBlockSize, 0.03);
+	smoothedPosition.setCurrentAndTargetValue(0.0f);
+	lastWet = 0.0f;
+	bypassed = true;
+}
+
+void DeckFilter::setPosition(float position)
+{
+	targetPosition = juce::jlimit(-1.0f, 1.0f, position);
+}
+
+void DeckFilter::setResonance(float resonance)
+{
+	targetResonance = juce::jlimit(0.0f, 1.0f, resonance);
+}
+
+void DeckFilter::process(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+	smoothedPosition.setTargetValue(targetPosition);
+
+	// True bypass with the knob resting at centre
+	if (!smoothedPosition.isSmoothing() && smoothedPosition.getTargetValue() == 0.0f)
+	{
+		bypassed = true;
+		return;
+	}
+
+	// Leaving centre, the filter starts from silence while it is faded out
+	if (bypassed)
+	{
+		filter.reset();
+		lastWet = 0.0f;
+		bypassed = false;
+	}
+
+	juce::ScopedNoDenormals noDenormals;
+
+	for (int start = 0; start < bufferToFill.numSamples; start += subBlockSize)
+	{
+		const int numSamples = juce::jmin(subBlockSize, bufferToFill.numSamples - start);
+		processSubBlock(bufferToFill, start, numSamples, smoothedPosition.getNextValue());
+	}
+}
+
+void DeckFilter::processSubBlock(const juce::AudioSourceChannelInfo& bufferToFill, int start, int numSamples, float position)
+{
+	// Crossing centre, fade the old filter out before changing its type
+	const bool crossing = (position < 0.0f) != (filterPosition < 0.0f);
+
+	if (!crossing && position != filterPosition)
+	{
+		updateCutoff(position);
+	}
+
+	const float resonance = targetResonance;
+	if (resonance != filterResonance)
+	{
+		// Butterworth with no resonance, up to a Q of 5
+		filter.setResonance(juce::MathConstants<float>::sqrt2 * 0.5f + resonance * 4.3f);
+		filterResonance = resonance;
+	}
+
+	// Ramp the share of filtered signal across the sub-block
+	const float wet = crossing ? 0.0f : juce::jmin(1.0f, std::abs(position) / fadeWidth);
+	const float wetStep = (wet - lastWet) / numSamples;
+	auto& buffer = *bufferToFill.buffer;
+	const int numChannels = juce::jmin(2, buffer.getNumChannels());
+
+	for (int channel = 0; channel < numChannels; ++channel)
+	{
+		float* samples = buffer.getWritePointer(channel, bufferToFill.startSample + start);
+
+		for (int i = 0; i < numSamples; ++i)
+		{
+			const float dry = samples[i];
+			const float rampedWet = lastWet + wetStep * (i + 1);
+			samples[i] = dry + rampedWet * (filter.processSample(channel, dry) - dry);
+		}
+	}
+
+	lastWet = wet;
+
+	// Nothing of the filter is heard now, so it can change type
+	if (crossing)
+	{
+		filter.setType(position < 0.0f ? juce::dsp::StateVariableTPTFilterType::lowpass
+			: juce::dsp::StateVariableTPTFilterType::highpass);
+		filter.reset();
+		updateCutoff(position);
+	}
+}
+
+void DeckFilter::updateCutoff(float position)
+{
+	// Lowpass from 20kHz down to 50Hz, highpass from 20Hz up to 10kHz, evenly in octaves
+	const double cutoff = position < 0.0f
+		? 20000.0 * std::pow(50.0 / 20000.0, static_cast<double>(-position))
+		: 20.0 * std::pow(10000.0 / 20.0, static_cast<double>(position));
+
+	filter.setCutoffFrequency(static_cast<float>(juce::jmin(cutoff, sampleRate * 0.45)));
+	filterPosition = position;
+}
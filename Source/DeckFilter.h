@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+	DeckFilter.h
+	Created: 21 Oct 2026 2:18:55pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+/**
+ * DeckFilter class is a single knob filter sweep for one deck.
+ *
+ * Turning the knob left of centre closes a lowpass, right of centre opens
+ * a highpass, using juce::dsp's TPT state variable filter. The knob glides,
+ * and the filter is faded in over the first part of each side, so the
+ * filter type only ever changes while nothing of it is heard. With the knob
+ * at centre the filter is bypassed and costs nothing.
+ */
+class DeckFilter
+{
+public:
+	/**
+	 * Constructor for the DeckFilter class.
+	 */
+	DeckFilter();
+
+	/**
+	 * Destructor for the DeckFilter class.
+	 */
+	~DeckFilter();
+
+	/**
+	 * Prepares the filter for playing.
+	 *
+	 * @param samplesPerBlockExpected	The expected samples number per block.
+	 * @param sampleRate				The audio sample rate.
+	 */
+	void prepare(int samplesPerBlockExpected, double sampleRate);
+
+	/**
+	 * Applies the filter to a block of audio in place. Called on the audio thread.
+	 *
+	 * @param bufferToFill	The block to process, only the first two channels are used.
+	 */
+	void process(const juce::AudioSourceChannelInfo& bufferToFill);
+
+	/**
+	 * Sets the knob position.
+	 *
+	 * @param position	-1 for the lowest lowpass, 0 for no filter, 1 for the highest highpass.
+	 */
+	void setPosition(float position);
+
+	/**
+	 * Sets the resonance at the cutoff frequency.
+	 *
+	 * @param resonance		0 for none to 1 for the most.
+	 */
+	void setResonance(float resonance);
+
+private:
+	/**
+	 * Applies the filter at one knob position to part of a block.
+	 */
+	void processSubBlock(const juce::AudioSourceChannelInfo& bufferToFill, int start, int numSamples, float position);
+
+	/**
+	 * Sets the cutoff frequency for a knob position on the filter's current side.
+	 */
+	void updateCutoff(float position);
+
+	/**
+	 * The filter, switched between lowpass and highpass.
+	 */
+	juce::dsp::StateVariableTPTFilter<float> filter;
+
+	/**
+	 * Knob position and resonance set by the message thread.
+	 */
+	std::atomic<float> targetPosition{ 0.0f };
+	std::atomic<float> targetResonance{ 0.0f };
+
+	/**
+	 * Knob position being glided, and the one the filter was last set for.
+	 */
+	juce::SmoothedValue<float> smoothedPosition;
+	float filterPosition = 0.0f;
+	float filterResonance = 0.0f;
+
+	/**
+	 * Share of filtered signal at the end of the last sub-block, ramped from.
+	 */
+	float lastWet = 0.0f;
+
+	/**
+	 * True while the filter is bypassed at centre.
+	 */
+	bool bypassed = true;
+
+	double sampleRate = 44100.0;
+
+	/**
+	 * Samples processed between coefficient updates.
+	 */
+	static constexpr int subBlockSize = 16;
+
+	/**
+	 * Knob travel from centre over which the filter fades in.
+	 */
+	static constexpr float fadeWidth = 0.1f;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckFilter)
+};
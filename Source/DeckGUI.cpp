@@ -31,6 +31,9 @@ DeckGUI::DeckGUI(DJAudioPlayer* _player,
 	setupSlider(volSlider, 0.5, 0.0, 1.0, true, 
 		juce::Slider::LinearBarVertical, true, true, false);
 
+	// Setup level meter beside the volume slider
+	addAndMakeVisible(vuMeter);
+
 	// Setup speed rotary slider with text label
 	setupSlider(speedSlider, 1.0, 0.0, 3.0, true, 
 		juce::Slider::Rotary, true, false, false);
@@ -48,6 +51,27 @@ DeckGUI::DeckGUI(DJAudioPlayer* _player,
 	
 	// Setup play and pause buttons
 	setupPlayPauseButton();
+
+	// Setup hot cue buttons, numbered from 1
+	for (int i = 0; i < DJAudioPlayer::numHotCues; ++i)
+	{
+		auto* button = hotCueButtons.add(new juce::TextButton(juce::String(i + 1)));
+		setupTextButton(*button, "Click to set or jump to hot cue " + juce::String(i + 1) + ", shift-click to clear");
+	}
+
+	// Setup reverse and censor buttons
+	setupTextButton(reverseButton, "Play backwards");
+	setupTextButton(censorButton, "Hold to play backwards, playback carries on underneath");
+	reverseButton.setClickingTogglesState(true);
+
+	// Setup loop buttons
+	setupTextButton(loopInButton, "Set the loop in point");
+	setupTextButton(loopOutButton, "Loop from the loop in point to here");
+	setupTextButton(loopHalveButton, "Halve the auto loop length");
+	setupTextButton(autoLoopButton, "Loop on the beat, click again to leave the loop");
+	setupTextButton(loopDoubleButton, "Double the auto loop length");
+	setupTextButton(loopRollButton, "Hold to roll a loop, playback carries on underneath");
+	updateLoopButtons();
 	
 	// Start timer
 	startTimer(100);
@@ -112,6 +136,19 @@ void DeckGUI::setupImageButton(juce::ImageButton& button, const char* imageData,
 	button.addListener(this);
 }
 
+// Sets up the hot cue and loop buttons
+void DeckGUI::setupTextButton(juce::TextButton& button, const juce::String& tooltip)
+{
+	button.setColour(juce::TextButton::buttonColourId, juce::Colours::transparentBlack);
+	button.setColour(juce::TextButton::buttonOnColourId, juce::Colours::cyan.withAlpha(0.6f));
+	button.setColour(juce::TextButton::textColourOffId, juce::Colours::cyan);
+	button.setColour(juce::TextButton::textColourOnId, juce::Colours::black);
+	button.setTooltip(tooltip);
+	button.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+	button.addListener(this);
+	addAndMakeVisible(button);
+}
+
 // Setup play and pause buttons
 void DeckGUI::setupPlayPauseButton()
 {
@@ -150,7 +187,7 @@ void DeckGUI::paint(juce::Graphics& g)
 	// Calculate the position of the text dynamically based on the component size
 	int textX = getWidth() * 0.05;
 	int textY = getHeight() * 0.025;
-	int textWidth = getWidth(); // Example: 20% of the component width
+	int textWidth = getWidth() * 0.42; // Leave room for the loop buttons
 	int textHeight = getHeight() / 10; // Example: 10% of the component height
 
 	// Everytime audio is loaded, it extract metadata (title) and display
@@ -181,6 +218,7 @@ void DeckGUI::resized()
 		waveformDisplay.setBounds(0, rowH * 1.5, getWidth(), rowH * 2);
 
 		volSlider	   .setBounds(rowW * 8.85, (rowH * 3.5) + marginY, rowW, rowH * 6.2);
+		vuMeter		   .setBounds(rowW * 8.5, (rowH * 3.5) + marginY, rowW * 0.25, rowH * 6.2);
 		discSlider	   .setBounds(rowW * 4.4, rowH * 3.8, rowW * 4, rowW * 4);
 
 		speedSlider    .setBounds(rowW * 1.2, rowH * 4.7, sliderSize * 2, sliderSize);
@@ -198,6 +236,7 @@ void DeckGUI::resized()
 		waveformDisplay.setBounds(0, rowH * 1.5, getWidth(), rowH * 2);
 		
 		volSlider.setBounds(marginX, (rowH * 3.5) + marginY, rowW, rowH * 6.2);
+		vuMeter.setBounds(marginX + rowW * 1.1, (rowH * 3.5) + marginY, rowW * 0.25, rowH * 6.2);
 		discSlider.setBounds(rowW * 1.6, rowH * 3.8, rowW * 4, rowW * 4);
 
 		speedSlider.setBounds(rowW * 6.6, rowH * 4.7, sliderSize * 2, sliderSize);
@@ -209,6 +248,25 @@ void DeckGUI::resized()
 		imgRewindButton.setBounds(rowW * 6, rowH * 8.2, btnSize, btnSize);
 		imgFastButton.setBounds(rowW * 8.5, rowH * 8.2, btnSize, btnSize);
 	}
+
+	// Hot cues in a row below the waveform, on the opposite side to the disc
+	float cueX = isDeckGUI1 ? rowW * 0.3f : rowW * 5.9f;
+	float cueW = rowW * 3.8f / DJAudioPlayer::numHotCues;
+
+	for (int i = 0; i < hotCueButtons.size(); ++i)
+	{
+		hotCueButtons[i]->setBounds(cueX + cueW * i, rowH * 3.6, cueW - marginX * 0.5f, rowH * 0.55);
+	}
+
+	// Reverse and loop buttons on the right of the title
+	juce::TextButton* titleButtons[] = { &reverseButton, &censorButton, &loopInButton, &loopOutButton,
+		&loopHalveButton, &autoLoopButton, &loopDoubleButton, &loopRollButton };
+	float titleButtonW = rowW * 5.1f / 8;
+
+	for (int i = 0; i < 8; ++i)
+	{
+		titleButtons[i]->setBounds(rowW * 4.7 + titleButtonW * i, rowH * 0.35, titleButtonW - marginX * 0.5f, rowH * 0.7);
+	}
 }
 
 void DeckGUI::buttonClicked(juce::Button* button)
@@ -247,6 +305,55 @@ void DeckGUI::buttonClicked(juce::Button* button)
 		handleReplayButton();
 		return;
 	}
+
+	// Hot cue buttons
+	int cueIndex = hotCueButtons.indexOf(dynamic_cast<juce::TextButton*>(button));
+	if (cueIndex >= 0)
+	{
+		handleHotCueButton(cueIndex);
+		return;
+	}
+
+	// Reverse button, censor is handled in buttonStateChanged
+	if (button == &reverseButton)
+	{
+		DBG("< REV > button was clicked << Reverse " << (reverseButton.getToggleState() ? "on" : "off") << " >>");
+		player->setReverse(reverseButton.getToggleState());
+		return;
+	}
+
+	// Loop buttons, loop roll is handled in buttonStateChanged
+	if (button == &loopInButton || button == &loopOutButton || button == &loopHalveButton
+		|| button == &autoLoopButton || button == &loopDoubleButton)
+	{
+		handleLoopButton(button);
+		return;
+	}
+}
+
+void DeckGUI::buttonStateChanged(juce::Button* button)
+{
+	// Roll while the button is held down
+	if (button == &loopRollButton)
+	{
+		if (button->isDown())
+		{
+			DBG("< ROLL > button was pressed << Loop roll " << loopLengths[loopLengthIndex] << " beats >>");
+			player->startLoopRoll(loopLengths[loopLengthIndex]);
+		}
+		else
+		{
+			player->stopLoopRoll();
+		}
+
+		updateLoopButtons();
+	}
+
+	// Reverse while the button is held down
+	if (button == &censorButton)
+	{
+		player->setCensor(button->isDown());
+	}
 }
 
 // Stop button
@@ -302,6 +409,94 @@ void DeckGUI::handleReplayButton()
 	player->replay(!replayEnable);
 }
 
+// Hot cue buttons
+void DeckGUI::handleHotCueButton(int cueIndex)
+{
+	juce::int64 position = player->getHotCue(cueIndex);
+
+	if (juce::ModifierKeys::currentModifiers.isShiftDown())
+	{
+		DBG("< HOT CUE " << cueIndex + 1 << " > button was shift-clicked << Hot cue cleared >>");
+		position = -1;
+	}
+	else if (position >= 0)
+	{
+		DBG("< HOT CUE " << cueIndex + 1 << " > button was clicked << Jump to hot cue >>");
+		player->jumpToHotCue(cueIndex);
+		return;
+	}
+	else
+	{
+		DBG("< HOT CUE " << cueIndex + 1 << " > button was clicked << Hot cue set >>");
+		position = player->getPositionInSamples();
+	}
+
+	player->setHotCue(cueIndex, position);
+	updateHotCueButtons();
+
+	// Store the hot cue with the audio track
+	if (onHotCueChanged != nullptr)
+	{
+		onHotCueChanged(loadedURL, cueIndex, position);
+	}
+}
+
+// Loop buttons
+void DeckGUI::handleLoopButton(juce::Button* button)
+{
+	if (button == &loopInButton)
+	{
+		DBG("< LOOP IN > button was clicked");
+		player->setLoopIn();
+	}
+	else if (button == &loopOutButton)
+	{
+		DBG("< LOOP OUT > button was clicked");
+		player->setLoopOut();
+	}
+	else if (button == &loopHalveButton)
+	{
+		loopLengthIndex = juce::jmax(0, loopLengthIndex - 1);
+	}
+	else if (button == &loopDoubleButton)
+	{
+		loopLengthIndex = juce::jmin(static_cast<int>(std::size(loopLengths)) - 1, loopLengthIndex + 1);
+	}
+	else if (button == &autoLoopButton)
+	{
+		if (player->isLoopActive())
+		{
+			DBG("< LOOP > button was clicked << Loop exited >>");
+			player->exitLoop();
+		}
+		else
+		{
+			DBG("< LOOP > button was clicked << Loop " << loopLengths[loopLengthIndex] << " beats >>");
+			player->setAutoLoop(loopLengths[loopLengthIndex]);
+		}
+	}
+
+	updateLoopButtons();
+}
+
+void DeckGUI::updateLoopButtons()
+{
+	// Show fractions of a beat as 1/4 and 1/2
+	double beats = loopLengths[loopLengthIndex];
+	juce::String length = beats < 1.0 ? "1/" + juce::String(juce::roundToInt(1.0 / beats)) : juce::String(static_cast<int>(beats));
+
+	autoLoopButton.setButtonText("LOOP " + length);
+	autoLoopButton.setToggleState(player->isLoopActive(), juce::NotificationType::dontSendNotification);
+}
+
+void DeckGUI::updateHotCueButtons()
+{
+	for (int i = 0; i < hotCueButtons.size(); ++i)
+	{
+		hotCueButtons[i]->setToggleState(player->getHotCue(i) >= 0, juce::NotificationType::dontSendNotification);
+	}
+}
+
 void DeckGUI::sliderValueChanged(juce::Slider* slider)
 {
 	// Volume slider
@@ -322,9 +517,51 @@ void DeckGUI::sliderValueChanged(juce::Slider* slider)
 		player->setPositionRelative(slider->getValue());
 	}
 
+	// Disc, scratching while held
 	if (slider == &discSlider)
 	{
-		player->setPositionRelative(slider->getValue());
+		if (!discSlider.isMouseButtonDown())
+		{
+			player->setPositionRelative(slider->getValue());
+			return;
+		}
+
+		double now = juce::Time::getMillisecondCounterHiRes();
+		double value = slider->getValue();
+
+		// The first movement only tells where the disc was grabbed
+		if (scratchValue >= 0.0)
+		{
+			// One unit is a full turn, take the short way round past the top
+			double turns = value - scratchValue;
+			turns -= std::round(turns);
+
+			double seconds = juce::jmax(0.001, (now - scratchTime) / 1000.0);
+			player->setScratchVelocity(juce::jlimit(-8.0, 8.0, turns * secondsPerTurn / seconds));
+		}
+
+		scratchValue = value;
+		scratchTime = now;
+	}
+}
+
+void DeckGUI::sliderDragStarted(juce::Slider* slider)
+{
+	if (slider == &discSlider)
+	{
+		DBG("< DISC > was grabbed << Scratching >>");
+		scratchValue = -1.0;
+		scratchTime = juce::Time::getMillisecondCounterHiRes();
+		player->startScratch();
+	}
+}
+
+void DeckGUI::sliderDragEnded(juce::Slider* slider)
+{
+	if (slider == &discSlider)
+	{
+		DBG("< DISC > was released");
+		player->stopScratch();
 	}
 }
 
@@ -338,18 +575,41 @@ void DeckGUI::filesDropped(const juce::StringArray& files, int x, int y)
 	DBG("DeckGUI::filesDropped");
 	if (files.size() == 1)
 	{
-		player->loadURL(juce::URL{ juce::File{files[0]} });
+		loadedURL = juce::URL{ juce::File{files[0]} };
+		player->loadURL(loadedURL);
+		updateHotCueButtons();
+		updateLoopButtons();
 	}
 }
 
 // Called by timer to update waveform display position
 void DeckGUI::timerCallback()
 {
+	// A disc held still stops the audio
+	if (discSlider.isMouseButtonDown() && juce::Time::getMillisecondCounterHiRes() - scratchTime > 50.0)
+	{
+		player->setScratchVelocity(0.0);
+	}
+
+	// The latency is only known once the audio thread has applied the seek
+	const juce::uint32 numSeeksApplied = player->getNumSeeksApplied();
+	if (numSeeksApplied != numSeeksReported)
+	{
+		numSeeksReported = numSeeksApplied;
+		DBG("Last seek applied after " << player->getLastSeekLatencyMs() << " ms");
+	}
+
 	double pos = player->getPositionRelative();
 	if (pos > 0.0 && pos < 1.0)
 	{
 		waveformDisplay.setPositionRelative(pos);
-		discSlider.setValue(pos);  
+
+		// Only follow playback, moving the disc here must not seek,
+		// and leave the disc alone while it is being scratched
+		if (!discSlider.isMouseButtonDown())
+		{
+			discSlider.setValue(pos, juce::NotificationType::dontSendNotification);
+		}
 
 		double angle = pos * 360.0;
 
@@ -359,10 +619,23 @@ void DeckGUI::timerCallback()
 }
 
 // Loads audio URL into player and display waveform
-void DeckGUI::loadToPlaylist(const juce::URL& audioURL)
+void DeckGUI::loadToPlaylist(const juce::URL& audioURL, double bpm, const DJAudioPlayer::HotCues* hotCues)
 {
 	// Load audio URL into player
+	loadedURL = audioURL;
 	player->loadURL(audioURL);
+	player->setBpm(bpm);
+
+	// Restore the audio track's hot cues
+	if (hotCues != nullptr)
+	{
+		for (int i = 0; i < DJAudioPlayer::numHotCues; ++i)
+		{
+			player->setHotCue(i, (*hotCues)[static_cast<size_t>(i)]);
+		}
+	}
+	updateHotCueButtons();
+	updateLoopButtons();
 
 	// Load audio URL into waveform display
 	waveformDisplay.loadURL(audioURL);
@@ -371,6 +644,20 @@ void DeckGUI::loadToPlaylist(const juce::URL& audioURL)
 	trackLoaded = true;
 }
 
+void DeckGUI::setTrackLoudness(const juce::URL& audioURL, float loudness)
+{
+	// The analysis may finish after another audio track was loaded
+	if (audioURL == loadedURL)
+	{
+		player->setTrackLoudness(loudness);
+	}
+}
+
+const juce::URL& DeckGUI::getLoadedURL() const
+{
+	return loadedURL;
+}
+
 void DeckGUI::setImageButton(juce::ImageButton& button, const void* imageData, int imageDataSize)
 {
 	auto image = juce::ImageCache::getFromMemory(imageData, imageDataSize);
@@ -423,4 +710,9 @@ void DeckGUI::setVolume(double volume)
 
 	// Set the volume level of the associated player
 	player->setGain(volume);
+}
+
+void DeckGUI::setLevelMeter(LevelMeter* meter)
+{
+	vuMeter.setMeter(meter);
 }
\ No newline at end of file
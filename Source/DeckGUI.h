@@ -13,9 +13,9 @@
 #include <JuceHeader.h>
 #include "DJAudioPlayer.h"
 #include "WaveformDisplay.h"
-#include "AudioTrack.h"
 #include "CustomDesign.h"
 #include "DiscDesign.h"
+#include "VUMeter.h"
 
 //==============================================================================
 /**
@@ -71,6 +71,13 @@ public:
 	 */
 	void buttonClicked(juce::Button*) override;
 
+	/**
+	 * ButtonStateChanged method override to hold loop rolls and the censor while the button is down.
+	 *
+	 * @param button Pointer to the button whose state changed.
+	 */
+	void buttonStateChanged(juce::Button* button) override;
+
 	/**
 	 * Handles slider value changes in the DeckGUI component.
 	 *
@@ -78,6 +85,20 @@ public:
 	 */
 	void sliderValueChanged(juce::Slider* slider) override;
 
+	/**
+	 * Starts scratching when the disc is grabbed.
+	 *
+	 * @param slider The slider being dragged.
+	 */
+	void sliderDragStarted(juce::Slider* slider) override;
+
+	/**
+	 * Stops scratching when the disc is let go.
+	 *
+	 * @param slider The slider that was dragged.
+	 */
+	void sliderDragEnded(juce::Slider* slider) override;
+
 	/**
 	 * Allow file drag events.
 	 *
@@ -104,8 +125,27 @@ public:
 	 * Loads audio URL into the player and waveform display.
 	 *
 	 * @param audioURL	The URL of the audio to load.
+	 * @param bpm		The audio track's beats per minute, or 0 if unknown.
+	 * @param hotCues	The audio track's stored hot cues, or nullptr if none.
+	 */
+	void loadToPlaylist(const juce::URL& audioURL, double bpm = 0.0,
+		const DJAudioPlayer::HotCues* hotCues = nullptr);
+
+	/**
+	 * Passes an audio track's analysed loudness to the player if the track
+	 * is the one loaded, so the deck plays it trimmed to the common level.
+	 *
+	 * @param audioURL	The audio track's URL.
+	 * @param loudness	The integrated loudness in LUFS.
+	 */
+	void setTrackLoudness(const juce::URL& audioURL, float loudness);
+
+	/**
+	 * Returns the URL of the loaded audio track.
+	 *
+	 * @return The audio track's URL, empty if nothing is loaded.
 	 */
-	void loadToPlaylist(const juce::URL& audioURL);
+	const juce::URL& getLoadedURL() const;
 
 	/**
 	 * Sets the volume level of DeckGUI's associated player.
@@ -115,6 +155,19 @@ public:
 	 */
 	void setVolume(double volume);
 
+	/**
+	 * Sets the meter shown beside the volume slider.
+	 *
+	 * @param meter		The deck's meter, or nullptr to show nothing.
+	 */
+	void setLevelMeter(LevelMeter* meter);
+
+	/**
+	 * Called when a hot cue of the loaded audio track is set or cleared,
+	 * with the track's URL, the hot cue and its position (-1 when cleared).
+	 */
+	std::function<void(const juce::URL&, int, juce::int64)> onHotCueChanged;
+
 private:
 	/**
 	 * Setup sliders with specified parameters.
@@ -151,6 +204,14 @@ private:
 	 */
 	void setupImageButton(juce::ImageButton& button, const char* imageData, int imageDataSize);
 
+	/**
+	 * Sets up a small text button for the hot cue and loop controls.
+	 *
+	 * @param button			Reference to the text button object to setup.
+	 * @param tooltip			Tooltip explaining the button.
+	 */
+	void setupTextButton(juce::TextButton& button, const juce::String& tooltip);
+
 	/**
 	 * Sets up play and pause buttons.
 	 */
@@ -181,6 +242,32 @@ private:
 	 */
 	void handleReplayButton();
 
+	/**
+	 * Handles the action when a hot cue button is clicked.
+	 * An empty hot cue is set at the playback position, a set one is jumped to,
+	 * and shift-click clears it.
+	 *
+	 * @param cueIndex		The hot cue of the clicked button.
+	 */
+	void handleHotCueButton(int cueIndex);
+
+	/**
+	 * Shows which hot cues of the loaded audio track are set.
+	 */
+	void updateHotCueButtons();
+
+	/**
+	 * Handles the action when one of the loop buttons is clicked.
+	 *
+	 * @param button		The clicked loop button.
+	 */
+	void handleLoopButton(juce::Button* button);
+
+	/**
+	 * Shows the auto loop length and whether a loop is playing.
+	 */
+	void updateLoopButtons();
+
 	/**
 	 * Sets the images and mouse cursor for the given ImageButton with image data.
 	 *
@@ -231,6 +318,61 @@ private:
 	*/
 	juce::Slider volSlider, speedSlider, posSlider, discSlider;
 
+	/**
+	 * Level meter beside the volume slider.
+	 */
+	VUMeter vuMeter;
+
+	/**
+	 * Buttons to set, jump to and clear each hot cue.
+	 */
+	juce::OwnedArray<juce::TextButton> hotCueButtons;
+
+	/**
+	 * Buttons to toggle reverse and hold the censor.
+	 */
+	juce::TextButton reverseButton{ "REV" }
+					,censorButton{ "CENSOR" };
+
+	/**
+	 * Buttons to set a loop in and out, change and toggle the auto loop
+	 * length, and hold a loop roll.
+	 */
+	juce::TextButton loopInButton{ "IN" }
+					,loopOutButton{ "OUT" }
+					,loopHalveButton{ "/2" }
+					,autoLoopButton
+					,loopDoubleButton{ "x2" }
+					,loopRollButton{ "ROLL" };
+
+	/**
+	 * Auto loop and loop roll lengths in beats, and the one selected.
+	 */
+	static constexpr double loopLengths[] = { 0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 32.0 };
+	int loopLengthIndex = 4;
+
+	/**
+	 * Disc value and time of the last jog movement, used to work out the scratch velocity.
+	 * The value is negative until the first movement after the disc is grabbed.
+	 */
+	double scratchValue = -1.0;
+	double scratchTime = 0.0;
+
+	/**
+	 * Seeks applied by the audio thread whose latency has been logged.
+	 */
+	juce::uint32 numSeeksReported = 0;
+
+	/**
+	 * Seconds of audio per turn of the disc, a record at 33 1/3 rpm.
+	 */
+	static constexpr double secondsPerTurn = 1.8;
+
+	/**
+	 * URL of the loaded audio track, reported with hot cue changes.
+	 */
+	juce::URL loadedURL;
+
 	/**
 	 * Label for displaying the speed title term.
 	 */
@@ -0,0 +1,425 @@
+/*
+  ==============================================================================
+
+	DeckSource.cpp
+	Created: 20 Oct 2026 11:48:02am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "DeckSource.h"
+
+DeckSource::DeckSource()
+{
+
+}
+
+DeckSource::~DeckSource()
+{
+
+}
+
+void DeckSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+	juce::ignoreUnused(samplesPerBlockExpected);
+
+	outputSampleRate = sampleRate;
+
+	// Jumps crossfade over 5ms
+	crossfadeSamples = juce::jmax(1, juce::roundToInt(sampleRate * 0.005));
+
+	// Speed changes glide with a 10ms time constant
+	incrementSmoothing = 1.0 - std::exp(-1.0 / (sampleRate * 0.01));
+}
+
+void DeckSource::releaseResources()
+{
+
+}
+
+void DeckSource::setTrack(std::unique_ptr<TrackCache> newTrack)
+{
+	std::unique_ptr<TrackCache> oldTrack;
+
+	{
+		const juce::SpinLock::ScopedLockType sl(trackLock);
+
+		oldTrack = std::move(track);
+		track = std::move(newTrack);
+		trackLength = track != nullptr ? track->getLengthInSamples() : 0;
+		trackSampleRate = track != nullptr ? track->getSampleRate() : 0.0;
+
+		playing = false;
+		seekFifo.reset();
+		loopChanged = false;
+		loopStart = loopEnd = 0;
+		rolling = false;
+		direction = Direction::Forward;
+		currentDirection = Direction::Forward;
+		position = 0.0;
+		publishedPosition = 0;
+		fadeRemaining = 0;
+		lastPlayGain = 0.0f;
+	}
+
+	// The old track is freed here, outside the lock, once the audio thread has let go of it
+}
+
+TrackCache* DeckSource::getTrack() const
+{
+	return track.get();
+}
+
+void DeckSource::start()
+{
+	playing = true;
+}
+
+void DeckSource::stop()
+{
+	playing = false;
+}
+
+bool DeckSource::isPlaying() const
+{
+	return playing;
+}
+
+void DeckSource::setSpeed(double ratio)
+{
+	speed = ratio;
+}
+
+void DeckSource::setDirection(Direction newDirection)
+{
+	direction = newDirection;
+}
+
+void DeckSource::setScratching(bool shouldScratch)
+{
+	scratching = shouldScratch;
+}
+
+void DeckSource::setScratchVelocity(double velocity)
+{
+	scratchVelocity = velocity;
+}
+
+void DeckSource::setLooping(bool shouldLoop)
+{
+	looping = shouldLoop;
+}
+
+void DeckSource::setLoop(juce::Range<juce::int64> loop, bool roll)
+{
+	{
+		const juce::SpinLock::ScopedLockType sl(loopLock);
+		pendingLoop = loop;
+		pendingRoll = roll;
+	}
+
+	loopChanged = true;
+}
+
+void DeckSource::jumpTo(juce::int64 sourceSample)
+{
+	pushSeek({ juce::jmax(static_cast<juce::int64>(0), sourceSample), false, juce::Time::getHighResolutionTicks() });
+
+	// Report the new position straight away rather than after the next block
+	publishedPosition = juce::jlimit(static_cast<juce::int64>(0), trackLength, sourceSample);
+}
+
+void DeckSource::seekBy(juce::int64 numSourceSamples)
+{
+	pushSeek({ numSourceSamples, true, juce::Time::getHighResolutionTicks() });
+
+	publishedPosition = juce::jlimit(static_cast<juce::int64>(0), trackLength, publishedPosition + numSourceSamples);
+}
+
+double DeckSource::getLastSeekLatencyMs() const
+{
+	return lastSeekLatencyMs;
+}
+
+juce::uint32 DeckSource::getNumSeeksApplied() const
+{
+	return numSeeksApplied;
+}
+
+void DeckSource::pushSeek(const SeekRequest& request)
+{
+	const auto scope = seekFifo.write(1);
+
+	if (scope.blockSize1 > 0)
+	{
+		seekQueue[static_cast<size_t>(scope.startIndex1)] = request;
+	}
+	else
+	{
+		DBG("DeckSource seek queue is full, seek dropped");
+	}
+}
+
+juce::int64 DeckSource::getPosition() const
+{
+	return publishedPosition;
+}
+
+juce::int64 DeckSource::getLengthInSamples() const
+{
+	return trackLength;
+}
+
+double DeckSource::getSourceSampleRate() const
+{
+	return trackSampleRate;
+}
+
+float DeckSource::getSourceSample(ChunkCursor& cursor, juce::int64 index, int channel) const
+{
+	if (index < 0 || index >= trackLength)
+	{
+		return 0.0f;
+	}
+
+	const int chunkIndex = static_cast<int>(index / TrackCache::chunkSize);
+
+	if (chunkIndex != cursor.chunkIndex)
+	{
+		cursor.chunkIndex = chunkIndex;
+		for (int i = 0; i < track->getNumChannels(); ++i)
+		{
+			cursor.channels[i] = track->getChunk(chunkIndex, i);
+		}
+	}
+
+	const float* data = cursor.channels[channel];
+	return data != nullptr ? data[index & (TrackCache::chunkSize - 1)] : 0.0f;
+}
+
+float DeckSource::getInterpolatedSample(ChunkCursor& cursor, double sourcePosition, int channel) const
+{
+	const double floorPosition = std::floor(sourcePosition);
+	const juce::int64 index = static_cast<juce::int64>(floorPosition);
+	const float t = static_cast<float>(sourcePosition - floorPosition);
+
+	const float y0 = getSourceSample(cursor, index - 1, channel);
+	const float y1 = getSourceSample(cursor, index, channel);
+	const float y2 = getSourceSample(cursor, index + 1, channel);
+	const float y3 = getSourceSample(cursor, index + 2, channel);
+
+	// Catmull-Rom cubic between y1 and y2
+	const float c1 = 0.5f * (y2 - y0);
+	const float c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+	const float c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+
+	return ((c3 * t + c2) * t + c1) * t + y1;
+}
+
+void DeckSource::applyPendingSeeks()
+{
+	const int numReady = seekFifo.getNumReady();
+
+	if (numReady == 0)
+	{
+		return;
+	}
+
+	const auto scope = seekFifo.read(numReady);
+	double newPosition = position;
+
+	auto applySeek = [this, &newPosition](const SeekRequest& request)
+		{
+			newPosition = request.relative ? newPosition + request.target : static_cast<double>(request.target);
+			newPosition = juce::jlimit(0.0, static_cast<double>(trackLength), newPosition);
+		};
+
+	for (int i = 0; i < scope.blockSize1; ++i)
+	{
+		applySeek(seekQueue[static_cast<size_t>(scope.startIndex1 + i)]);
+	}
+
+	for (int i = 0; i < scope.blockSize2; ++i)
+	{
+		applySeek(seekQueue[static_cast<size_t>(scope.startIndex2 + i)]);
+	}
+
+	// Measured from the oldest request, which waited longest
+	const auto& oldest = seekQueue[static_cast<size_t>(scope.startIndex1)];
+	const double waitedSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - oldest.requestTicks);
+	lastSeekLatencyMs = waitedSeconds * 1000.0;
+	++numSeeksApplied;
+
+	moveTo(newPosition);
+}
+
+void DeckSource::applyPendingLoop()
+{
+	if (!loopChanged.exchange(false))
+	{
+		return;
+	}
+
+	const juce::GenericScopedTryLock<juce::SpinLock> sl(loopLock);
+
+	// Try again next block rather than wait for the message thread
+	if (!sl.isLocked())
+	{
+		loopChanged = true;
+		return;
+	}
+
+	// Leaving a loop roll picks up where playback would have been
+	if (rolling)
+	{
+		moveTo(rollPosition);
+	}
+
+	loopStart = juce::jlimit(static_cast<juce::int64>(0), trackLength, pendingLoop.getStart());
+	loopEnd = juce::jlimit(static_cast<juce::int64>(0), trackLength, pendingLoop.getEnd());
+	rolling = pendingRoll && loopEnd > loopStart;
+	rollPosition = position;
+}
+
+void DeckSource::moveTo(double newPosition)
+{
+	// Fade out the old position only if it was audible
+	if (lastPlayGain > 0.0f)
+	{
+		fadePosition = position;
+		fadeRemaining = crossfadeSamples;
+	}
+
+	position = newPosition;
+}
+
+void DeckSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+	const juce::GenericScopedTryLock<juce::SpinLock> sl(trackLock);
+
+	// Silent while the track is being replaced
+	if (!sl.isLocked() || track == nullptr)
+	{
+		bufferToFill.clearActiveBufferRegion();
+		return;
+	}
+
+	applyPendingSeeks();
+	applyPendingLoop();
+
+	// Releasing censor picks up where forward playback would have been
+	const Direction newDirection = direction;
+	bool leftCensor = false;
+
+	if (newDirection != currentDirection)
+	{
+		if (currentDirection == Direction::Censor)
+		{
+			moveTo(censorPosition);
+			leftCensor = true;
+		}
+
+		censorPosition = position;
+		currentDirection = newDirection;
+	}
+
+	const bool isScratching = scratching;
+	const double playingVelocity = playing ? speed.load() : 0.0;
+	const double targetVelocity = isScratching ? scratchVelocity.load()
+		: (currentDirection == Direction::Forward ? playingVelocity : -playingVelocity);
+	const double targetIncrement = trackSampleRate / outputSampleRate * targetVelocity;
+	const double censorIncrement = trackSampleRate / outputSampleRate * playingVelocity;
+	const float playGain = (playing || isScratching) ? 1.0f : 0.0f;
+
+	if (playGain == 0.0f && lastPlayGain == 0.0f)
+	{
+		bufferToFill.clearActiveBufferRegion();
+		track->audioBlockFinished(static_cast<juce::int64>(position), targetIncrement);
+		return;
+	}
+
+	auto& buffer = *bufferToFill.buffer;
+	const int numOutputChannels = buffer.getNumChannels();
+	const int numTrackChannels = track->getNumChannels();
+	const juce::int64 loopLength = loopEnd - loopStart;
+	ChunkCursor cursor, fadeCursor;
+
+	// Only glide between speeds heard, starting playback or resuming after censor is instant
+	if (lastPlayGain == 0.0f || leftCensor)
+	{
+		currentIncrement = targetIncrement;
+	}
+
+	for (int i = 0; i < bufferToFill.numSamples; ++i)
+	{
+		currentIncrement += (targetIncrement - currentIncrement) * incrementSmoothing;
+		const double increment = currentIncrement;
+
+		// Wrap at the loop seam in either direction, crossfading with the audio beyond it
+		if (loopLength > 0)
+		{
+			if (increment >= 0.0 && position >= loopEnd && position < loopEnd + loopLength)
+			{
+				moveTo(position - loopLength);
+			}
+			else if (increment < 0.0 && position < loopStart && position >= loopStart - loopLength)
+			{
+				moveTo(position + loopLength);
+			}
+		}
+
+		if (position >= trackLength || position < 0.0)
+		{
+			if (looping && trackLength > 0)
+			{
+				position += position < 0.0 ? trackLength : -trackLength;
+			}
+			else if (isScratching)
+			{
+				// The jog wheel can hold the playhead at either end
+				position = juce::jlimit(0.0, static_cast<double>(trackLength), position);
+			}
+			else
+			{
+				// End of the track, or its start when playing backwards
+				position = juce::jlimit(0.0, static_cast<double>(trackLength), position);
+				playing = false;
+				buffer.clear(bufferToFill.startSample + i, bufferToFill.numSamples - i);
+				break;
+			}
+		}
+
+		const float fadeGain = fadeRemaining > 0 ? static_cast<float>(fadeRemaining) / crossfadeSamples : 0.0f;
+
+		for (int channel = 0; channel < numOutputChannels; ++channel)
+		{
+			const int trackChannel = juce::jmin(channel, numTrackChannels - 1);
+			float sample = getInterpolatedSample(cursor, position, trackChannel);
+
+			if (fadeRemaining > 0)
+			{
+				sample = sample * (1.0f - fadeGain) + getInterpolatedSample(fadeCursor, fadePosition, trackChannel) * fadeGain;
+			}
+
+			buffer.setSample(channel, bufferToFill.startSample + i, sample);
+		}
+
+		position += increment;
+		rollPosition += increment;
+		censorPosition += censorIncrement;
+
+		if (fadeRemaining > 0)
+		{
+			fadePosition += increment;
+			--fadeRemaining;
+		}
+	}
+
+	// Fade in or out when playback starts or stops
+	buffer.applyGainRamp(bufferToFill.startSample, bufferToFill.numSamples, lastPlayGain, playGain);
+	lastPlayGain = playGain;
+
+	publishedPosition = juce::jlimit(static_cast<juce::int64>(0), trackLength, static_cast<juce::int64>(position));
+	track->audioBlockFinished(publishedPosition, currentIncrement);
+}
@@ -0,0 +1,334 @@
+/*
+  ==============================================================================
+
+	DeckSource.h
+	Created: 20 Oct 2026 11:48:02am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include "TrackCache.h"
+
+/**
+ * DeckSource class plays a deck's audio track from its TrackCache.
+ *
+ * It replaces the transport and resampling sources: the playhead is kept
+ * in source samples and advanced by the speed ratio and the file to device
+ * sample rate ratio, with cubic interpolation between source samples.
+ *
+ * Seeks requested by the message thread are queued and applied by the audio
+ * thread at the start of the next block, crossfading from the old position
+ * to the new one so they do not click. Relative seeks are resolved against
+ * the playhead the audio thread actually has, not the last one published.
+ * Loops wrap at the exact sample they end on, with the same crossfade
+ * across the seam.
+ *
+ * Reverse plays the track backwards at the playback speed. Censor does the
+ * same while the playhead keeps running forwards underneath, and playback
+ * carries on from there when it is released.
+ *
+ * While scratching, the playhead moves at a velocity set from the jog wheel,
+ * backwards as well as forwards, instead of the playback speed. Changes of
+ * speed glide over a few milliseconds so coarse jog updates play smoothly.
+ */
+class DeckSource : public juce::AudioSource
+{
+public:
+	/**
+	 * Constructor for the DeckSource class.
+	 */
+	DeckSource();
+
+	/**
+	 * Destructor for the DeckSource class.
+	 */
+	~DeckSource() override;
+
+	/**
+	 * Prepare the deck ready for playing.
+	 *
+	 * @param samplesPerBlockExpected	The expected samples number per block.
+	 * @param sampleRate				The audio sample rate.
+	 */
+	void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+
+	/**
+	 * Renders the next block of the audio track.
+	 *
+	 * @param bufferToFill Takes in information about the buffer to be filled.
+	 */
+	void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+	/**
+	 * Release any audio resources.
+	 */
+	void releaseResources() override;
+
+	/**
+	 * Replaces the audio track. Playback stops and the playhead returns to the start.
+	 *
+	 * @param newTrack	Cache of the new audio track, or nullptr to unload.
+	 */
+	void setTrack(std::unique_ptr<TrackCache> newTrack);
+
+	/**
+	 * Returns the cache of the loaded audio track, for pinning regions.
+	 * Only valid on the message thread until the next setTrack.
+	 *
+	 * @return The cache, or nullptr if no track is loaded.
+	 */
+	TrackCache* getTrack() const;
+
+	/**
+	 * Starts playback.
+	 */
+	void start();
+
+	/**
+	 * Stops playback, keeping the playhead where it is.
+	 */
+	void stop();
+
+	/**
+	 * Returns true if playing.
+	 *
+	 * @return True if playing.
+	 */
+	bool isPlaying() const;
+
+	/**
+	 * Sets the playback speed ratio.
+	 *
+	 * @param ratio The playback speed ratio to set.
+	 */
+	void setSpeed(double ratio);
+
+	/**
+	 * Direction of playback.
+	 */
+	enum class Direction { Forward, Reverse, Censor };
+
+	/**
+	 * Sets the direction of playback from the next block.
+	 *
+	 * @param newDirection	Forward, Reverse, or Censor to reverse until set back to Forward.
+	 */
+	void setDirection(Direction newDirection);
+
+	/**
+	 * Starts or stops scratching. While scratching the deck is audible even if
+	 * stopped, and moves at the scratch velocity instead of the playback speed.
+	 *
+	 * @param shouldScratch		True while the jog wheel is held.
+	 */
+	void setScratching(bool shouldScratch);
+
+	/**
+	 * Sets the scratch velocity.
+	 *
+	 * @param velocity	Speed relative to normal playback, negative to play backwards.
+	 */
+	void setScratchVelocity(double velocity);
+
+	/**
+	 * Enables or disables starting over from the beginning at the end of the track.
+	 *
+	 * @param shouldLoop True to loop the whole track.
+	 */
+	void setLooping(bool shouldLoop);
+
+	/**
+	 * Sets the loop played from the start of the next block.
+	 * A loop roll keeps the playhead running silently underneath the loop,
+	 * and playback carries on from there when the loop is cleared.
+	 *
+	 * @param loop		Source sample range to repeat, or an empty range to leave the loop.
+	 * @param roll		True for a loop roll.
+	 */
+	void setLoop(juce::Range<juce::int64> loop, bool roll);
+
+	/**
+	 * Moves the playhead at the start of the next block, with a short crossfade.
+	 *
+	 * @param sourceSample	The new playhead in source samples.
+	 */
+	void jumpTo(juce::int64 sourceSample);
+
+	/**
+	 * Moves the playhead by an offset at the start of the next block, with a
+	 * short crossfade. The result is kept within the track.
+	 *
+	 * @param numSourceSamples	The offset in source samples, negative to move back.
+	 */
+	void seekBy(juce::int64 numSourceSamples);
+
+	/**
+	 * Returns how long the last seek waited for the audio thread.
+	 *
+	 * @return The time from the request to the block it was applied in, in milliseconds.
+	 */
+	double getLastSeekLatencyMs() const;
+
+	/**
+	 * Returns how many blocks have applied queued seeks, so the message
+	 * thread can tell when the seek latency has been measured again.
+	 *
+	 * @return The count of blocks that applied seeks.
+	 */
+	juce::uint32 getNumSeeksApplied() const;
+
+	/**
+	 * Returns the playhead as of the last rendered block.
+	 *
+	 * @return The playhead in source samples.
+	 */
+	juce::int64 getPosition() const;
+
+	/**
+	 * Returns the audio track's length.
+	 *
+	 * @return The length in source samples, or 0 if no track is loaded.
+	 */
+	juce::int64 getLengthInSamples() const;
+
+	/**
+	 * Returns the audio track's sample rate.
+	 *
+	 * @return The file's sample rate, or 0 if no track is loaded.
+	 */
+	double getSourceSampleRate() const;
+
+private:
+	/**
+	 * Chunk being read by a playhead, looked up again when the playhead leaves it.
+	 */
+	struct ChunkCursor
+	{
+		int chunkIndex = -1;
+		const float* channels[2] = { nullptr, nullptr };
+	};
+
+	/**
+	 * Returns one source sample, or 0 if outside the track or not cached yet.
+	 */
+	float getSourceSample(ChunkCursor& cursor, juce::int64 index, int channel) const;
+
+	/**
+	 * Returns the source interpolated at a fractional position.
+	 */
+	float getInterpolatedSample(ChunkCursor& cursor, double sourcePosition, int channel) const;
+
+	/**
+	 * Seek request queued by the message thread.
+	 */
+	struct SeekRequest
+	{
+		juce::int64 target = 0;
+		bool relative = false;
+		juce::int64 requestTicks = 0;
+	};
+
+	/**
+	 * Queues a seek for the audio thread.
+	 */
+	void pushSeek(const SeekRequest& request);
+
+	/**
+	 * Applies the seeks queued since the last block, in order.
+	 */
+	void applyPendingSeeks();
+
+	/**
+	 * Takes the loop set by the message thread, if it changed.
+	 */
+	void applyPendingLoop();
+
+	/**
+	 * Crossfades from the current playhead to a new one.
+	 */
+	void moveTo(double newPosition);
+
+	/**
+	 * Guards the track against being replaced while the audio thread reads it.
+	 */
+	juce::SpinLock trackLock;
+	std::unique_ptr<TrackCache> track;
+	juce::int64 trackLength = 0;
+	double trackSampleRate = 0.0;
+
+	/**
+	 * Controls set by the message thread.
+	 */
+	std::atomic<bool> playing{ false };
+	std::atomic<bool> looping{ false };
+	std::atomic<double> speed{ 1.0 };
+	std::atomic<bool> scratching{ false };
+	std::atomic<Direction> direction{ Direction::Forward };
+	std::atomic<double> scratchVelocity{ 0.0 };
+
+	/**
+	 * Seeks waiting for the audio thread.
+	 */
+	static constexpr int seekQueueSize = 32;
+	juce::AbstractFifo seekFifo{ seekQueueSize };
+	std::array<SeekRequest, seekQueueSize> seekQueue;
+	std::atomic<double> lastSeekLatencyMs{ 0.0 };
+	std::atomic<juce::uint32> numSeeksApplied{ 0 };
+
+	/**
+	 * Loop waiting to be picked up by the audio thread.
+	 */
+	juce::SpinLock loopLock;
+	juce::Range<juce::int64> pendingLoop;
+	bool pendingRoll = false;
+	std::atomic<bool> loopChanged{ false };
+
+	/**
+	 * Direction being played and, while censoring, the forward playhead underneath.
+	 */
+	Direction currentDirection = Direction::Forward;
+	double censorPosition = 0.0;
+
+	/**
+	 * Loop being played and, during a loop roll, the playhead underneath it.
+	 */
+	juce::int64 loopStart = 0;
+	juce::int64 loopEnd = 0;
+	bool rolling = false;
+	double rollPosition = 0.0;
+
+	/**
+	 * Playhead in source samples, only touched by the audio thread.
+	 */
+	double position = 0.0;
+	std::atomic<juce::int64> publishedPosition{ 0 };
+
+	/**
+	 * Source samples advanced per output sample, gliding to the target speed.
+	 */
+	double currentIncrement = 0.0;
+	double incrementSmoothing = 1.0;
+
+	/**
+	 * Old playhead faded out after a jump.
+	 */
+	double fadePosition = 0.0;
+	int fadeRemaining = 0;
+	int crossfadeSamples = 256;
+
+	/**
+	 * Play state of the last block, ramped from to avoid clicks.
+	 */
+	float lastPlayGain = 0.0f;
+
+	double outputSampleRate = 44100.0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckSource)
+};
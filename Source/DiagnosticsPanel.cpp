@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+	DiagnosticsPanel.cpp
+	Created: 24 Oct 2026 6:05:44pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "DiagnosticsPanel.h"
+#include <cmath>
+
+DiagnosticsPanel::DiagnosticsPanel(CallbackProfiler& _profiler, juce::AudioDeviceManager& _deviceManager)
+	: profiler(_profiler),
+	deviceManager(_deviceManager)
+{
+	for (auto* button : { &resetButton, &exportButton })
+	{
+		addAndMakeVisible(button);
+		button->addListener(this);
+		button->setColour(juce::TextButton::buttonColourId, juce::Colours::transparentBlack);
+		button->setColour(juce::TextButton::textColourOffId, juce::Colours::cyan);
+		button->setMouseCursor(juce::MouseCursor::PointingHandCursor);
+	}
+
+	resetButton.setTooltip("Clear the statistics");
+	exportButton.setTooltip("Save the statistics as CSV");
+}
+
+DiagnosticsPanel::~DiagnosticsPanel()
+{
+	stopTimer();
+}
+
+void DiagnosticsPanel::paint(juce::Graphics& g)
+{
+	g.fillAll(juce::Colours::black.withAlpha(0.9f));
+	g.setColour(juce::Colours::cyan);
+	g.drawRect(getLocalBounds(), 1);
+
+	const float lineH = getHeight() * 0.07f;
+	const int margin = static_cast<int>(lineH * 0.5f);
+	g.setFont(customDesign.getSelectedFont().withHeight(lineH * 0.8f));
+
+	const int xRuns = getDeviceXRuns();
+	const juce::StringArray lines{
+		"CALLBACK  MEAN " + juce::String(snapshot.meanMilliseconds, 2)
+			+ " MS  P99 " + juce::String(snapshot.getPercentileMilliseconds(99.0), 2)
+			+ " MS  MAX " + juce::String(snapshot.maxMilliseconds, 2)
+			+ " MS  OF " + juce::String(snapshot.blockMilliseconds, 2) + " MS BLOCK",
+		"DEADLINE MISSES " + juce::String(snapshot.numDeadlineMisses)
+			+ " OF " + juce::String(snapshot.numCallbacks)
+			+ "  DEVICE XRUNS " + (xRuns < 0 ? juce::String("?") : juce::String(xRuns)),
+		"DECK A  MEAN " + juce::String(snapshot.deckMeanMilliseconds[0], 2)
+			+ " MS  MAX " + juce::String(snapshot.deckMaxMilliseconds[0], 2) + " MS",
+		"DECK B  MEAN " + juce::String(snapshot.deckMeanMilliseconds[1], 2)
+			+ " MS  MAX " + juce::String(snapshot.deckMaxMilliseconds[1], 2) + " MS" };
+
+	for (int i = 0; i < lines.size(); ++i)
+	{
+		// Deadline misses in red once there are any
+		g.setColour(i == 1 && snapshot.numDeadlineMisses > 0 ? juce::Colours::red : juce::Colours::cyan);
+		g.drawText(lines[i], margin, margin + static_cast<int>(lineH * i), getWidth() - margin * 2,
+			static_cast<int>(lineH), juce::Justification::centredLeft, true);
+	}
+
+	if (exportMessage.isNotEmpty())
+	{
+		g.setColour(juce::Colours::grey);
+		g.drawText(exportMessage, margin, margin + static_cast<int>(lineH * 4), getWidth() - margin * 2,
+			static_cast<int>(lineH), juce::Justification::centredLeft, true);
+	}
+
+	// Histogram up to twice the block period, or the slowest callback if later
+	const auto area = getLocalBounds().reduced(margin).withTrimmedTop(static_cast<int>(lineH * 5.5f)).toFloat();
+	const double blockBins = snapshot.blockMilliseconds * 1000.0 / CallbackProfiler::binMicroseconds;
+	int shownBins = juce::jmax(1, static_cast<int>(std::ceil(blockBins * 2.0)));
+	juce::uint32 maxCount = 0;
+
+	for (int bin = 0; bin < CallbackProfiler::numBins; ++bin)
+	{
+		const auto count = snapshot.histogram[static_cast<size_t>(bin)];
+
+		if (count > 0)
+		{
+			shownBins = juce::jmax(shownBins, bin + 1);
+			maxCount = juce::jmax(maxCount, count);
+		}
+	}
+
+	shownBins = juce::jmin(shownBins, CallbackProfiler::numBins);
+
+	if (maxCount > 0 && area.getHeight() > 0.0f)
+	{
+		// Log scale, so a single slow callback still shows
+		const float barW = area.getWidth() / shownBins;
+		const double logMax = std::log1p(static_cast<double>(maxCount));
+
+		for (int bin = 0; bin < shownBins; ++bin)
+		{
+			const auto count = snapshot.histogram[static_cast<size_t>(bin)];
+
+			if (count > 0)
+			{
+				const float barH = static_cast<float>(area.getHeight() * std::log1p(static_cast<double>(count)) / logMax);
+				g.setColour(bin >= blockBins ? juce::Colours::red : juce::Colours::darkcyan);
+				g.fillRect(area.getX() + barW * bin, area.getBottom() - barH, juce::jmax(1.0f, barW - 1.0f), barH);
+			}
+		}
+	}
+
+	// The deadline
+	if (blockBins > 0.0)
+	{
+		const float deadlineX = area.getX() + area.getWidth() * static_cast<float>(blockBins / shownBins);
+		g.setColour(juce::Colours::red);
+		g.drawVerticalLine(static_cast<int>(deadlineX), area.getY(), area.getBottom());
+	}
+}
+
+void DiagnosticsPanel::resized()
+{
+	const float lineH = getHeight() * 0.07f;
+	const float buttonW = lineH * 5.0f;
+	const int margin = static_cast<int>(lineH * 0.5f);
+
+	exportButton.setBounds(getWidth() - margin - buttonW, margin, buttonW, lineH);
+	resetButton.setBounds(getWidth() - margin - buttonW * 2.1f, margin, buttonW, lineH);
+}
+
+void DiagnosticsPanel::buttonClicked(juce::Button* button)
+{
+	if (button == &resetButton)
+	{
+		profiler.reset();
+		exportMessage.clear();
+	}
+	else if (button == &exportButton)
+	{
+		juce::File folder = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("Otodecks Diagnostics");
+		folder.createDirectory();
+
+		juce::File file = folder.getChildFile("Audio Profile " + juce::Time::getCurrentTime().formatted("%Y-%m-%d %H-%M-%S") + ".csv");
+
+		exportMessage = profiler.exportCsv(file, getDeviceXRuns()) ? "SAVED " + file.getFullPathName()
+			: "CANNOT SAVE " + file.getFullPathName();
+
+		DBG("< EXPORT CSV > button was clicked << " << exportMessage << " >>");
+	}
+
+	repaint();
+}
+
+void DiagnosticsPanel::timerCallback()
+{
+	snapshot = profiler.getSnapshot();
+	repaint();
+}
+
+void DiagnosticsPanel::visibilityChanged()
+{
+	if (isVisible())
+	{
+		timerCallback();
+		startTimer(250);
+	}
+	else
+	{
+		stopTimer();
+	}
+}
+
+int DiagnosticsPanel::getDeviceXRuns() const
+{
+	auto* device = deviceManager.getCurrentAudioDevice();
+	return device != nullptr ? device->getXRunCount() : -1;
+}
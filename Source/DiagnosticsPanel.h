@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+	DiagnosticsPanel.h
+	Created: 24 Oct 2026 6:05:44pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CallbackProfiler.h"
+#include "CustomDesign.h"
+
+/**
+ * DiagnosticsPanel class shows the audio callback profiler: callback
+ * times against the block period, deadline misses, the device's own xrun
+ * count, each deck's share and the histogram of callback durations.
+ *
+ * The panel is hidden until Ctrl+Shift+D (Cmd+Shift+D on macOS), and can
+ * save the statistics as CSV to "Otodecks Diagnostics" in the user's
+ * documents folder.
+ */
+class DiagnosticsPanel : public juce::Component,
+	public juce::Button::Listener,
+	public juce::Timer
+{
+public:
+	/**
+	 * Constructor for the DiagnosticsPanel class.
+	 *
+	 * @param _profiler			Reference to the callback profiler.
+	 * @param _deviceManager	Reference to the audio device manager, asked for xruns.
+	 */
+	DiagnosticsPanel(CallbackProfiler& _profiler, juce::AudioDeviceManager& _deviceManager);
+
+	/**
+	 * Destructor for the DiagnosticsPanel class.
+	 */
+	~DiagnosticsPanel() override;
+
+	/**
+	 * Paints the statistics and the histogram.
+	 *
+	 * @param g Graphics context to perform drawing operations.
+	 */
+	void paint(juce::Graphics& g) override;
+
+	/**
+	 * Resizes and positions the buttons.
+	 */
+	void resized() override;
+
+	/**
+	 * Button::Listener
+	 * Resets the statistics or exports them.
+	 *
+	 * @param button	Pointer to the button that was clicked.
+	 */
+	void buttonClicked(juce::Button* button) override;
+
+	/**
+	 * Timer
+	 * Reads the statistics while the panel is shown.
+	 */
+	void timerCallback() override;
+
+	/**
+	 * Starts reading the statistics when shown and stops when hidden.
+	 */
+	void visibilityChanged() override;
+
+private:
+	/**
+	 * Returns the device's xrun count.
+	 *
+	 * @return The count, or -1 if the device does not report it.
+	 */
+	int getDeviceXRuns() const;
+
+	/**
+	 * Reference to the callback profiler and the audio device manager.
+	 */
+	CallbackProfiler& profiler;
+	juce::AudioDeviceManager& deviceManager;
+
+	/**
+	 * Statistics last read.
+	 */
+	CallbackProfiler::Snapshot snapshot;
+
+	juce::TextButton resetButton{ "RESET" };
+	juce::TextButton exportButton{ "EXPORT CSV" };
+
+	/**
+	 * Where the last export was saved, shown under the buttons.
+	 */
+	juce::String exportMessage;
+
+	/**
+	 * Custom design for the text font.
+	 */
+	CustomDesign customDesign;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DiagnosticsPanel)
+};
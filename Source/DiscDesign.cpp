@@ -30,10 +30,11 @@ void DiscDesign::drawRotarySlider(juce::Graphics& g, int x, int y, int width, in
     float sliderPosProportional, float rotaryStartAngle,
     float rotaryEndAngle, juce::Slider& slider)
 {
-    // Set rotary parameters for the slider to be full circle
+    // Set rotary parameters for the slider to be full circle,
+    // turning past the top so the disc can be scratched all the way round
     slider.setRotaryParameters(juce::MathConstants<float>::pi,
         juce::MathConstants<float>::twoPi + juce::MathConstants<float>::pi,
-        true);
+        false);
 
     // Calculation for dimensions and position of slider
     float diameter = juce::jmin(width, height);
@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+	IntegratedLoudness.cpp
+	Created: 23 Oct 2026 10:04:52am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "IntegratedLoudness.h"
+
+// Loudness of a mean square power, as defined by BS.1770
+static double powerToLoudness(double power)
+{
+	return -0.691 + 10.0 * std::log10(power);
+}
+
+IntegratedLoudness::IntegratedLoudness()
+{
+	const auto numBins = static_cast<size_t>((highestLoudness - silence) * binsPerLU) + 1;
+	binCounts.resize(numBins);
+	binPowers.resize(numBins);
+
+	prepare(48000.0);
+}
+
+IntegratedLoudness::~IntegratedLoudness()
+{
+
+}
+
+void IntegratedLoudness::prepare(double sampleRate)
+{
+	kWeighting.prepare(sampleRate);
+	stepLength = juce::jmax(1, juce::roundToInt(sampleRate * 0.1));
+
+	reset();
+}
+
+void IntegratedLoudness::reset()
+{
+	kWeighting.reset();
+	stepPosition = 0;
+	stepSum = 0.0;
+	stepPowers.fill(0.0);
+	numSteps = 0;
+
+	std::fill(binCounts.begin(), binCounts.end(), 0);
+	std::fill(binPowers.begin(), binPowers.end(), 0.0);
+}
+
+void IntegratedLoudness::process(const float* left, const float* right, int numSamples)
+{
+	for (int i = 0; i < numSamples; ++i)
+	{
+		// Channel powers add, mono is counted once
+		const double l = kWeighting.processSample(0, left[i]);
+		stepSum += l * l;
+
+		if (right != nullptr)
+		{
+			const double r = kWeighting.processSample(1, right[i]);
+			stepSum += r * r;
+		}
+
+		if (++stepPosition == stepLength)
+		{
+			stepPowers[static_cast<size_t>(numSteps % 4)] = stepSum / stepLength;
+			stepPosition = 0;
+			stepSum = 0.0;
+
+			// Each step after the fourth finishes a block
+			if (++numSteps >= 4)
+			{
+				addBlock((stepPowers[0] + stepPowers[1] + stepPowers[2] + stepPowers[3]) * 0.25);
+			}
+		}
+	}
+}
+
+void IntegratedLoudness::addBlock(double power)
+{
+	if (power <= 0.0)
+	{
+		return;
+	}
+
+	const int bin = getBin(powerToLoudness(power));
+
+	if (bin >= 0)
+	{
+		++binCounts[static_cast<size_t>(bin)];
+		binPowers[static_cast<size_t>(bin)] += power;
+	}
+}
+
+int IntegratedLoudness::getBin(double loudness)
+{
+	if (loudness < silence)
+	{
+		return -1;
+	}
+
+	// Blocks louder than the top bin can only come from full scale square waves
+	const int highestBin = static_cast<int>((highestLoudness - silence) * binsPerLU);
+	return juce::jmin(highestBin, static_cast<int>((loudness - silence) * binsPerLU));
+}
+
+float IntegratedLoudness::getLoudness() const
+{
+	// Blocks past the absolute gate set the relative gate
+	juce::int64 count = 0;
+	double power = 0.0;
+
+	for (size_t bin = 0; bin < binCounts.size(); ++bin)
+	{
+		count += binCounts[bin];
+		power += binPowers[bin];
+	}
+
+	if (count == 0)
+	{
+		return silence;
+	}
+
+	const int relativeGateBin = getBin(powerToLoudness(power / count) - 10.0);
+
+	// Then only blocks past both gates are averaged
+	count = 0;
+	power = 0.0;
+
+	for (size_t bin = static_cast<size_t>(juce::jmax(0, relativeGateBin)); bin < binCounts.size(); ++bin)
+	{
+		count += binCounts[bin];
+		power += binPowers[bin];
+	}
+
+	return count == 0 ? silence : static_cast<float>(powerToLoudness(power / count));
+}
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+	IntegratedLoudness.h
+	Created: 23 Oct 2026 10:04:52am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+#include "KWeighting.h"
+
+/**
+ * IntegratedLoudness class measures the BS.1770 integrated loudness of a
+ * whole audio track in LUFS, fed in pieces of any size.
+ *
+ * The K-weighted power is measured in 400ms blocks overlapping by 75%.
+ * Blocks under -70 LUFS are gated out, then blocks more than 10 LU under the
+ * loudness of the rest. Rather than keeping every block for the second gate,
+ * the blocks are counted into a histogram of 0.01 LU bins, so the memory
+ * used is the same however long the audio track is.
+ */
+class IntegratedLoudness
+{
+public:
+	/**
+	 * Loudness reported when every block is gated out.
+	 */
+	static constexpr float silence = -70.0f;
+
+	/**
+	 * Constructor for the IntegratedLoudness class.
+	 */
+	IntegratedLoudness();
+
+	/**
+	 * Destructor for the IntegratedLoudness class.
+	 */
+	~IntegratedLoudness();
+
+	/**
+	 * Sets the sample rate and starts a new measurement.
+	 *
+	 * @param sampleRate	The audio sample rate.
+	 */
+	void prepare(double sampleRate);
+
+	/**
+	 * Starts a new measurement.
+	 */
+	void reset();
+
+	/**
+	 * Measures the next piece of audio.
+	 *
+	 * @param left			The left channel, or the only channel.
+	 * @param right			The right channel, or nullptr for mono.
+	 * @param numSamples	Number of samples in each channel.
+	 */
+	void process(const float* left, const float* right, int numSamples);
+
+	/**
+	 * Returns the integrated loudness of the audio measured so far.
+	 *
+	 * @return The loudness in LUFS, or silence if every block was gated out.
+	 */
+	float getLoudness() const;
+
+private:
+	/**
+	 * Counts a finished 400ms block into the histogram.
+	 */
+	void addBlock(double power);
+
+	/**
+	 * Returns the histogram bin of a block loudness, -1 if under the absolute gate.
+	 */
+	static int getBin(double loudness);
+
+	KWeighting kWeighting;
+
+	/**
+	 * Samples in each 100ms step, and the power summed over the current one.
+	 */
+	int stepLength = 4800;
+	int stepPosition = 0;
+	double stepSum = 0.0;
+
+	/**
+	 * Mean power of the last four steps, which make up a block.
+	 */
+	std::array<double, 4> stepPowers{};
+	int numSteps = 0;
+
+	/**
+	 * Number of blocks and their summed power in each bin.
+	 */
+	static constexpr double binsPerLU = 100.0;
+	static constexpr double highestLoudness = 10.0;
+	std::vector<juce::int64> binCounts;
+	std::vector<double> binPowers;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(IntegratedLoudness)
+};
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+	KWeighting.cpp
+	Created: 23 Oct 2026 9:58:13am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "KWeighting.h"
+
+KWeighting::KWeighting()
+{
+	prepare(48000.0);
+}
+
+KWeighting::~KWeighting()
+{
+
+}
+
+void KWeighting::prepare(double sampleRate)
+{
+	// The BS.1770 filters at 48kHz, matched at other rates through their analogue prototypes
+	{
+		const double frequency = 1681.974450955533;
+		const double gainDb = 3.999843853973347;
+		const double q = 0.7071752369554196;
+
+		const double k = std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+		const double vh = std::pow(10.0, gainDb / 20.0);
+		const double vb = std::pow(vh, 0.4996667741545416);
+		const double a0 = 1.0 + k / q + k * k;
+
+		shelf.b0 = (vh + vb * k / q + k * k) / a0;
+		shelf.b1 = 2.0 * (k * k - vh) / a0;
+		shelf.b2 = (vh - vb * k / q + k * k) / a0;
+		shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+		shelf.a2 = (1.0 - k / q + k * k) / a0;
+	}
+
+	{
+		const double frequency = 38.13547087602444;
+		const double q = 0.5003270373238773;
+
+		const double k = std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+		const double a0 = 1.0 + k / q + k * k;
+
+		highpass.b0 = 1.0;
+		highpass.b1 = -2.0;
+		highpass.b2 = 1.0;
+		highpass.a1 = 2.0 * (k * k - 1.0) / a0;
+		highpass.a2 = (1.0 - k / q + k * k) / a0;
+	}
+
+	reset();
+}
+
+void KWeighting::reset()
+{
+	for (auto& state : shelfState)
+	{
+		state.fill(0.0);
+	}
+
+	for (auto& state : highpassState)
+	{
+		state.fill(0.0);
+	}
+}
+
+float KWeighting::processSample(int channel, float input)
+{
+	auto runStage = [](const Coefficients& c, std::array<double, 2>& state, double x)
+		{
+			const double y = c.b0 * x + state[0];
+			state[0] = c.b1 * x - c.a1 * y + state[1];
+			state[1] = c.b2 * x - c.a2 * y;
+			return y;
+		};
+
+	const double shelved = runStage(shelf, shelfState[static_cast<size_t>(channel)], input);
+	return static_cast<float>(runStage(highpass, highpassState[static_cast<size_t>(channel)], shelved));
+}
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+	KWeighting.h
+	Created: 23 Oct 2026 9:58:13am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+/**
+ * KWeighting class is the BS.1770 K-weighting filter loudness is measured
+ * through, for up to two channels: a high shelf for the effect of the head,
+ * then a highpass. Coefficients are worked out for any sample rate.
+ */
+class KWeighting
+{
+public:
+	/**
+	 * Constructor for the KWeighting class.
+	 */
+	KWeighting();
+
+	/**
+	 * Destructor for the KWeighting class.
+	 */
+	~KWeighting();
+
+	/**
+	 * Works out the coefficients for the sample rate and clears the filters.
+	 *
+	 * @param sampleRate	The audio sample rate.
+	 */
+	void prepare(double sampleRate);
+
+	/**
+	 * Clears the filters.
+	 */
+	void reset();
+
+	/**
+	 * Filters one sample.
+	 *
+	 * @param channel	The channel, 0 or 1.
+	 * @param input		The sample.
+	 * @return			The K-weighted sample.
+	 */
+	float processSample(int channel, float input);
+
+private:
+	/**
+	 * Biquad coefficients, normalised so a0 is 1.
+	 */
+	struct Coefficients
+	{
+		double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+	};
+
+	Coefficients shelf, highpass;
+
+	/**
+	 * Transposed direct form II state of each stage and channel.
+	 */
+	std::array<std::array<double, 2>, 2> shelfState{}, highpassState{};
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(KWeighting)
+};
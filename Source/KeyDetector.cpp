@@ -0,0 +1,207 @@
+/*
+  ==============================================================================
+
+	KeyDetector.cpp
+	Created: 23 Oct 2026 4:36:10pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "KeyDetector.h"
+
+// How strongly each pitch class above the tonic belongs to a key, from Krumhansl and Kessler
+static const double majorProfile[12] = { 6.35, 2.23, 3.48, 2.33, 4.38, 4.09, 2.52, 5.19, 2.39, 3.66, 2.29, 2.88 };
+static const double minorProfile[12] = { 6.33, 2.68, 3.52, 5.38, 2.60, 3.53, 2.54, 4.75, 3.98, 2.69, 3.34, 3.17 };
+
+// Lowest and highest frequencies folded into the chroma, C2 to C7
+static constexpr double lowestFrequency = 65.4;
+static constexpr double highestFrequency = 2093.0;
+
+KeyDetector::KeyDetector()
+{
+	prepare(44100.0);
+}
+
+KeyDetector::~KeyDetector()
+{
+
+}
+
+void KeyDetector::prepare(double sampleRate)
+{
+	// About 3Hz a bin, enough to tell semitones apart from C2 up
+	frameSize = juce::nextPowerOfTwo(juce::roundToInt(sampleRate / 3.0));
+	int order = 0;
+	while ((1 << order) < frameSize)
+	{
+		++order;
+	}
+
+	fft = std::make_unique<juce::dsp::FFT>(order);
+	window = std::make_unique<juce::dsp::WindowingFunction<float>>(static_cast<size_t>(frameSize),
+		juce::dsp::WindowingFunction<float>::hann, false);
+	frame.assign(static_cast<size_t>(frameSize), 0.0f);
+	fftData.assign(static_cast<size_t>(frameSize) * 2, 0.0f);
+
+	// Each bin is given to the nearest semitone
+	binPitchClasses.assign(static_cast<size_t>(frameSize / 2 + 1), -1);
+
+	for (int bin = 1; bin <= frameSize / 2; ++bin)
+	{
+		const double frequency = bin * sampleRate / frameSize;
+
+		if (frequency >= lowestFrequency && frequency <= highestFrequency)
+		{
+			const int midiNote = juce::roundToInt(69.0 + 12.0 * std::log2(frequency / 440.0));
+			binPitchClasses[static_cast<size_t>(bin)] = midiNote % 12;
+		}
+	}
+
+	reset();
+}
+
+void KeyDetector::reset()
+{
+	std::fill(frame.begin(), frame.end(), 0.0f);
+	framePosition = 0;
+	chroma.fill(0.0);
+}
+
+void KeyDetector::process(const float* left, const float* right, int numSamples)
+{
+	for (int i = 0; i < numSamples; ++i)
+	{
+		frame[static_cast<size_t>(framePosition)] = right != nullptr ? 0.5f * (left[i] + right[i]) : left[i];
+
+		if (++framePosition == frameSize)
+		{
+			analyseFrame();
+		}
+	}
+}
+
+void KeyDetector::analyseFrame()
+{
+	std::copy(frame.begin(), frame.end(), fftData.begin());
+	window->multiplyWithWindowingTable(fftData.data(), static_cast<size_t>(frameSize));
+	fft->performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+	std::array<double, 12> frameChroma{};
+	double frameTotal = 0.0;
+
+	for (size_t bin = 0; bin < binPitchClasses.size(); ++bin)
+	{
+		const int pitchClass = binPitchClasses[bin];
+
+		if (pitchClass >= 0)
+		{
+			frameChroma[static_cast<size_t>(pitchClass)] += fftData[bin];
+			frameTotal += fftData[bin];
+		}
+	}
+
+	// Every frame with sound counts the same, so loud passages do not outweigh the rest
+	if (frameTotal > 1.0e-3 * frameSize)
+	{
+		for (size_t pitchClass = 0; pitchClass < chroma.size(); ++pitchClass)
+		{
+			chroma[pitchClass] += frameChroma[pitchClass] / frameTotal;
+		}
+	}
+
+	// The next frame starts halfway through this one
+	const int hopSize = frameSize / 2;
+	std::copy(frame.begin() + hopSize, frame.end(), frame.begin());
+	framePosition = frameSize - hopSize;
+}
+
+int KeyDetector::getKey() const
+{
+	double chromaMean = 0.0;
+	for (double value : chroma)
+	{
+		chromaMean += value / 12.0;
+	}
+
+	if (chromaMean <= 0.0)
+	{
+		return unknownKey;
+	}
+
+	// Pick the key whose profile correlates best with the chroma
+	int bestKey = unknownKey;
+	double bestCorrelation = -2.0;
+
+	for (int key = 0; key < numKeys; ++key)
+	{
+		const double* profile = key < 12 ? majorProfile : minorProfile;
+		const int tonic = key % 12;
+
+		double profileMean = 0.0;
+		for (int i = 0; i < 12; ++i)
+		{
+			profileMean += profile[i] / 12.0;
+		}
+
+		double covariance = 0.0, chromaVariance = 0.0, profileVariance = 0.0;
+
+		for (int pitchClass = 0; pitchClass < 12; ++pitchClass)
+		{
+			const double c = chroma[static_cast<size_t>(pitchClass)] - chromaMean;
+			const double p = profile[(pitchClass - tonic + 12) % 12] - profileMean;
+			covariance += c * p;
+			chromaVariance += c * c;
+			profileVariance += p * p;
+		}
+
+		const double correlation = chromaVariance > 0.0 ? covariance / std::sqrt(chromaVariance * profileVariance) : 0.0;
+
+		if (correlation > bestCorrelation)
+		{
+			bestCorrelation = correlation;
+			bestKey = key;
+		}
+	}
+
+	return bestKey;
+}
+
+int KeyDetector::getCamelotNumber(int key)
+{
+	// A fifth up is one step round the wheel; C major is 8B and A minor 8A
+	const int tonic = key % 12;
+	const int number = (7 * tonic + (key < 12 ? 8 : 5)) % 12;
+	return number == 0 ? 12 : number;
+}
+
+juce::String KeyDetector::getCamelotCode(int key)
+{
+	if (!juce::isPositiveAndBelow(key, numKeys))
+	{
+		return "...";
+	}
+	return juce::String(getCamelotNumber(key)) + (key < 12 ? "B" : "A");
+}
+
+bool KeyDetector::isHarmonicMatch(int key, int otherKey)
+{
+	if (!juce::isPositiveAndBelow(key, numKeys) || !juce::isPositiveAndBelow(otherKey, numKeys))
+	{
+		return false;
+	}
+
+	const int number = getCamelotNumber(key);
+	const int otherNumber = getCamelotNumber(otherKey);
+	const bool sameMode = (key < 12) == (otherKey < 12);
+
+	// Relative major or minor shares the number
+	if (number == otherNumber)
+	{
+		return true;
+	}
+
+	// Otherwise one step round the wheel in the same mode
+	const int steps = (otherNumber - number + 12) % 12;
+	return sameMode && (steps == 1 || steps == 11);
+}
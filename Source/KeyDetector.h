@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+	KeyDetector.h
+	Created: 23 Oct 2026 4:36:10pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <memory>
+#include <vector>
+
+/**
+ * KeyDetector class estimates the musical key of a whole audio track, fed
+ * in pieces of any size, and names keys with their Camelot codes.
+ *
+ * The audio is split into half overlapping frames of about a third of a
+ * second, and the spectrum of each frame is folded into a chroma of the
+ * twelve pitch classes. The chroma summed over the audio track is compared
+ * with the Krumhansl-Kessler profile of every major and minor key, and the
+ * closest key is taken.
+ *
+ * Keys are numbered from C major to B major, then C minor to B minor.
+ */
+class KeyDetector
+{
+public:
+	/**
+	 * Key reported before a key is detected, or for audio with no pitch.
+	 */
+	static constexpr int unknownKey = -1;
+
+	/**
+	 * Number of keys, major then minor.
+	 */
+	static constexpr int numKeys = 24;
+
+	/**
+	 * Constructor for the KeyDetector class.
+	 */
+	KeyDetector();
+
+	/**
+	 * Destructor for the KeyDetector class.
+	 */
+	~KeyDetector();
+
+	/**
+	 * Allocates the frames for the sample rate and starts a new detection.
+	 *
+	 * @param sampleRate	The audio sample rate.
+	 */
+	void prepare(double sampleRate);
+
+	/**
+	 * Starts a new detection.
+	 */
+	void reset();
+
+	/**
+	 * Analyses the next piece of audio.
+	 *
+	 * @param left			The left channel, or the only channel.
+	 * @param right			The right channel, or nullptr for mono.
+	 * @param numSamples	Number of samples in each channel.
+	 */
+	void process(const float* left, const float* right, int numSamples);
+
+	/**
+	 * Returns the key of the audio analysed so far.
+	 *
+	 * @return The key below numKeys, or unknownKey.
+	 */
+	int getKey() const;
+
+	/**
+	 * Returns the Camelot code of a key, e.g. "8B" for C major.
+	 *
+	 * @param key	The key, or unknownKey.
+	 * @return		The Camelot code, or "..." if unknown.
+	 */
+	static juce::String getCamelotCode(int key);
+
+	/**
+	 * Checks if two keys mix harmonically: the same key, its relative
+	 * major or minor, or a fifth up or down.
+	 *
+	 * @param key			The key playing.
+	 * @param otherKey		The key to mix in.
+	 * @return				True if the keys are next to each other on the Camelot wheel.
+	 */
+	static bool isHarmonicMatch(int key, int otherKey);
+
+	/**
+	 * Returns a key's number on the Camelot wheel.
+	 *
+	 * @param key	The key, below numKeys.
+	 * @return		The number from 1 to 12.
+	 */
+	static int getCamelotNumber(int key);
+
+private:
+	/**
+	 * Adds the chroma of the full frame and keeps its second half for the next one.
+	 */
+	void analyseFrame();
+
+	/**
+	 * Transform and window of one frame.
+	 */
+	std::unique_ptr<juce::dsp::FFT> fft;
+	std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
+
+	/**
+	 * Mono samples of the frame being filled, and the transform's work space.
+	 */
+	std::vector<float> frame;
+	std::vector<float> fftData;
+	int frameSize = 0;
+	int framePosition = 0;
+
+	/**
+	 * Pitch class of each spectrum bin, or -1 for bins outside the pitched range.
+	 */
+	std::vector<int> binPitchClasses;
+
+	/**
+	 * Chroma summed over every frame with sound in it.
+	 */
+	std::array<double, 12> chroma{};
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(KeyDetector)
+};
@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+
+	LevelMeter.cpp
+	Created: 23 Oct 2026 10:26:51am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "LevelMeter.h"
+
+LevelMeter::LevelMeter()
+{
+	prepare(sampleRate);
+}
+
+LevelMeter::~LevelMeter()
+{
+
+}
+
+void LevelMeter::prepare(double _sampleRate)
+{
+	sampleRate = _sampleRate;
+
+	kWeighting.prepare(sampleRate);
+	loudnessPieceSize = juce::jmax(1, juce::roundToInt(sampleRate * 0.1));
+	loudnessPieces.assign(30, 0.0);
+	loudnessPieceIndex = 0;
+	loudnessSquares = 0.0;
+	loudnessSamples = 0;
+
+	blockPeak = 0.0f;
+	blockSquares = 0.0;
+	blockSamples = 0;
+	peak = 0.0f;
+	meanSquare = 0.0;
+
+	blockTruePeak = 0.0f;
+	blockGainReductionDb = 0.0f;
+	truePeak = 0.0f;
+	gainReductionDb = 0.0f;
+}
+
+void LevelMeter::process(const float* left, const float* right, int numSamples)
+{
+	numChannels = right != nullptr ? 2 : 1;
+	const float* channels[2] = { left, right };
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		double weightedSquares = 0.0;
+
+		for (int channel = 0; channel < numChannels; ++channel)
+		{
+			const float sample = channels[channel][i];
+			blockPeak = juce::jmax(blockPeak, std::abs(sample));
+			blockSquares += static_cast<double>(sample) * sample;
+
+			const float weighted = kWeighting.processSample(channel, sample);
+			weightedSquares += static_cast<double>(weighted) * weighted;
+		}
+
+		loudnessSquares += weightedSquares;
+
+		if (++loudnessSamples == loudnessPieceSize)
+		{
+			loudnessPieces[static_cast<size_t>(loudnessPieceIndex)] = loudnessSquares;
+			loudnessPieceIndex = (loudnessPieceIndex + 1) % static_cast<int>(loudnessPieces.size());
+			loudnessSquares = 0.0;
+			loudnessSamples = 0;
+		}
+	}
+
+	blockSamples += numSamples;
+}
+
+void LevelMeter::addLimiterLevels(float truePeakDb, float _gainReductionDb)
+{
+	blockTruePeak = juce::jmax(blockTruePeak, juce::Decibels::decibelsToGain(truePeakDb, -100.0f));
+	blockGainReductionDb = juce::jmax(blockGainReductionDb, _gainReductionDb);
+}
+
+void LevelMeter::publish()
+{
+	if (blockSamples == 0)
+	{
+		return;
+	}
+
+	const double blockSeconds = blockSamples / sampleRate;
+
+	// The peak falls back at 20dB a second, the RMS follows over 300ms
+	peak = juce::jmax(blockPeak, peak * static_cast<float>(std::pow(10.0, -blockSeconds)));
+	const double blockMeanSquare = blockSquares / (static_cast<double>(blockSamples) * numChannels);
+	meanSquare += (blockMeanSquare - meanSquare) * (1.0 - std::exp(-blockSeconds / 0.3));
+
+	// The limiter's levels fall back at 20dB a second too
+	truePeak = juce::jmax(blockTruePeak, truePeak * static_cast<float>(std::pow(10.0, -blockSeconds)));
+	gainReductionDb = juce::jmax(blockGainReductionDb, gainReductionDb - static_cast<float>(blockSeconds * 20.0));
+
+	double windowSquares = 0.0;
+	for (double pieceSquares : loudnessPieces)
+	{
+		windowSquares += pieceSquares;
+	}
+
+	auto& reading = readings.getWriteValue();
+	reading.peakDb = juce::Decibels::gainToDecibels(peak, -100.0f);
+	reading.rmsDb = juce::Decibels::gainToDecibels(static_cast<float>(std::sqrt(meanSquare)), -100.0f);
+	reading.truePeakDb = juce::Decibels::gainToDecibels(truePeak, -100.0f);
+	reading.gainReductionDb = gainReductionDb;
+
+	const double windowMeanSquare = windowSquares / (static_cast<double>(loudnessPieceSize) * loudnessPieces.size());
+	reading.shortTermLufs = windowMeanSquare > 0.0
+		? juce::jmax(-100.0f, static_cast<float>(-0.691 + 10.0 * std::log10(windowMeanSquare)))
+		: -100.0f;
+
+	readings.publish();
+
+	blockPeak = 0.0f;
+	blockSquares = 0.0;
+	blockSamples = 0;
+	blockTruePeak = 0.0f;
+	blockGainReductionDb = 0.0f;
+}
+
+LevelMeter::Reading LevelMeter::getReading()
+{
+	return readings.read();
+}
@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+	LevelMeter.h
+	Created: 23 Oct 2026 10:26:51am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "KWeighting.h"
+#include "TripleBuffer.h"
+
+/**
+ * LevelMeter class measures the level of a stereo signal on the audio thread
+ * and publishes it to the message thread without locks.
+ *
+ * Each audio block updates the peak, falling back at 20dB a second, the RMS
+ * averaged over 300ms, and the short-term loudness over the last 3 seconds
+ * in LUFS. Readings are published through a triple buffer, so the audio
+ * thread never waits and a reader at any rate sees the latest levels.
+ *
+ * A meter after a limiter can also show the true peak going into it and
+ * the gain reduction it applied, held and released at 20dB a second so a
+ * slow reader still sees short overs.
+ */
+class LevelMeter
+{
+public:
+	/**
+	 * Levels published after each audio block.
+	 */
+	struct Reading
+	{
+		float peakDb = -100.0f;
+		float rmsDb = -100.0f;
+		float shortTermLufs = -100.0f;
+		float truePeakDb = -100.0f;
+		float gainReductionDb = 0.0f;
+	};
+
+	/**
+	 * Constructor for the LevelMeter class.
+	 */
+	LevelMeter();
+
+	/**
+	 * Destructor for the LevelMeter class.
+	 */
+	~LevelMeter();
+
+	/**
+	 * Allocates the loudness window for the sample rate and clears the levels.
+	 *
+	 * @param sampleRate	The audio sample rate.
+	 */
+	void prepare(double sampleRate);
+
+	/**
+	 * Measures part of an audio block. Called on the audio thread.
+	 *
+	 * @param left			The left channel.
+	 * @param right			The right channel, or nullptr for mono.
+	 * @param numSamples	Number of samples.
+	 */
+	void process(const float* left, const float* right, int numSamples);
+
+	/**
+	 * Adds the levels of a limiter the measured audio went through.
+	 * Called on the audio thread before publish.
+	 *
+	 * @param truePeakDb		The true peak going into the limiter, in decibels.
+	 * @param gainReductionDb	The most gain reduction applied, in decibels, 0 or above.
+	 */
+	void addLimiterLevels(float truePeakDb, float gainReductionDb);
+
+	/**
+	 * Publishes the levels of the audio measured since the last call.
+	 * Called on the audio thread at the end of each block.
+	 */
+	void publish();
+
+	/**
+	 * Returns the latest levels. Called on one reader thread only.
+	 *
+	 * @return The levels as of the last published block.
+	 */
+	Reading getReading();
+
+private:
+	/**
+	 * Filter loudness is measured through.
+	 */
+	KWeighting kWeighting;
+
+	/**
+	 * Levels passed to the reader.
+	 */
+	TripleBuffer<Reading> readings;
+
+	/**
+	 * Peak and sum of squares of the block being measured.
+	 */
+	float blockPeak = 0.0f;
+	double blockSquares = 0.0;
+	int blockSamples = 0;
+	int numChannels = 2;
+
+	/**
+	 * Peak and mean square with their ballistics applied.
+	 */
+	float peak = 0.0f;
+	double meanSquare = 0.0;
+
+	/**
+	 * Limiter levels of the block being measured, and with their ballistics applied.
+	 */
+	float blockTruePeak = 0.0f;
+	float blockGainReductionDb = 0.0f;
+	float truePeak = 0.0f;
+	float gainReductionDb = 0.0f;
+
+	/**
+	 * K-weighted sums of squares of the last 3 seconds in 100ms pieces, and
+	 * the piece being filled.
+	 */
+	std::vector<double> loudnessPieces;
+	int loudnessPieceIndex = 0;
+	double loudnessSquares = 0.0;
+	int loudnessSamples = 0;
+	int loudnessPieceSize = 4800;
+
+	double sampleRate = 48000.0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LevelMeter)
+};
@@ -0,0 +1,294 @@
+/*
+  ==============================================================================
+
+	LibraryWatcher.cpp
+	Created: 18 Oct 2026 5:02:17pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "LibraryWatcher.h"
+
+#if JUCE_LINUX
+ #include <poll.h>
+ #include <sys/inotify.h>
+ #include <unistd.h>
+#endif
+
+LibraryWatcher::LibraryWatcher()
+	: juce::Thread("Library Watcher")
+{
+   #if JUCE_LINUX
+	inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+	if (inotifyFd >= 0)
+	{
+		startThread();
+	}
+	else
+	{
+		DBG("LibraryWatcher cannot create an inotify instance");
+	}
+   #endif
+}
+
+LibraryWatcher::~LibraryWatcher()
+{
+	stopThread(2000);
+	cancelPendingUpdate();
+
+   #if JUCE_LINUX
+	if (inotifyFd >= 0)
+	{
+		close(inotifyFd);
+	}
+   #endif
+}
+
+void LibraryWatcher::watchFolder(const juce::File& folder, bool includeSubfolders)
+{
+	if (inotifyFd < 0 || !folder.isDirectory())
+	{
+		return;
+	}
+
+	const juce::ScopedLock sl(watchLock);
+	addWatch(folder, includeSubfolders);
+}
+
+void LibraryWatcher::addWatch(const juce::File& folder, bool includeSubfolders)
+{
+   #if JUCE_LINUX
+	const juce::uint32 mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO
+		| IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+	int watchDescriptor = inotify_add_watch(inotifyFd, folder.getFullPathName().toRawUTF8(), mask);
+
+	if (watchDescriptor < 0)
+	{
+		DBG("LibraryWatcher cannot watch " << folder.getFullPathName());
+		return;
+	}
+
+	// inotify returns the same descriptor for a folder that is already watched
+	auto& watchedFolder = watchedFolders[watchDescriptor];
+	bool alreadyRecursive = watchedFolder.second;
+	watchedFolder = { folder, alreadyRecursive || includeSubfolders };
+
+	if (includeSubfolders && !alreadyRecursive)
+	{
+		for (const auto& subfolder : folder.findChildFiles(juce::File::findDirectories, false))
+		{
+			addWatch(subfolder, true);
+		}
+	}
+   #else
+	juce::ignoreUnused(folder, includeSubfolders);
+   #endif
+}
+
+void LibraryWatcher::run()
+{
+   #if JUCE_LINUX
+	alignas(inotify_event) char buffer[16384];
+
+	while (!threadShouldExit())
+	{
+		pollfd pollDescriptor{ inotifyFd, POLLIN, 0 };
+
+		if (poll(&pollDescriptor, 1, 100) > 0 && (pollDescriptor.revents & POLLIN) != 0)
+		{
+			ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+
+			for (char* position = buffer; length > 0 && position < buffer + length;)
+			{
+				auto* event = reinterpret_cast<inotify_event*>(position);
+				juce::String name = event->len > 0 ? juce::String::fromUTF8(event->name) : juce::String();
+
+				handleEvent(event->wd, event->mask, event->cookie, name);
+
+				position += sizeof(inotify_event) + event->len;
+			}
+		}
+
+		// Deliver the batch once the burst has settled
+		if (firstPendingEventTime != 0)
+		{
+			const juce::uint32 now = juce::Time::getMillisecondCounter();
+
+			if (now - lastPendingEventTime >= quietPeriodMs || now - firstPendingEventTime >= maxBatchDelayMs)
+			{
+				flushPendingChanges();
+			}
+		}
+	}
+   #endif
+}
+
+void LibraryWatcher::handleEvent(int watchDescriptor, juce::uint32 mask, juce::uint32 cookie, const juce::String& name)
+{
+   #if JUCE_LINUX
+	juce::File folder;
+	bool includeSubfolders = false;
+
+	{
+		const juce::ScopedLock sl(watchLock);
+		auto watchedFolder = watchedFolders.find(watchDescriptor);
+
+		if (watchedFolder == watchedFolders.end())
+		{
+			return;
+		}
+
+		// The folder itself was removed, its watch is gone
+		if ((mask & IN_IGNORED) != 0)
+		{
+			watchedFolders.erase(watchedFolder);
+			return;
+		}
+
+		folder = watchedFolder->second.first;
+		includeSubfolders = watchedFolder->second.second;
+	}
+
+	const bool folderGone = (mask & (IN_DELETE_SELF | IN_MOVE_SELF)) != 0;
+
+	if (name.isEmpty() && !folderGone)
+	{
+		return;
+	}
+
+	const juce::uint32 now = juce::Time::getMillisecondCounter();
+	if (firstPendingEventTime == 0)
+	{
+		firstPendingEventTime = now;
+	}
+	lastPendingEventTime = now;
+
+	// The watched folder itself was deleted or moved
+	if (folderGone)
+	{
+		// A move within a watched parent has already updated the watch's path,
+		// any other move cannot be followed, so the folder counts as removed
+		if ((mask & IN_DELETE_SELF) != 0 || !folder.isDirectory())
+		{
+			pendingFiles[folder.getFullPathName()] = false;
+
+			// Stop a stale path from resolving later events to the wrong files
+			if ((mask & IN_MOVE_SELF) != 0)
+			{
+				inotify_rm_watch(inotifyFd, watchDescriptor);
+			}
+		}
+		return;
+	}
+
+	const juce::File file = folder.getChildFile(name);
+	const bool isFolder = (mask & IN_ISDIR) != 0;
+
+	// New subfolders of a recursive watch are watched too
+	if (isFolder && includeSubfolders && (mask & (IN_CREATE | IN_MOVED_TO)) != 0)
+	{
+		const juce::ScopedLock sl(watchLock);
+		addWatch(file, true);
+	}
+
+	if ((mask & IN_MOVED_FROM) != 0)
+	{
+		// Wait for the matching IN_MOVED_TO, or treat it as removed when the batch is delivered
+		pendingMovesFrom[cookie] = file;
+	}
+	else if ((mask & IN_MOVED_TO) != 0)
+	{
+		auto movedFrom = pendingMovesFrom.find(cookie);
+
+		if (movedFrom != pendingMovesFrom.end())
+		{
+			const juce::File oldFile = movedFrom->second;
+			pendingMoves.push_back({ oldFile, file });
+			pendingMovesFrom.erase(movedFrom);
+
+			// Watches follow the moved folder, so update their paths
+			if (isFolder)
+			{
+				const juce::ScopedLock sl(watchLock);
+				for (auto& watchedFolder : watchedFolders)
+				{
+					auto& watchedPath = watchedFolder.second.first;
+					if (watchedPath == oldFile || watchedPath.isAChildOf(oldFile))
+					{
+						watchedPath = file.getChildFile(watchedPath.getRelativePathFrom(oldFile));
+					}
+				}
+			}
+		}
+		else
+		{
+			// Moved in from outside the watched folders
+			pendingFiles[file.getFullPathName()] = true;
+		}
+	}
+	else if ((mask & IN_DELETE) != 0)
+	{
+		pendingFiles[file.getFullPathName()] = false;
+	}
+	else if ((mask & IN_CLOSE_WRITE) != 0 || (isFolder && (mask & IN_CREATE) != 0))
+	{
+		// Files are only reported once fully written
+		pendingFiles[file.getFullPathName()] = true;
+	}
+   #else
+	juce::ignoreUnused(watchDescriptor, mask, cookie, name);
+   #endif
+}
+
+void LibraryWatcher::flushPendingChanges()
+{
+	// Moved out of the watched folders, unless something has taken the path since
+	for (const auto& movedFrom : pendingMovesFrom)
+	{
+		pendingFiles[movedFrom.second.getFullPathName()] = movedFrom.second.exists();
+	}
+
+	{
+		const juce::ScopedLock sl(watchLock);
+
+		// Only the last event for each path matters, also across batches not yet delivered
+		for (const auto& pendingFile : pendingFiles)
+		{
+			readyFiles[pendingFile.first] = pendingFile.second;
+		}
+
+		readyMoves.insert(readyMoves.end(), pendingMoves.begin(), pendingMoves.end());
+	}
+
+	pendingFiles.clear();
+	pendingMovesFrom.clear();
+	pendingMoves.clear();
+	firstPendingEventTime = 0;
+
+	triggerAsyncUpdate();
+}
+
+void LibraryWatcher::handleAsyncUpdate()
+{
+	Changes changes;
+	std::map<juce::String, bool> files;
+
+	{
+		const juce::ScopedLock sl(watchLock);
+		files.swap(readyFiles);
+		changes.movedFiles.swap(readyMoves);
+	}
+
+	// Each path is in the map once, so no array needs searching
+	for (const auto& file : files)
+	{
+		(file.second ? changes.addedFiles : changes.removedFiles).add(juce::File(file.first));
+	}
+
+	if (onFilesChanged != nullptr)
+	{
+		onFilesChanged(changes);
+	}
+}
@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+	LibraryWatcher.h
+	Created: 18 Oct 2026 5:02:17pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+/**
+ * LibraryWatcher class watches the folders holding the playlist's audio
+ * tracks and reports files that are added, removed or moved, so the
+ * playlist can be kept in sync without rescanning.
+ *
+ * Events are read from inotify on a background thread. Bursts of events
+ * (copying or deleting a whole album) are coalesced until the folders have
+ * been quiet for a short while, then delivered as a single batch on the
+ * message thread. Watching is only available on Linux; on other platforms
+ * watchFolder() does nothing.
+ *
+ * A watched folder that is renamed or moved is only followed if its parent
+ * is watched too. Otherwise it is reported as removed and no longer watched.
+ *
+ * This class inherits from juce::Thread and juce::AsyncUpdater to read
+ * events in the background and deliver them on the message thread.
+ */
+class LibraryWatcher : private juce::Thread,
+					   private juce::AsyncUpdater
+{
+public:
+	/**
+	 * A coalesced batch of file system changes.
+	 * Removed and moved entries may be folders, in which case they apply
+	 * to every file inside them.
+	 */
+	struct Changes
+	{
+		juce::Array<juce::File> addedFiles;
+		juce::Array<juce::File> removedFiles;
+		std::vector<std::pair<juce::File, juce::File>> movedFiles;
+	};
+
+	/**
+	 * Constructor for the LibraryWatcher class.
+	 */
+	LibraryWatcher();
+
+	/**
+	 * Destructor for the LibraryWatcher class.
+	 */
+	~LibraryWatcher() override;
+
+	/**
+	 * Starts watching a folder. Watching the same folder twice has no effect.
+	 *
+	 * @param folder				The folder to watch.
+	 * @param includeSubfolders		Also watch every folder inside it, including new ones.
+	 */
+	void watchFolder(const juce::File& folder, bool includeSubfolders);
+
+	/**
+	 * Called on the message thread with each batch of changes.
+	 */
+	std::function<void(const Changes&)> onFilesChanged;
+
+private:
+	/**
+	 * Thread
+	 * Reads file system events until the thread is stopped.
+	 */
+	void run() override;
+
+	/**
+	 * AsyncUpdater
+	 * Hands the ready changes to onFilesChanged.
+	 */
+	void handleAsyncUpdate() override;
+
+	/**
+	 * Adds a watch for one folder, and its subfolders if requested.
+	 * Must be called with watchLock held.
+	 */
+	void addWatch(const juce::File& folder, bool includeSubfolders);
+
+	/**
+	 * Records one file system event in the pending batch.
+	 * Called on the watcher thread.
+	 *
+	 * @param watchDescriptor	Watch the event belongs to.
+	 * @param mask				Event type flags.
+	 * @param cookie			Pairs the two halves of a move.
+	 * @param name				File name within the watched folder.
+	 */
+	void handleEvent(int watchDescriptor, juce::uint32 mask, juce::uint32 cookie, const juce::String& name);
+
+	/**
+	 * Moves the pending batch to the ready changes and notifies the message thread.
+	 * Called on the watcher thread.
+	 */
+	void flushPendingChanges();
+
+	/**
+	 * The inotify instance, or -1 if unavailable.
+	 */
+	int inotifyFd = -1;
+
+	/**
+	 * Watched folder and subfolder flag for each watch descriptor.
+	 */
+	juce::CriticalSection watchLock;
+	std::map<int, std::pair<juce::File, bool>> watchedFolders;
+
+	/**
+	 * Pending batch, only touched by the watcher thread.
+	 * A path maps to true if it was last seen added, false if removed.
+	 */
+	std::map<juce::String, bool> pendingFiles;
+	std::map<juce::uint32, juce::File> pendingMovesFrom;
+	std::vector<std::pair<juce::File, juce::File>> pendingMoves;
+	juce::uint32 firstPendingEventTime = 0;
+	juce::uint32 lastPendingEventTime = 0;
+
+	/**
+	 * Changes ready for the message thread, guarded by watchLock.
+	 * A path maps to true if it was last seen added, false if removed.
+	 */
+	std::map<juce::String, bool> readyFiles;
+	std::vector<std::pair<juce::File, juce::File>> readyMoves;
+
+	/**
+	 * A batch is delivered once no event arrived for quietPeriodMs,
+	 * or maxBatchDelayMs after its first event during a long burst.
+	 */
+	static constexpr juce::uint32 quietPeriodMs = 250;
+	static constexpr juce::uint32 maxBatchDelayMs = 1000;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LibraryWatcher)
+};
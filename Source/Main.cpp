@@ -10,6 +10,7 @@
 
 #include <JuceHeader.h>
 #include "MainComponent.h"
+#include "OfflineRenderer.h"
 
 //==============================================================================
 class DJApplication : public juce::JUCEApplication
@@ -27,6 +28,16 @@ public:
 	{
 		// This method is where you should put your application's initialisation code..
 
+		// Render a scripted mix to a file without a window or audio device
+		int exitCode = 0;
+
+		if (OfflineRenderer::runFromCommandLine(commandLine, exitCode))
+		{
+			setApplicationReturnValue(exitCode);
+			quit();
+			return;
+		}
+
 		mainWindow.reset(new MainWindow(getApplicationName()));
 	}
 
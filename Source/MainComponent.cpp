@@ -13,32 +13,64 @@
 //==============================================================================
 MainComponent::MainComponent()
 {
-	setSize(800, 600);
+	setSize(1000, 600);
+
+	// Time the decks before the audio starts
+	mixerEngine.setProfiler(&callbackProfiler);
 
 	if (juce::RuntimePermissions::isRequired(juce::RuntimePermissions::recordAudio)
 		&& !juce::RuntimePermissions::isGranted(juce::RuntimePermissions::recordAudio))
 	{
 		juce::RuntimePermissions::request(juce::RuntimePermissions::recordAudio,
-			[&](bool granted) { setAudioChannels(granted ? 2 : 0, 2); });
+			[&](bool granted) { setAudioChannels(granted ? 2 : 0, 4); });
 	}
 	else
 	{
-		// Specify the number of input and output channels to open
-		setAudioChannels(0, 2);
+		// Master on the first output pair, headphone cue on the second
+		setAudioChannels(0, 4);
 	}
 	addAndMakeVisible(deckGUI1);
 	addAndMakeVisible(deckGUI2);
+	addAndMakeVisible(channelStrip1);
+	addAndMakeVisible(channelStrip2);
 
 	addAndMakeVisible(playlistComponent);
 	addAndMakeVisible(soundEffect);
+	addAndMakeVisible(recorderGUI);
+
+	// Hidden until asked for, over the playlist
+	addChildComponent(diagnosticsPanel);
+	setWantsKeyboardFocus(true);
 
 	setupSlider(controlSlider, controlLabel);
 
+	// Headphones blend from the cued decks to the master
+	addAndMakeVisible(cueMixKnob);
+	cueMixKnob.addListener(this);
+	cueMixKnob.setRange(0.0, 1.0);
+	cueMixKnob.setValue(0.0);
+	cueMixKnob.setSliderStyle(juce::Slider::Rotary);
+	cueMixKnob.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
+	cueMixKnob.setTooltip("Headphones: cue to master");
+	cueMixKnob.setMouseCursor(juce::MouseCursor::DraggingHandCursor);
+	cueMixKnob.setLookAndFeel(&customDesign);
+
+	// Meters read the levels measured by the mixer
+	deckGUI1.setLevelMeter(&mixerEngine.getDeckMeter(0));
+	deckGUI2.setLevelMeter(&mixerEngine.getDeckMeter(1));
+	addAndMakeVisible(masterMeter);
+	masterMeter.setMeter(&mixerEngine.getMasterMeter());
+	masterMeter.setShowsLimiter(true);
+
+	channelStrip1.onCueChanged = [this](bool shouldCue) { mixerEngine.setCue(0, shouldCue); };
+	channelStrip2.onCueChanged = [this](bool shouldCue) { mixerEngine.setCue(1, shouldCue); };
+
 	formatManager.registerBasicFormats();
 }
 
 MainComponent::~MainComponent()
 {
+	cueMixKnob.setLookAndFeel(nullptr);
 	shutdownAudio();
 }
 
@@ -66,28 +98,60 @@ void MainComponent::setupSlider(juce::Slider& slider, juce::Label& label)
 //==============================================================================
 void MainComponent::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
 {
-	// Play sound effect component.
-	playerSoundEffect.prepareToPlay(samplesPerBlockExpected, sampleRate);
-	mixerSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
+	// Prepares the decks and the sound effect sampler
+	mixerEngine.prepareToPlay(samplesPerBlockExpected, sampleRate);
+	mixRecorder.prepare(sampleRate);
+	callbackProfiler.prepare(sampleRate);
 
-	mixerSource.addInputSource(&player1, false);
-	mixerSource.addInputSource(&player2, false);
-	mixerSource.addInputSource(&playerSoundEffect, false);
+	DBG("Master limiter latency: " << mixerEngine.getLatencySamples() << " samples");
+
+	// Include the device's output latency and the master limiter's in the pads' trigger latency
+	if (auto* device = deviceManager.getCurrentAudioDevice())
+	{
+		soundEffectSampler.setOutputLatency(device->getOutputLatencyInSamples() + mixerEngine.getLatencySamples());
+	}
 }
 void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
 {
-	mixerSource.getNextAudioBlock(bufferToFill);
+	callbackProfiler.beginCallback();
+
+	// Read the decks' positions before they advance through this block
+	updateSamplerBeatClock();
+
+	mixerEngine.getNextAudioBlock(bufferToFill);
+
+	// Record the master as heard, after the limiter
+	mixRecorder.process(*bufferToFill.buffer, bufferToFill.startSample, bufferToFill.numSamples);
+
+	callbackProfiler.endCallback(bufferToFill.numSamples);
+}
+
+void MainComponent::updateSamplerBeatClock()
+{
+	double beatPosition1 = 0.0, beatsPerSample1 = 0.0;
+	double beatPosition2 = 0.0, beatsPerSample2 = 0.0;
+	bool hasClock1 = player1.getBeatClock(beatPosition1, beatsPerSample1);
+	bool hasClock2 = player2.getBeatClock(beatPosition2, beatsPerSample2);
+
+	if (hasClock1 && (!hasClock2 || crossfaderPosition <= 0.5))
+	{
+		soundEffectSampler.setBeatClock(beatPosition1, beatsPerSample1);
+	}
+	else if (hasClock2)
+	{
+		soundEffectSampler.setBeatClock(beatPosition2, beatsPerSample2);
+	}
+	else
+	{
+		// No beat clock, quantised pads play straight away
+		soundEffectSampler.setBeatClock(0.0, 0.0);
+	}
 }
 
 void MainComponent::releaseResources()
 {
-	player1.releaseResources();
-	player2.releaseResources();
-	mixerSource.releaseResources();
-	mixerSource.removeAllInputs();
-	
-	// Release sound effect component
-	playerSoundEffect.releaseResources();
+	// Releases the decks and the sound effect sampler
+	mixerEngine.releaseResources();
 }
 
 //==============================================================================
@@ -116,15 +180,28 @@ void MainComponent::resized()
 	float halfH = getHeight() * 0.45f;
 	float sliderH = halfH * 0.1f;
 
-	deckGUI1.setBounds(0, topMargin, halfW, halfH);
-	deckGUI2.setBounds(halfW, topMargin, halfW, halfH);
-	controlSlider.setBounds(getWidth() * 0.2f, topMargin + halfH, getWidth() * 0.6f, sliderH);
+	// Decks on either side of the mixer channels
+	float deckW = getWidth() * 0.4f;
+	float stripW = halfW - deckW;
+
+	deckGUI1.setBounds(0, topMargin, deckW, halfH);
+	channelStrip1.setBounds(deckW, topMargin, stripW, halfH);
+	channelStrip2.setBounds(halfW, topMargin, stripW, halfH);
+	deckGUI2.setBounds(halfW + stripW, topMargin, deckW, halfH);
+	controlSlider.setBounds(getWidth() * 0.3f, topMargin + halfH, getWidth() * 0.4f, sliderH);
+	cueMixKnob.setBounds(getWidth() * 0.85f, topMargin + halfH, sliderH, sliderH);
+	masterMeter.setBounds(getWidth() * 0.85f + sliderH * 1.2f, topMargin + halfH + sliderH * 0.15f,
+		getWidth() * 0.13f - sliderH * 1.2f, sliderH * 0.7f);
+
+	// Recorder on the left of the crossfader's label
+	recorderGUI.setBounds(getWidth() * 0.005f, topMargin + halfH, getWidth() * 0.165f, sliderH);
 
 	float width = getWidth() * 0.1f;
 	float height = topMargin + halfH + sliderH;
 	float playlistW = getWidth() * 0.6f;
 	float playlistH = getHeight() - height;
 	playlistComponent.setBounds(0, height, playlistW, playlistH);
+	diagnosticsPanel.setBounds(0, height, playlistW, playlistH);
 	soundEffect.setBounds(playlistW, height, getWidth() - playlistW, playlistH);
 }
 
@@ -133,6 +210,8 @@ void MainComponent::sliderValueChanged(juce::Slider* slider)
 {
 	if (slider == &controlSlider)
     {
+		crossfaderPosition = controlSlider.getValue();
+
 		// Adjust the volume of deckGUI1 inversely proportional to slider value 
 		// Slide toward left
 		deckGUI1.setVolume(1.0 - controlSlider.getValue());
@@ -141,4 +220,19 @@ void MainComponent::sliderValueChanged(juce::Slider* slider)
 		// Slide toward right.
 		deckGUI2.setVolume(controlSlider.getValue());
     }
-}
\ No newline at end of file
+	else if (slider == &cueMixKnob)
+	{
+		mixerEngine.setCueMix(static_cast<float>(cueMixKnob.getValue()));
+	}
+}
+
+bool MainComponent::keyPressed(const juce::KeyPress& key)
+{
+	if (key == juce::KeyPress('d', juce::ModifierKeys::commandModifier | juce::ModifierKeys::shiftModifier, 0))
+	{
+		diagnosticsPanel.setVisible(!diagnosticsPanel.isVisible());
+		return true;
+	}
+
+	return false;
+}
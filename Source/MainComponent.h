@@ -13,9 +13,15 @@
 #include <JuceHeader.h>
 #include "DJAudioPlayer.h"
 #include "DeckGUI.h"
+#include "ChannelStrip.h"
+#include "MixerEngine.h"
 #include "PlaylistComponent.h"
 #include "SoundEffect.h"
-#include "AudioTrack.h"
+#include "SamplerEngine.h"
+#include "MixRecorder.h"
+#include "RecorderGUI.h"
+#include "CallbackProfiler.h"
+#include "DiagnosticsPanel.h"
 
 class MainComponent : public juce::AudioAppComponent,
 	public juce::Slider::Listener
@@ -76,6 +82,14 @@ public:
 	 */
 	void sliderValueChanged(juce::Slider* slider) override;
 
+	/**
+	 * Shows or hides the diagnostics panel on Ctrl+Shift+D.
+	 *
+	 * @param key	The key pressed.
+	 * @return		True if the key was used.
+	 */
+	bool keyPressed(const juce::KeyPress& key) override;
+
 private:
 	/**
 	 * Manages audio formats.
@@ -99,10 +113,11 @@ private:
 	DJAudioPlayer player2{ formatManager };
 	DeckGUI deckGUI2{ &player2, formatManager, thumbCache, false };
 
-	/** 
-	 * Mixes both players audio together.
+	/**
+	 * Mixer channels of both decks, between the decks.
 	 */
-	juce::MixerAudioSource mixerSource;
+	ChannelStrip channelStrip1{ &player1, "DECK A" };
+	ChannelStrip channelStrip2{ &player2, "DECK B" };
 
 	/**
 	 * Playlist component that interacts with the audio players.
@@ -110,14 +125,31 @@ private:
 	PlaylistComponent playlistComponent{ formatManager, &deckGUI1, &deckGUI2 };
 	
 	/**
-	 * DJ audio player specifically for sound effects.
+	 * Sampler playing the sound effects from memory.
+	 */
+	SamplerEngine soundEffectSampler;
+
+	/**
+	 * Mixes both players and the sound effects into the master and headphone cue outputs.
 	 */
-	DJAudioPlayer playerSoundEffect{ formatManager };
+	MixerEngine mixerEngine{ player1, player2, soundEffectSampler };
 
 	/**
-	 * Sound effect GUI component that interacts with the sound effect player.
+	 * Records the master output, and its controls.
 	 */
-	SoundEffect soundEffect{ &playerSoundEffect };
+	MixRecorder mixRecorder;
+	RecorderGUI recorderGUI{ mixRecorder };
+
+	/**
+	 * Times the audio callbacks, shown on the hidden diagnostics panel.
+	 */
+	CallbackProfiler callbackProfiler;
+	DiagnosticsPanel diagnosticsPanel{ callbackProfiler, deviceManager };
+
+	/**
+	 * Sound effect GUI component that interacts with the sound effect sampler.
+	 */
+	SoundEffect soundEffect{ &soundEffectSampler };
 
 	/**
 	 * Calling for the label font "Crossfader"
@@ -139,6 +171,28 @@ private:
 	 */
 	juce::Label controlLabel;
 
+	/**
+	 * Knob blending the headphones from the cued decks to the master.
+	 */
+	juce::Slider cueMixKnob;
+
+	/**
+	 * Level meter of the master output.
+	 */
+	VUMeter masterMeter;
+
+	/**
+	 * Crossfader position, read by the audio thread to pick the master deck.
+	 */
+	std::atomic<double> crossfaderPosition{ 0.5 };
+
+	/**
+	 * Passes the master deck's beat clock to the sound effect sampler.
+	 * The master deck is the playing deck with a known tempo, or the one the
+	 * crossfader favours if both are. Called on the audio thread.
+	 */
+	void updateSamplerBeatClock();
+
 	/**
 	 * Setup and design sliders with specified parameters.
 	 *
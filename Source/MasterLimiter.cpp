@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+	MasterLimiter.cpp
+	Created: 22 Oct 2026 2:47:09pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "MasterLimiter.h"
+
+MasterLimiter::MasterLimiter()
+{
+	// Windowed sinc between the two samples either side of the centre
+	for (int phase = 1; phase < oversampling; ++phase)
+	{
+		auto& taps = interpolationTaps[static_cast<size_t>(phase - 1)];
+		const double fraction = static_cast<double>(phase) / oversampling;
+		double sum = 0.0;
+
+		for (int j = 0; j < tapsPerPhase; ++j)
+		{
+			const double distance = (j - (tapsPerPhase / 2 - 1)) - fraction;
+			const double x = juce::MathConstants<double>::pi * distance;
+			const double sinc = std::abs(distance) < 1.0e-9 ? 1.0 : std::sin(x) / x;
+			const double window = 0.5 + 0.5 * std::cos(juce::MathConstants<double>::pi * distance / (tapsPerPhase / 2 + 0.5));
+
+			taps[static_cast<size_t>(j)] = static_cast<float>(sinc * window);
+			sum += sinc * window;
+		}
+
+		// Unity gain at DC
+		for (auto& tap : taps)
+		{
+			tap = static_cast<float>(tap / sum);
+		}
+	}
+}
+
+MasterLimiter::~MasterLimiter()
+{
+
+}
+
+void MasterLimiter::prepare(double sampleRate)
+{
+	lookaheadSamples = juce::jmax(1, juce::roundToInt(sampleRate * lookaheadTime));
+
+	// The interpolator reports the peak at its centre, half its length late
+	latencySamples = lookaheadSamples + tapsPerPhase / 2 - 1;
+
+	for (auto& channelHistory : history)
+	{
+		channelHistory.fill(0.0f);
+	}
+	historyIndex = 0;
+
+	// Peaks are held one sample longer than they are averaged, covering the
+	// sample after each peak as well
+	holdGains.assign(static_cast<size_t>(lookaheadSamples + 2), 1.0f);
+	holdTimes.assign(static_cast<size_t>(lookaheadSamples + 2), 0);
+	holdFront = holdSize = 0;
+	sampleCounter = 0;
+	releasedGain = 1.0f;
+	releaseCoefficient = static_cast<float>(1.0 - std::exp(-1.0 / (sampleRate * releaseTime)));
+
+	averageWindow.assign(static_cast<size_t>(lookaheadSamples), 1.0f);
+	averageIndex = 0;
+	averageSum = lookaheadSamples;
+
+	delayBuffer.setSize(2, latencySamples);
+	delayBuffer.clear();
+	delayIndex = 0;
+}
+
+int MasterLimiter::getLatencySamples() const
+{
+	return latencySamples;
+}
+
+float MasterLimiter::getInputTruePeakDb() const
+{
+	return inputTruePeakDb;
+}
+
+float MasterLimiter::getGainReductionDb() const
+{
+	return gainReductionDb;
+}
+
+float MasterLimiter::pushTruePeak(float left, float right)
+{
+	const float input[2] = { left, right };
+	float peak = 0.0f;
+
+	for (int channel = 0; channel < 2; ++channel)
+	{
+		auto& channelHistory = history[static_cast<size_t>(channel)];
+		channelHistory[static_cast<size_t>(historyIndex)] = input[channel];
+		channelHistory[static_cast<size_t>(historyIndex + tapsPerPhase)] = input[channel];
+
+		// The last tapsPerPhase samples, oldest first
+		const float* samples = channelHistory.data() + historyIndex + 1;
+		peak = juce::jmax(peak, std::abs(samples[tapsPerPhase / 2 - 1]));
+
+		for (const auto& taps : interpolationTaps)
+		{
+			float interpolated = 0.0f;
+
+			for (int j = 0; j < tapsPerPhase; ++j)
+			{
+				interpolated += taps[static_cast<size_t>(j)] * samples[j];
+			}
+
+			peak = juce::jmax(peak, std::abs(interpolated));
+		}
+	}
+
+	if (++historyIndex == tapsPerPhase)
+	{
+		historyIndex = 0;
+	}
+
+	return peak;
+}
+
+void MasterLimiter::process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+	const int numChannels = juce::jmin(2, buffer.getNumChannels());
+
+	if (numChannels == 0)
+	{
+		return;
+	}
+
+	float* left = buffer.getWritePointer(0, startSample);
+	float* right = numChannels > 1 ? buffer.getWritePointer(1, startSample) : nullptr;
+	float* delayed[2] = { delayBuffer.getWritePointer(0), delayBuffer.getWritePointer(1) };
+	const int holdCapacity = static_cast<int>(holdGains.size());
+	const juce::uint32 holdLength = static_cast<juce::uint32>(lookaheadSamples + 1);
+
+	float blockPeak = 0.0f;
+	float blockGain = 1.0f;
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const float leftIn = left[i];
+		const float rightIn = right != nullptr ? right[i] : leftIn;
+
+		const float peak = pushTruePeak(leftIn, rightIn);
+		const float neededGain = peak > ceiling ? ceiling / peak : 1.0f;
+		blockPeak = juce::jmax(blockPeak, peak);
+
+		// Smallest gain needed in the window, gains that can never be the minimum are dropped
+		while (holdSize > 0 && holdGains[static_cast<size_t>((holdFront + holdSize - 1) % holdCapacity)] >= neededGain)
+		{
+			--holdSize;
+		}
+
+		const int back = (holdFront + holdSize) % holdCapacity;
+		holdGains[static_cast<size_t>(back)] = neededGain;
+		holdTimes[static_cast<size_t>(back)] = sampleCounter;
+		++holdSize;
+
+		while (sampleCounter - holdTimes[static_cast<size_t>(holdFront)] >= holdLength)
+		{
+			holdFront = (holdFront + 1) % holdCapacity;
+			--holdSize;
+		}
+
+		++sampleCounter;
+
+		// Come down at once, recover at the release rate
+		const float heldGain = holdGains[static_cast<size_t>(holdFront)];
+		releasedGain = heldGain < releasedGain ? heldGain : releasedGain + (heldGain - releasedGain) * releaseCoefficient;
+
+		averageSum += releasedGain - averageWindow[static_cast<size_t>(averageIndex)];
+		averageWindow[static_cast<size_t>(averageIndex)] = releasedGain;
+		if (++averageIndex == lookaheadSamples)
+		{
+			averageIndex = 0;
+		}
+
+		const float gain = juce::jmin(1.0f, static_cast<float>(averageSum / lookaheadSamples));
+		blockGain = juce::jmin(blockGain, gain);
+
+		// Output the input from latencySamples ago at the gain worked out for it
+		left[i] = delayed[0][delayIndex] * gain;
+		delayed[0][delayIndex] = leftIn;
+
+		if (right != nullptr)
+		{
+			right[i] = delayed[1][delayIndex] * gain;
+			delayed[1][delayIndex] = rightIn;
+		}
+
+		if (++delayIndex == latencySamples)
+		{
+			delayIndex = 0;
+		}
+	}
+
+	inputTruePeakDb = juce::Decibels::gainToDecibels(blockPeak, -100.0f);
+	gainReductionDb = -juce::Decibels::gainToDecibels(blockGain, -100.0f);
+}
@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+	MasterLimiter.h
+	Created: 22 Oct 2026 2:47:09pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+/**
+ * MasterLimiter class is a lookahead brickwall limiter for the master bus,
+ * keeping the true peak of its output under a ceiling.
+ *
+ * Peaks are detected between samples as well as on them, by interpolating
+ * the input at four times the sample rate as a BS.1770 true peak meter does.
+ * Like such a meter it can read a little low on content near the top of the
+ * audio band, which the -1dBTP ceiling leaves room for on music.
+ *
+ * The gain needed for each peak is held for the lookahead time and then
+ * averaged over it, so the gain has fully come down by the time the delayed
+ * peak leaves the limiter, and recovers smoothly after. Both channels share
+ * the gain.
+ *
+ * The output is delayed by getLatencySamples(). Nothing is allocated after prepare.
+ */
+class MasterLimiter
+{
+public:
+	/**
+	 * Constructor for the MasterLimiter class.
+	 */
+	MasterLimiter();
+
+	/**
+	 * Destructor for the MasterLimiter class.
+	 */
+	~MasterLimiter();
+
+	/**
+	 * Allocates the delay lines for the sample rate and clears them.
+	 *
+	 * @param sampleRate	The audio sample rate.
+	 */
+	void prepare(double sampleRate);
+
+	/**
+	 * Limits a block of audio in place. Called on the audio thread.
+	 *
+	 * @param buffer		The audio, only the first two channels are used.
+	 * @param startSample	First sample of the block.
+	 * @param numSamples	Number of samples in the block.
+	 */
+	void process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+	/**
+	 * Returns how much the output is delayed.
+	 *
+	 * @return The delay in samples.
+	 */
+	int getLatencySamples() const;
+
+	/**
+	 * Returns the highest true peak of the input in the last block.
+	 *
+	 * @return The peak in decibels relative to full scale.
+	 */
+	float getInputTruePeakDb() const;
+
+	/**
+	 * Returns the most gain reduction applied in the last block.
+	 *
+	 * @return The reduction in decibels, 0 or above.
+	 */
+	float getGainReductionDb() const;
+
+private:
+	/**
+	 * Returns the true peak around the input sample entering the interpolator's centre.
+	 */
+	float pushTruePeak(float left, float right);
+
+	/**
+	 * Interpolation filter taps for the three points between samples, oldest
+	 * sample first, and the last input samples of each channel written twice
+	 * over so they can be read without wrapping.
+	 */
+	static constexpr int oversampling = 4;
+	static constexpr int tapsPerPhase = 12;
+	std::array<std::array<float, tapsPerPhase>, oversampling - 1> interpolationTaps{};
+	std::array<std::array<float, tapsPerPhase * 2>, 2> history{};
+	int historyIndex = 0;
+
+	/**
+	 * Gain needed by each sample in the lookahead window, kept as a queue of
+	 * falling minimums, and the window's running minimum after release.
+	 */
+	std::vector<float> holdGains;
+	std::vector<juce::uint32> holdTimes;
+	int holdFront = 0, holdSize = 0;
+	juce::uint32 sampleCounter = 0;
+	float releasedGain = 1.0f;
+	float releaseCoefficient = 0.0f;
+
+	/**
+	 * Held gains averaged over the lookahead window.
+	 */
+	std::vector<float> averageWindow;
+	int averageIndex = 0;
+	double averageSum = 0.0;
+
+	/**
+	 * Input delayed to line peaks up with their gain.
+	 */
+	juce::AudioBuffer<float> delayBuffer;
+	int delayIndex = 0;
+
+	int lookaheadSamples = 1;
+	int latencySamples = 0;
+
+	/**
+	 * Levels of the last block, read by the message thread.
+	 */
+	std::atomic<float> inputTruePeakDb{ -100.0f };
+	std::atomic<float> gainReductionDb{ 0.0f };
+
+	/**
+	 * Highest output true peak, -1dBTP.
+	 */
+	static constexpr float ceiling = 0.891f;
+
+	/**
+	 * Lookahead and release times in seconds.
+	 */
+	static constexpr double lookaheadTime = 0.0015;
+	static constexpr double releaseTime = 0.1;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MasterLimiter)
+};
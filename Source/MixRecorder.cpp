@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+	MixRecorder.cpp
+	Created: 24 Oct 2026 9:41:27am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "MixRecorder.h"
+
+MixRecorder::MixRecorder()
+{
+	writerThread.startThread();
+}
+
+MixRecorder::~MixRecorder()
+{
+	stopRecording();
+	writerThread.stopThread(4000);
+}
+
+void MixRecorder::prepare(double newSampleRate)
+{
+	if (newSampleRate != sampleRate)
+	{
+		stopRecording();
+	}
+
+	sampleRate = newSampleRate;
+}
+
+bool MixRecorder::startRecording(const juce::File& newFile, Format format)
+{
+	stopRecording();
+
+	if (sampleRate <= 0.0)
+	{
+		DBG("MixRecorder::startRecording audio device is not running");
+		return false;
+	}
+
+	newFile.deleteFile();
+	std::unique_ptr<juce::FileOutputStream> fileStream(newFile.createOutputStream());
+
+	if (fileStream == nullptr)
+	{
+		DBG("< Cannot create recording: " << newFile.getFullPathName() << " >");
+		return false;
+	}
+
+	std::unique_ptr<juce::AudioFormat> audioFormat;
+	if (format == Format::FLAC)
+	{
+		audioFormat = std::make_unique<juce::FlacAudioFormat>();
+	}
+	else
+	{
+		audioFormat = std::make_unique<juce::WavAudioFormat>();
+	}
+
+	// Stereo 24 bit, the writer owns the stream once created
+	auto* writer = audioFormat->createWriterFor(fileStream.get(), sampleRate, 2, 24, {}, 0);
+
+	if (writer == nullptr)
+	{
+		DBG("< Cannot write " << getFileExtension(format) << " to: " << newFile.getFullPathName() << " >");
+		return false;
+	}
+	fileStream.release();
+
+	auto newWriter = std::make_unique<juce::AudioFormatWriter::ThreadedWriter>(writer, writerThread,
+		juce::roundToInt(sampleRate * fifoSeconds));
+
+	file = newFile;
+	samplesRecorded = 0;
+	droppedBlocks = 0;
+
+	const juce::SpinLock::ScopedLockType sl(writerLock);
+	threadedWriter = std::move(newWriter);
+	recording = true;
+
+	return true;
+}
+
+void MixRecorder::stopRecording()
+{
+	std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> oldWriter;
+
+	{
+		const juce::SpinLock::ScopedLockType sl(writerLock);
+		oldWriter = std::move(threadedWriter);
+		recording = false;
+	}
+
+	// Deleting the writer flushes the FIFO and closes the file, away from the audio thread
+	oldWriter.reset();
+}
+
+bool MixRecorder::isRecording() const
+{
+	return recording;
+}
+
+void MixRecorder::process(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+	// Only busy while a recording starts or stops, then the block is skipped
+	const juce::GenericScopedTryLock<juce::SpinLock> sl(writerLock);
+
+	if (!sl.isLocked() || threadedWriter == nullptr || buffer.getNumChannels() == 0)
+	{
+		return;
+	}
+
+	// A mono output is recorded on both channels
+	const float* channels[] = { buffer.getReadPointer(0, startSample),
+		buffer.getReadPointer(juce::jmin(1, buffer.getNumChannels() - 1), startSample) };
+
+	if (threadedWriter->write(channels, numSamples))
+	{
+		samplesRecorded += numSamples;
+	}
+	else
+	{
+		++droppedBlocks;
+	}
+}
+
+double MixRecorder::getRecordedSeconds() const
+{
+	return sampleRate > 0.0 ? samplesRecorded / sampleRate : 0.0;
+}
+
+int MixRecorder::getNumDroppedBlocks() const
+{
+	return droppedBlocks;
+}
+
+const juce::File& MixRecorder::getFile() const
+{
+	return file;
+}
+
+juce::String MixRecorder::getFileExtension(Format format)
+{
+	return format == Format::FLAC ? ".flac" : ".wav";
+}
@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+	MixRecorder.h
+	Created: 24 Oct 2026 9:41:27am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+
+/**
+ * MixRecorder class records the master output to a WAV or FLAC file.
+ *
+ * The audio thread only copies each block into the FIFO of a
+ * juce::AudioFormatWriter::ThreadedWriter, which a background thread drains
+ * to disk, so recording never waits on the disk. If the disk falls so far
+ * behind that the FIFO is full, the block is dropped and counted instead.
+ * Files are opened and closed on the message thread.
+ */
+class MixRecorder
+{
+public:
+	/**
+	 * File formats that can be recorded to.
+	 */
+	enum class Format { WAV, FLAC };
+
+	/**
+	 * Constructor for the MixRecorder class.
+	 */
+	MixRecorder();
+
+	/**
+	 * Destructor for the MixRecorder class.
+	 * Stops recording and finishes writing the file.
+	 */
+	~MixRecorder();
+
+	/**
+	 * Sets the sample rate of the master output. Stops any recording, as
+	 * the file's sample rate can no longer change.
+	 *
+	 * @param sampleRate	The audio sample rate.
+	 */
+	void prepare(double sampleRate);
+
+	/**
+	 * Starts recording to a new file. Called on the message thread.
+	 *
+	 * @param file		The file to create, replaced if it exists.
+	 * @param format	The file format.
+	 * @return			False if the file cannot be written.
+	 */
+	bool startRecording(const juce::File& file, Format format);
+
+	/**
+	 * Stops recording and writes what is left in the FIFO to the file.
+	 * Called on the message thread.
+	 */
+	void stopRecording();
+
+	/**
+	 * Returns true while recording.
+	 *
+	 * @return True if recording.
+	 */
+	bool isRecording() const;
+
+	/**
+	 * Records a block of the master output. Called on the audio thread.
+	 *
+	 * @param buffer		The output, the first two channels are recorded.
+	 * @param startSample	First sample of the block.
+	 * @param numSamples	Number of samples in the block.
+	 */
+	void process(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+	/**
+	 * Returns how long the current or last recording is.
+	 *
+	 * @return The length in seconds.
+	 */
+	double getRecordedSeconds() const;
+
+	/**
+	 * Returns the number of blocks dropped because the disk fell behind,
+	 * since the current or last recording started.
+	 *
+	 * @return The number of dropped blocks.
+	 */
+	int getNumDroppedBlocks() const;
+
+	/**
+	 * Returns the file of the current or last recording.
+	 *
+	 * @return The file.
+	 */
+	const juce::File& getFile() const;
+
+	/**
+	 * Returns the file extension of a format.
+	 *
+	 * @param format	The file format.
+	 * @return			The extension with its dot.
+	 */
+	static juce::String getFileExtension(Format format);
+
+private:
+	/**
+	 * Background thread writing the file.
+	 */
+	juce::TimeSliceThread writerThread{ "Mix Recorder" };
+
+	/**
+	 * Writer of the current recording, swapped by the message thread and
+	 * only ever try-locked by the audio thread.
+	 */
+	juce::SpinLock writerLock;
+	std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> threadedWriter;
+
+	/**
+	 * Set while a writer is installed, read without taking the lock.
+	 */
+	std::atomic<bool> recording{ false };
+
+	/**
+	 * Samples recorded and blocks dropped, written by the audio thread.
+	 */
+	std::atomic<juce::int64> samplesRecorded{ 0 };
+	std::atomic<int> droppedBlocks{ 0 };
+
+	std::atomic<double> sampleRate{ 0.0 };
+	juce::File file;
+
+	/**
+	 * Seconds of audio the FIFO holds before blocks are dropped.
+	 */
+	static constexpr double fifoSeconds = 2.0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MixRecorder)
+};
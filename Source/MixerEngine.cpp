@@ -0,0 +1,244 @@
+/*
+  ==============================================================================
+
+	MixerEngine.cpp
+	Created: 22 Oct 2026 10:21:37am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "MixerEngine.h"
+
+MixerEngine::MixerEngine(DJAudioPlayer& deck1, DJAudioPlayer& deck2, juce::AudioSource& _sampler)
+	: decks{ &deck1, &deck2 },
+	sampler(_sampler)
+{
+	for (auto& cue : cues)
+	{
+		cue = false;
+	}
+}
+
+MixerEngine::~MixerEngine()
+{
+
+}
+
+void MixerEngine::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+	for (auto* deck : decks)
+	{
+		deck->prepareToPlay(samplesPerBlockExpected, sampleRate);
+	}
+
+	sampler.prepareToPlay(samplesPerBlockExpected, sampleRate);
+	sourceBuffer.setSize(2, juce::jmax(1, samplesPerBlockExpected));
+	limiter.prepare(sampleRate);
+
+	cueDelayLength = limiter.getLatencySamples();
+	cueDelay.setSize(2, juce::jmax(1, cueDelayLength));
+	cueDelay.clear();
+	cueDelayPosition = 0;
+
+	for (auto& meter : deckMeters)
+	{
+		meter.prepare(sampleRate);
+	}
+	masterMeter.prepare(sampleRate);
+
+	for (int deck = 0; deck < numDecks; ++deck)
+	{
+		faderGains[deck] = decks[deck]->getGain();
+		cueGains[deck] = cues[deck] ? 1.0f : 0.0f;
+	}
+
+	lastCueMix = cueMix;
+}
+
+void MixerEngine::releaseResources()
+{
+	for (auto* deck : decks)
+	{
+		deck->releaseResources();
+	}
+
+	sampler.releaseResources();
+}
+
+void MixerEngine::setCue(int deckIndex, bool shouldCue)
+{
+	if (juce::isPositiveAndBelow(deckIndex, numDecks))
+	{
+		cues[deckIndex] = shouldCue;
+	}
+}
+
+void MixerEngine::setCueMix(float mix)
+{
+	cueMix = juce::jlimit(0.0f, 1.0f, mix);
+}
+
+int MixerEngine::getLatencySamples() const
+{
+	return limiter.getLatencySamples();
+}
+
+LevelMeter& MixerEngine::getDeckMeter(int deckIndex)
+{
+	return deckMeters[static_cast<size_t>(juce::jlimit(0, numDecks - 1, deckIndex))];
+}
+
+LevelMeter& MixerEngine::getMasterMeter()
+{
+	return masterMeter;
+}
+
+void MixerEngine::setProfiler(CallbackProfiler* profilerToUse)
+{
+	profiler = profilerToUse;
+}
+
+void MixerEngine::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+	bufferToFill.clearActiveBufferRegion();
+
+	auto& output = *bufferToFill.buffer;
+	const bool hasCue = output.getNumChannels() >= 4;
+
+	for (int deck = 0; deck < numDecks; ++deck)
+	{
+		targetFaderGains[deck] = decks[deck]->getGain();
+		targetCueGains[deck] = cues[deck] ? 1.0f : 0.0f;
+	}
+
+	// In pieces if the block is longer than expected
+	const int maxPieceSize = sourceBuffer.getNumSamples();
+
+	for (int start = 0; start < bufferToFill.numSamples; start += maxPieceSize)
+	{
+		const int numSamples = juce::jmin(maxPieceSize, bufferToFill.numSamples - start);
+		renderPiece(output, bufferToFill.startSample + start, numSamples, start, bufferToFill.numSamples, hasCue);
+	}
+
+	limiter.process(output, bufferToFill.startSample, bufferToFill.numSamples);
+
+	masterMeter.process(output.getReadPointer(0, bufferToFill.startSample),
+		output.getNumChannels() > 1 ? output.getReadPointer(1, bufferToFill.startSample) : nullptr,
+		bufferToFill.numSamples);
+
+	masterMeter.addLimiterLevels(limiter.getInputTruePeakDb(), limiter.getGainReductionDb());
+
+	for (auto& meter : deckMeters)
+	{
+		meter.publish();
+	}
+	masterMeter.publish();
+
+	// The cue output blends the cue bus, delayed as much as the limited master, with the master
+	const float newCueMix = cueMix;
+
+	if (hasCue)
+	{
+		for (int channel = 0; channel < 2; ++channel)
+		{
+			const int masterChannel = juce::jmin(channel, output.getNumChannels() - 1);
+			float* cue = output.getWritePointer(channel + 2, bufferToFill.startSample);
+
+			if (cueDelayLength > 0)
+			{
+				float* delay = cueDelay.getWritePointer(channel);
+				int position = cueDelayPosition;
+
+				for (int i = 0; i < bufferToFill.numSamples; ++i)
+				{
+					const float delayed = delay[position];
+					delay[position] = cue[i];
+					cue[i] = delayed;
+
+					if (++position == cueDelayLength)
+					{
+						position = 0;
+					}
+				}
+			}
+
+			const float* master = output.getReadPointer(masterChannel, bufferToFill.startSample);
+			const float mixStep = (newCueMix - lastCueMix) / bufferToFill.numSamples;
+
+			for (int i = 0; i < bufferToFill.numSamples; ++i)
+			{
+				const float mix = lastCueMix + mixStep * (i + 1);
+				cue[i] += mix * (master[i] - cue[i]);
+			}
+		}
+
+		if (cueDelayLength > 0)
+		{
+			cueDelayPosition = (cueDelayPosition + bufferToFill.numSamples) % cueDelayLength;
+		}
+	}
+
+	faderGains = targetFaderGains;
+	cueGains = targetCueGains;
+	lastCueMix = newCueMix;
+}
+
+void MixerEngine::renderPiece(juce::AudioBuffer<float>& output, int outputStart, int numSamples, int blockOffset, int blockSize, bool hasCue)
+{
+	const int numMasterChannels = juce::jmin(2, output.getNumChannels());
+	const juce::AudioSourceChannelInfo sourceInfo(&sourceBuffer, 0, numSamples);
+
+	for (int deck = 0; deck < numDecks; ++deck)
+	{
+		const juce::int64 renderStart = juce::Time::getHighResolutionTicks();
+		decks[deck]->getNextAudioBlock(sourceInfo);
+
+		if (profiler != nullptr)
+		{
+			profiler->addDeckTime(deck, juce::Time::getHighResolutionTicks() - renderStart);
+		}
+
+		deckMeters[deck].process(sourceBuffer.getReadPointer(0), sourceBuffer.getReadPointer(1), numSamples);
+
+		// Gains at the start of the piece and the change per sample
+		const float faderStep = (targetFaderGains[deck] - faderGains[deck]) / blockSize;
+		const float faderStart = faderGains[deck] + faderStep * blockOffset;
+		const float cueStep = (targetCueGains[deck] - cueGains[deck]) / blockSize;
+		const float cueStart = cueGains[deck] + cueStep * blockOffset;
+		const bool cued = hasCue && (cueGains[deck] > 0.0f || targetCueGains[deck] > 0.0f);
+
+		for (int channel = 0; channel < numMasterChannels; ++channel)
+		{
+			const float* source = sourceBuffer.getReadPointer(channel);
+			float* master = output.getWritePointer(channel, outputStart);
+
+			// One pass over the deck feeds both buses
+			if (cued)
+			{
+				float* cue = output.getWritePointer(channel + 2, outputStart);
+
+				for (int i = 0; i < numSamples; ++i)
+				{
+					master[i] += source[i] * (faderStart + faderStep * (i + 1));
+					cue[i] += source[i] * (cueStart + cueStep * (i + 1));
+				}
+			}
+			else
+			{
+				for (int i = 0; i < numSamples; ++i)
+				{
+					master[i] += source[i] * (faderStart + faderStep * (i + 1));
+				}
+			}
+		}
+	}
+
+	// Sound effects are played to the crowd only
+	sampler.getNextAudioBlock(sourceInfo);
+
+	for (int channel = 0; channel < numMasterChannels; ++channel)
+	{
+		output.addFrom(channel, outputStart, sourceBuffer, channel, 0, numSamples);
+	}
+}
@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+	MixerEngine.h
+	Created: 22 Oct 2026 10:21:37am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include "DJAudioPlayer.h"
+#include "MasterLimiter.h"
+#include "LevelMeter.h"
+#include "CallbackProfiler.h"
+
+/**
+ * MixerEngine class mixes both decks and the sound effect sampler into the
+ * master output on the first two channels, and the headphone cue mix on
+ * channels 3 and 4 when the device has them.
+ *
+ * Each deck is rendered once before its fader. The same pass over its
+ * samples adds it to the master at its fader gain and, while it is cued,
+ * to the cue bus at full level. The master then goes through a true peak
+ * limiter, and the cue output blends between the cue bus and the limited
+ * master, the cue bus delayed by the limiter's latency so the two line up.
+ * Gains ramp across each block, and nothing is allocated after
+ * prepareToPlay.
+ *
+ * Each deck is metered before its fader, as on a mixer, and the master
+ * after its limiter, with the limiter's input true peak and gain reduction.
+ */
+class MixerEngine : public juce::AudioSource
+{
+public:
+	/**
+	 * Number of decks mixed.
+	 */
+	static constexpr int numDecks = 2;
+
+	/**
+	 * Constructor for the MixerEngine class.
+	 *
+	 * @param deck1		The first deck.
+	 * @param deck2		The second deck.
+	 * @param sampler	The sound effect sampler, heard on the master only.
+	 */
+	MixerEngine(DJAudioPlayer& deck1, DJAudioPlayer& deck2, juce::AudioSource& sampler);
+
+	/**
+	 * Destructor for the MixerEngine class.
+	 */
+	~MixerEngine() override;
+
+	/**
+	 * Prepares the decks and the sampler, and allocates the mixing buffer.
+	 *
+	 * @param samplesPerBlockExpected	The expected samples number per block.
+	 * @param sampleRate				The audio sample rate.
+	 */
+	void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+
+	/**
+	 * Renders the master on channels 1 and 2 and the cue mix on channels 3 and 4.
+	 *
+	 * @param bufferToFill Takes in information about the buffer to be filled.
+	 */
+	void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+	/**
+	 * Releases the decks' and the sampler's resources.
+	 */
+	void releaseResources() override;
+
+	/**
+	 * Sends a deck to the cue bus, before its fader.
+	 *
+	 * @param deckIndex		The deck, below numDecks.
+	 * @param shouldCue		True to hear the deck in the headphones.
+	 */
+	void setCue(int deckIndex, bool shouldCue);
+
+	/**
+	 * Sets the blend of the cue output.
+	 *
+	 * @param mix	0 for the cue bus only, 1 for the master only.
+	 */
+	void setCueMix(float mix);
+
+	/**
+	 * Returns how much the master is delayed by its limiter.
+	 *
+	 * @return The delay in samples.
+	 */
+	int getLatencySamples() const;
+
+	/**
+	 * Returns the meter of a deck, measured before its fader.
+	 *
+	 * @param deckIndex		The deck, below numDecks.
+	 * @return				The deck's meter.
+	 */
+	LevelMeter& getDeckMeter(int deckIndex);
+
+	/**
+	 * Returns the meter of the master output.
+	 *
+	 * @return The master's meter.
+	 */
+	LevelMeter& getMasterMeter();
+
+	/**
+	 * Sets the profiler told how long each deck takes to render.
+	 * Call before playback starts.
+	 *
+	 * @param profilerToUse		The profiler, or nullptr to stop timing the decks.
+	 */
+	void setProfiler(CallbackProfiler* profilerToUse);
+
+private:
+	/**
+	 * Renders part of a block, the gains ramping by the fraction of the block done.
+	 */
+	void renderPiece(juce::AudioBuffer<float>& output, int outputStart, int numSamples, int blockOffset, int blockSize, bool hasCue);
+
+	/**
+	 * Sources mixed.
+	 */
+	std::array<DJAudioPlayer*, numDecks> decks;
+	juce::AudioSource& sampler;
+
+	/**
+	 * Profiler timing the decks, if any.
+	 */
+	CallbackProfiler* profiler = nullptr;
+
+	/**
+	 * Cue switches and blend set by the message thread.
+	 */
+	std::array<std::atomic<bool>, numDecks> cues;
+	std::atomic<float> cueMix{ 0.0f };
+
+	/**
+	 * Gains at the start and end of the block being rendered, ramped between.
+	 */
+	std::array<float, numDecks> faderGains{}, targetFaderGains{};
+	std::array<float, numDecks> cueGains{}, targetCueGains{};
+	float lastCueMix = 0.0f;
+
+	/**
+	 * Buffer each deck and the sampler are rendered into.
+	 */
+	juce::AudioBuffer<float> sourceBuffer;
+
+	/**
+	 * Keeps the master from clipping.
+	 */
+	MasterLimiter limiter;
+
+	/**
+	 * Delays the cue bus by the limiter's latency, allocated in prepareToPlay.
+	 */
+	juce::AudioBuffer<float> cueDelay;
+	int cueDelayLength = 0;
+	int cueDelayPosition = 0;
+
+	/**
+	 * Levels of each deck and of the master.
+	 */
+	std::array<LevelMeter, numDecks> deckMeters;
+	LevelMeter masterMeter;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MixerEngine)
+};
@@ -0,0 +1,415 @@
+/*
+  ==============================================================================
+
+	OfflineRenderer.cpp
+	Created: 24 Oct 2026 3:12:48pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+#include <algorithm>
+#include <cmath>
+
+OfflineRenderer::OfflineRenderer(double _sampleRate, int _blockSize)
+	: sampleRate(_sampleRate),
+	blockSize(_blockSize)
+{
+	formatManager.registerBasicFormats();
+
+	// Never play silence while a track is decoding, the render waits for it instead
+	player1.setWaitForAudio(true);
+	player2.setWaitForAudio(true);
+
+	// The crossfader starts centred, as in the application
+	player1.setGain(0.5);
+	player2.setGain(0.5);
+}
+
+OfflineRenderer::~OfflineRenderer()
+{
+
+}
+
+bool OfflineRenderer::loadScript(const juce::File& scriptFile)
+{
+	commands.clear();
+	endSample = 0;
+	error = {};
+
+	if (!scriptFile.existsAsFile())
+	{
+		error = "Script not found: " + scriptFile.getFullPathName();
+		return false;
+	}
+
+	juce::StringArray lines;
+	scriptFile.readLines(lines);
+
+	bool hasEnd = false;
+
+	for (int i = 0; i < lines.size(); ++i)
+	{
+		const auto text = lines[i].trim();
+
+		if (text.isEmpty() || text.startsWithChar('#'))
+		{
+			continue;
+		}
+
+		juce::StringArray words;
+		words.addTokens(text, " \t", "\"");
+		words.removeEmptyStrings();
+
+		for (auto& word : words)
+		{
+			word = word.unquoted();
+		}
+
+		Command command;
+		const auto problem = parseCommand(words, scriptFile.getParentDirectory(), command);
+
+		if (problem.isNotEmpty())
+		{
+			error = scriptFile.getFileName() + " line " + juce::String(i + 1) + ": " + problem;
+			commands.clear();
+			return false;
+		}
+
+		if (command.type == CommandType::End)
+		{
+			endSample = command.sample;
+			hasEnd = true;
+		}
+		else
+		{
+			commands.push_back(command);
+		}
+	}
+
+	// Commands at the same time keep the script's order
+	std::stable_sort(commands.begin(), commands.end(),
+		[](const Command& a, const Command& b) { return a.sample < b.sample; });
+
+	if (!hasEnd)
+	{
+		endSample = (commands.empty() ? 0 : commands.back().sample) + static_cast<juce::int64>(sampleRate);
+	}
+
+	// Anything after the end would never be heard
+	commands.erase(std::remove_if(commands.begin(), commands.end(),
+		[this](const Command& command) { return command.sample >= endSample; }), commands.end());
+
+	return true;
+}
+
+juce::String OfflineRenderer::parseCommand(const juce::StringArray& line, const juce::File& folder, Command& command) const
+{
+	if (line.size() < 2 || !line[0].containsOnly("0123456789."))
+	{
+		return "expected a time in seconds and a command";
+	}
+
+	command.sample = static_cast<juce::int64>(std::llround(line[0].getDoubleValue() * sampleRate));
+
+	const auto name = line[1].toLowerCase();
+	const auto deckName = line[2].toUpperCase();
+	command.deck = deckName == "B" ? 1 : 0;
+
+	const bool usesDeck = name == "load" || name == "play" || name == "pause"
+		|| name == "stop" || name == "seek" || name == "speed";
+
+	if (usesDeck && deckName != "A" && deckName != "B")
+	{
+		return name + " needs a deck, A or B";
+	}
+
+	if (name == "load")
+	{
+		command.type = CommandType::Load;
+		command.file = folder.getChildFile(line[3]);
+		command.value = line[4].getDoubleValue();
+
+		if (!command.file.existsAsFile())
+		{
+			return "audio track not found: " + command.file.getFullPathName();
+		}
+	}
+	else if (name == "play" || name == "pause" || name == "stop")
+	{
+		command.type = name == "play" ? CommandType::Play
+			: name == "pause" ? CommandType::Pause : CommandType::Stop;
+	}
+	else if (name == "seek" || name == "speed")
+	{
+		command.type = name == "seek" ? CommandType::Seek : CommandType::Speed;
+		command.value = line[3].getDoubleValue();
+
+		if (line[3].isEmpty() || (command.type == CommandType::Speed && (command.value <= 0.0 || command.value > 3.0)))
+		{
+			return name == "seek" ? "seek needs a position in seconds" : "speed needs a ratio above 0, up to 3";
+		}
+	}
+	else if (name == "crossfader")
+	{
+		command.type = CommandType::Crossfader;
+		command.value = line[2].getDoubleValue();
+
+		if (line[2].isEmpty() || command.value < 0.0 || command.value > 1.0)
+		{
+			return "crossfader needs a position from 0 to 1";
+		}
+	}
+	else if (name == "pads")
+	{
+		command.type = CommandType::Pads;
+		command.file = folder.getChildFile(line[2]);
+
+		if (line[2].isEmpty() || !command.file.isDirectory())
+		{
+			return "sample pack folder not found: " + command.file.getFullPathName();
+		}
+	}
+	else if (name == "pad")
+	{
+		command.type = CommandType::Pad;
+		command.value = line[2].getIntValue();
+
+		if (command.value < 1)
+		{
+			return "pad needs a pad number from 1";
+		}
+	}
+	else if (name == "end")
+	{
+		command.type = CommandType::End;
+	}
+	else
+	{
+		return "unknown command " + line[1];
+	}
+
+	return {};
+}
+
+bool OfflineRenderer::render(const juce::File& outputFile)
+{
+	error = {};
+	renderedSeconds = 0.0;
+	renderTime = 0.0;
+
+	std::unique_ptr<juce::AudioFormat> format;
+
+	if (outputFile.hasFileExtension(".flac"))
+	{
+		format = std::make_unique<juce::FlacAudioFormat>();
+	}
+	else
+	{
+		format = std::make_unique<juce::WavAudioFormat>();
+	}
+
+	outputFile.deleteFile();
+	std::unique_ptr<juce::OutputStream> stream = outputFile.createOutputStream();
+	std::unique_ptr<juce::AudioFormatWriter> writer;
+
+	if (stream != nullptr)
+	{
+		writer.reset(format->createWriterFor(stream.get(), sampleRate, 2, 24, {}, 0));
+	}
+
+	if (writer == nullptr)
+	{
+		error = "Cannot write " + outputFile.getFullPathName();
+		return false;
+	}
+
+	// The writer owns the stream now
+	stream.release();
+
+	mixerEngine.prepareToPlay(blockSize, sampleRate);
+
+	// Render past the end by the limiter's latency, and leave out as much from the start
+	const juce::int64 latency = mixerEngine.getLatencySamples();
+	const juce::int64 totalSamples = endSample + latency;
+
+	juce::AudioBuffer<float> buffer(2, blockSize);
+	size_t nextCommand = 0;
+	juce::int64 position = 0;
+	bool written = true;
+
+	const double startTime = juce::Time::getMillisecondCounterHiRes();
+
+	while (position < totalSamples && written)
+	{
+		while (nextCommand < commands.size() && commands[nextCommand].sample <= position)
+		{
+			applyCommand(commands[nextCommand++]);
+		}
+
+		// End the block at the next command, so it happens at its exact sample
+		juce::int64 blockEnd = juce::jmin(totalSamples, position + blockSize);
+
+		if (nextCommand < commands.size())
+		{
+			blockEnd = juce::jmin(blockEnd, commands[nextCommand].sample);
+		}
+
+		const int numSamples = static_cast<int>(blockEnd - position);
+
+		buffer.clear();
+		juce::AudioSourceChannelInfo bufferToFill(&buffer, 0, numSamples);
+		mixerEngine.getNextAudioBlock(bufferToFill);
+
+		const int skip = static_cast<int>(juce::jlimit<juce::int64>(0, numSamples, latency - position));
+
+		if (skip < numSamples)
+		{
+			written = writer->writeFromAudioSampleBuffer(buffer, skip, numSamples - skip);
+		}
+
+		position = blockEnd;
+	}
+
+	renderTime = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+	renderedSeconds = endSample / sampleRate;
+
+	// Flush the file before reporting
+	writer.reset();
+	mixerEngine.releaseResources();
+
+	if (!written)
+	{
+		error = "Failed writing " + outputFile.getFullPathName();
+	}
+
+	return written;
+}
+
+void OfflineRenderer::applyCommand(const Command& command)
+{
+	auto& player = getPlayer(command.deck);
+
+	switch (command.type)
+	{
+	case CommandType::Load:
+		player.loadURL(juce::URL(command.file));
+
+		if (command.value > 0.0)
+		{
+			player.setBpm(command.value);
+		}
+		break;
+
+	case CommandType::Play:
+		player.start();
+		break;
+
+	case CommandType::Pause:
+		player.pause();
+		break;
+
+	case CommandType::Stop:
+		player.stop();
+		break;
+
+	case CommandType::Seek:
+		player.setPosition(command.value);
+		break;
+
+	case CommandType::Speed:
+		player.setSpeed(command.value);
+		break;
+
+	case CommandType::Crossfader:
+		// Same curve as the application's crossfader
+		player1.setGain(1.0 - command.value);
+		player2.setGain(command.value);
+		break;
+
+	case CommandType::Pads:
+		if (auto pack = SamplePack::loadFromFolder(formatManager, command.file))
+		{
+			sampler.setSamplePack(pack);
+		}
+		else
+		{
+			juce::Logger::writeToLog("No audio in sample pack folder " + command.file.getFullPathName());
+		}
+		break;
+
+	case CommandType::Pad:
+		sampler.triggerPadAtSample(static_cast<int>(command.value) - 1, SamplerEngine::PadSettings(), command.sample);
+		break;
+
+	case CommandType::End:
+		break;
+	}
+}
+
+DJAudioPlayer& OfflineRenderer::getPlayer(int deck)
+{
+	return deck == 0 ? player1 : player2;
+}
+
+const juce::String& OfflineRenderer::getError() const
+{
+	return error;
+}
+
+double OfflineRenderer::getRenderedSeconds() const
+{
+	return renderedSeconds;
+}
+
+double OfflineRenderer::getRealtimeFactor() const
+{
+	return renderTime > 0.0 ? renderedSeconds / renderTime : 0.0;
+}
+
+bool OfflineRenderer::runFromCommandLine(const juce::String& commandLine, int& exitCode)
+{
+	const auto args = juce::StringArray::fromTokens(commandLine, true);
+	const int renderIndex = args.indexOf("--render");
+
+	if (renderIndex < 0)
+	{
+		return false;
+	}
+
+	exitCode = 1;
+
+	if (args.size() < renderIndex + 3)
+	{
+		juce::Logger::writeToLog("Usage: --render <script> <output.wav|output.flac> [--rate <sample rate>] [--block <block size>]");
+		return true;
+	}
+
+	auto getOption = [&args](const juce::String& name)
+		{
+			const int index = args.indexOf(name);
+			return index >= 0 ? args[index + 1].unquoted() : juce::String();
+		};
+
+	const double rate = getOption("--rate").getDoubleValue();
+	const int block = getOption("--block").getIntValue();
+
+	const auto workingFolder = juce::File::getCurrentWorkingDirectory();
+	const auto scriptFile = workingFolder.getChildFile(args[renderIndex + 1].unquoted());
+	const auto outputFile = workingFolder.getChildFile(args[renderIndex + 2].unquoted());
+
+	OfflineRenderer renderer(rate > 0.0 ? rate : 44100.0, block > 0 ? block : 512);
+
+	if (!renderer.loadScript(scriptFile) || !renderer.render(outputFile))
+	{
+		juce::Logger::writeToLog("Render failed: " + renderer.getError());
+		return true;
+	}
+
+	juce::Logger::writeToLog("Rendered " + juce::String(renderer.getRenderedSeconds(), 1) + " s to "
+		+ outputFile.getFullPathName() + " at " + juce::String(renderer.getRealtimeFactor(), 1) + "x real time");
+
+	exitCode = 0;
+	return true;
+}
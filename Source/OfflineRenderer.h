@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+	OfflineRenderer.h
+	Created: 24 Oct 2026 3:12:48pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "DJAudioPlayer.h"
+#include "SamplerEngine.h"
+#include "MixerEngine.h"
+
+/**
+ * OfflineRenderer class plays a scripted mix through both decks, the sound
+ * effect sampler and the mixer as fast as the machine allows, without an
+ * audio device, and writes the master output to a WAV or FLAC file.
+ *
+ * A script has one command per line: the time in seconds the command
+ * happens at, then the command. Blank lines and lines starting with # are
+ * skipped, paths with spaces are quoted, and relative paths are found from
+ * the script's folder.
+ *
+ *     0      load A "Tracks/First Track.mp3" 124
+ *     0      play A
+ *     0      crossfader 0
+ *     30     pads Packs/Drums
+ *     31.5   pad 1
+ *     60     crossfader 1
+ *     62     seek A 12.5
+ *     64     speed B 1.02
+ *     90     end
+ *
+ * The commands are load <deck> <file> [bpm], play, pause and stop <deck>,
+ * seek <deck> <seconds>, speed <deck> <ratio>, crossfader <0 to 1>,
+ * pads <folder>, pad <number from 1> and end. Without an end command the
+ * render stops a second after the last command.
+ *
+ * Commands happen at their exact sample and the decks wait for audio that
+ * is still being decoded, so a script renders the same file every time.
+ * The master limiter's latency is left out, so the file lines up with the
+ * script's times.
+ */
+class OfflineRenderer
+{
+public:
+	/**
+	 * Constructor for the OfflineRenderer class.
+	 *
+	 * @param sampleRate	The sample rate to render at.
+	 * @param blockSize		The most samples rendered in one block.
+	 */
+	OfflineRenderer(double sampleRate = 44100.0, int blockSize = 512);
+
+	/**
+	 * Destructor for the OfflineRenderer class.
+	 */
+	~OfflineRenderer();
+
+	/**
+	 * Reads and checks a script, replacing any loaded before.
+	 *
+	 * @param scriptFile	The script to read.
+	 * @return				True if every line could be read, otherwise see getError.
+	 */
+	bool loadScript(const juce::File& scriptFile);
+
+	/**
+	 * Renders the loaded script. Blocks until the whole file is written.
+	 * The format is picked from the file extension, FLAC for .flac and WAV
+	 * otherwise. An existing file is replaced. The decks keep their state
+	 * afterwards, so render each script with a new renderer.
+	 *
+	 * @param outputFile	The file to write.
+	 * @return				True if the file was written, otherwise see getError.
+	 */
+	bool render(const juce::File& outputFile);
+
+	/**
+	 * Returns why the last script or render failed.
+	 *
+	 * @return The error message.
+	 */
+	const juce::String& getError() const;
+
+	/**
+	 * Returns how long the last render was, in seconds of audio.
+	 *
+	 * @return The rendered length in seconds.
+	 */
+	double getRenderedSeconds() const;
+
+	/**
+	 * Returns how many times faster than real time the last render ran.
+	 *
+	 * @return The real time factor.
+	 */
+	double getRealtimeFactor() const;
+
+	/**
+	 * Renders a script if the command line asks for it, with
+	 * --render <script> <output> [--rate <sample rate>] [--block <block size>].
+	 *
+	 * @param commandLine	The application's command line.
+	 * @param exitCode		Set to 0 if the render succeeded, otherwise 1.
+	 * @return				True if the command line asked for a render.
+	 */
+	static bool runFromCommandLine(const juce::String& commandLine, int& exitCode);
+
+private:
+	/**
+	 * What a script command does.
+	 */
+	enum class CommandType
+	{
+		Load,
+		Play,
+		Pause,
+		Stop,
+		Seek,
+		Speed,
+		Crossfader,
+		Pads,
+		Pad,
+		End
+	};
+
+	/**
+	 * A script command, at the output sample it happens at.
+	 */
+	struct Command
+	{
+		juce::int64 sample = 0;
+		CommandType type = CommandType::End;
+		int deck = 0;
+		double value = 0.0;
+		juce::File file;
+	};
+
+	/**
+	 * Reads one line of a script into a command.
+	 *
+	 * @param line			The line's words.
+	 * @param folder		Folder relative paths are found from.
+	 * @param command		The command to fill in.
+	 * @return				An empty string if the line could be read, otherwise why not.
+	 */
+	juce::String parseCommand(const juce::StringArray& line, const juce::File& folder, Command& command) const;
+
+	/**
+	 * Carries out a command between two blocks.
+	 *
+	 * @param command		The command.
+	 */
+	void applyCommand(const Command& command);
+
+	/**
+	 * Returns a deck's player.
+	 *
+	 * @param deck		0 for deck A, 1 for deck B.
+	 * @return			The deck's player.
+	 */
+	DJAudioPlayer& getPlayer(int deck);
+
+	/**
+	 * Sample rate and most samples per block rendered.
+	 */
+	double sampleRate;
+	int blockSize;
+
+	/**
+	 * Decks, sampler and mixer, wired up as in the application.
+	 */
+	juce::AudioFormatManager formatManager;
+	DJAudioPlayer player1{ formatManager };
+	DJAudioPlayer player2{ formatManager };
+	SamplerEngine sampler;
+	MixerEngine mixerEngine{ player1, player2, sampler };
+
+	/**
+	 * The script's commands in time order, and the sample the render stops at.
+	 */
+	std::vector<Command> commands;
+	juce::int64 endSample = 0;
+
+	/**
+	 * Why the last script or render failed.
+	 */
+	juce::String error;
+
+	/**
+	 * Length of the last render and the time it took, in seconds.
+	 */
+	double renderedSeconds = 0.0;
+	double renderTime = 0.0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineRenderer)
+};
@@ -10,17 +10,22 @@
 
 #include <JuceHeader.h>
 #include "PlaylistComponent.h"
+#include <unordered_map>
+#include <unordered_set>
 
 //==============================================================================
 PlaylistComponent::PlaylistComponent(juce::AudioFormatManager& _formatManager, DeckGUI* _deckGUI1, DeckGUI* _deckGUI2)
 	: formatManager(_formatManager), deckGUI1(_deckGUI1), deckGUI2(_deckGUI2), customDesign()
 {
 	// Init setup and config of table component
-	tableComponent.getHeader().addColumn("d[^_^]b", 1, 50);
+	tableComponent.getHeader().addColumn("d[^_^]b", 1, 50, 30, -1, juce::TableHeaderComponent::notSortable);
 	tableComponent.getHeader().addColumn("TITLE", 2, 400);
+	tableComponent.getHeader().addColumn("ARTIST", 6, 200);
 	tableComponent.getHeader().addColumn("LENGTH", 3, 400);
 	tableComponent.getHeader().addColumn("AUDIO TYPE", 4, 100);
-	tableComponent.getHeader().addColumn("REMOVE", 5, 100);
+	tableComponent.getHeader().addColumn("LOUDNESS", 7, 100);
+	tableComponent.getHeader().addColumn("KEY", 8, 60);
+	tableComponent.getHeader().addColumn("REMOVE", 5, 100, 30, -1, juce::TableHeaderComponent::notSortable);
 
 	tableComponent.getHeader().setLookAndFeel(&customDesign);
 	tableComponent.setModel(this);
@@ -40,6 +45,41 @@ PlaylistComponent::PlaylistComponent(juce::AudioFormatManager& _formatManager, D
 	addAndMakeVisible(searchBar);
 	searchBar.addListener(this);
 	customDesign.searchBarDesign(searchBar);
+
+	// Add audio tracks once their metadata has been read in the background
+	trackImporter.onTracksImported = [this](const std::vector<TrackLibrary::TrackInfo>& importedTracks)
+		{
+			addImportedTracks(importedTracks);
+		};
+
+	// Store the loudness of audio tracks once they have been analysed
+	trackAnalyser.onTracksAnalysed = [this](const std::vector<TrackAnalyser::Analysis>& analyses)
+		{
+			applyTrackAnalyses(analyses);
+		};
+
+	// Store hot cues set on either deck with their audio track
+	for (auto* deckGUI : { deckGUI1, deckGUI2 })
+	{
+		if (deckGUI != nullptr)
+		{
+			deckGUI->onHotCueChanged = [this](const juce::URL& audioURL, int cueIndex, juce::int64 position)
+				{
+					// Audio tracks dropped straight onto a deck are not in the library
+					int trackIndex = trackLibrary.indexOfURL(audioURL.toString(false));
+					if (trackIndex >= 0)
+					{
+						trackLibrary.setHotCue(trackIndex, cueIndex, position);
+					}
+				};
+		}
+	}
+
+	// Follow audio tracks that are moved or deleted on disk
+	libraryWatcher.onFilesChanged = [this](const LibraryWatcher::Changes& changes)
+		{
+			applyLibraryChanges(changes);
+		};
 }
 
 PlaylistComponent::~PlaylistComponent()
@@ -74,15 +114,18 @@ void PlaylistComponent::resized()
 	tableComponent.setBounds(0, height * 2, getWidth(), height * 8);
 
 	tableComponent.getHeader().setColumnWidth(1, getWidth() * 0.1);
-	tableComponent.getHeader().setColumnWidth(2, getWidth() * 0.4);
-	tableComponent.getHeader().setColumnWidth(3, getWidth() * 0.18);
-	tableComponent.getHeader().setColumnWidth(4, getWidth() * 0.18);
-	tableComponent.getHeader().setColumnWidth(5, getWidth() * 0.14);
+	tableComponent.getHeader().setColumnWidth(2, getWidth() * 0.22);
+	tableComponent.getHeader().setColumnWidth(6, getWidth() * 0.14);
+	tableComponent.getHeader().setColumnWidth(3, getWidth() * 0.12);
+	tableComponent.getHeader().setColumnWidth(4, getWidth() * 0.1);
+	tableComponent.getHeader().setColumnWidth(7, getWidth() * 0.12);
+	tableComponent.getHeader().setColumnWidth(8, getWidth() * 0.08);
+	tableComponent.getHeader().setColumnWidth(5, getWidth() * 0.12);
 }
 
 int PlaylistComponent::getNumRows()
 {
-	return audioTracks.size();
+	return trackView.getNumRows();
 }
 
 void PlaylistComponent::paintRowBackground(juce::Graphics& g,
@@ -121,12 +164,29 @@ void PlaylistComponent::paintCell(juce::Graphics& g,
 	int height,
 	bool rowIsSelected)
 {
+	// Map the table row to the audio track shown in it
+	int trackIndex = trackView.getTrackIndex(rowNumber);
+	if (trackIndex < 0)
+	{
+		return;
+	}
+
 	juce::Font selectedFont = customDesign.getSelectedFont();
 	g.setFont(selectedFont);
 
 	if (columnID == 2)
 	{
-		g.drawText(audioTracks[rowNumber].getAudioTrackTitle(),
+		g.drawText(trackLibrary.getTitle(trackIndex),
+			2,
+			0,
+			width,
+			height,
+			juce::Justification::centredLeft,
+			true);
+	}
+	if (columnID == 6)
+	{
+		g.drawText(trackLibrary.getArtist(trackIndex),
 			2,
 			0,
 			width,
@@ -136,7 +196,8 @@ void PlaylistComponent::paintCell(juce::Graphics& g,
 	}
 	if (columnID == 3)
 	{
-		g.drawText(audioTracks[rowNumber].getAudioTrackLength(),
+		// Formatted only when painted
+		g.drawText(TrackLibrary::formatLength(trackLibrary.getLengthInSeconds(trackIndex)),
 			2,
 			0,
 			width,
@@ -146,7 +207,7 @@ void PlaylistComponent::paintCell(juce::Graphics& g,
 	}
 	if (columnID == 4)
 	{
-		g.drawText(audioTracks[rowNumber].getAudioFileType(),
+		g.drawText(TrackLibrary::getFormatName(trackLibrary.getFormat(trackIndex)),
 			2,
 			0,
 			width,
@@ -154,6 +215,70 @@ void PlaylistComponent::paintCell(juce::Graphics& g,
 			juce::Justification::centred,
 			true);
 	}
+	if (columnID == 7)
+	{
+		g.drawText(TrackLibrary::formatLoudness(trackLibrary.getLoudness(trackIndex)),
+			2,
+			0,
+			width,
+			height,
+			juce::Justification::centred,
+			true);
+	}
+	if (columnID == 8)
+	{
+		// Keys that mix well with a loaded audio track stand out
+		if (isHarmonicMatchForDecks(trackIndex))
+		{
+			g.setColour(juce::Colours::cyan);
+		}
+
+		g.drawText(KeyDetector::getCamelotCode(trackLibrary.getDetectedKey(trackIndex)),
+			2,
+			0,
+			width,
+			height,
+			juce::Justification::centred,
+			true);
+
+		g.setColour(juce::Colours::whitesmoke);
+	}
+}
+
+void PlaylistComponent::sortOrderChanged(int newSortColumnId, bool isForwards)
+{
+	TrackView::SortKey sortKey = TrackView::SortKey::None;
+
+	if (newSortColumnId == 2)
+	{
+		sortKey = TrackView::SortKey::Title;
+	}
+	if (newSortColumnId == 6)
+	{
+		sortKey = TrackView::SortKey::Artist;
+	}
+	if (newSortColumnId == 3)
+	{
+		sortKey = TrackView::SortKey::Length;
+	}
+	if (newSortColumnId == 4)
+	{
+		sortKey = TrackView::SortKey::Type;
+	}
+	if (newSortColumnId == 7)
+	{
+		sortKey = TrackView::SortKey::Loudness;
+	}
+	if (newSortColumnId == 8)
+	{
+		sortKey = TrackView::SortKey::Key;
+	}
+
+	// Only the view is reordered, the audio tracks stay where they are
+	trackView.setSortOrder(sortKey, isForwards);
+
+	tableComponent.updateContent();
+	tableComponent.repaint();
 }
 
 juce::Component* PlaylistComponent::refreshComponentForCell(int rowNumber,
@@ -223,12 +348,13 @@ juce::Component* PlaylistComponent::refreshRemoveButton(int rowNumber,
 		// Set up remove button design using CustomDesign
 		customDesign.removeButtonDesign(removeButton);
 
-		juce::String id{ std::to_string(rowNumber) };
-		removeButton->setComponentID(id);
 		removeButton->addListener(this);
 
 		existingComponentToUpdate = removeButton;
 	}
+
+	// Rows are reused as the search results change, so always refresh the row index
+	existingComponentToUpdate->setComponentID(juce::String(rowNumber));
 	return existingComponentToUpdate;
 }
 
@@ -265,11 +391,14 @@ void PlaylistComponent::buttonClicked(juce::Button* button)
 	// Remove selected track
 	if (button->getComponentID().isNotEmpty())
 	{
-		int id = button->getComponentID().getIntValue();
-		DBG("< REMOVE > button was clicked << Removing audio track: " << audioTracks[id].getAudioTrackTitle() << " >> ");
-		removeSelectedTrack(id);
+		int id = trackView.getTrackIndex(button->getComponentID().getIntValue());
+		if (id >= 0)
+		{
+			DBG("< REMOVE > button was clicked << Removing audio track: " << trackLibrary.getTitle(id) << " >> ");
+			removeSelectedTrack(id);
 
-		tableComponent.updateContent();
+			refreshSearchCandidates();
+		}
 	}
 
 }
@@ -277,124 +406,256 @@ void PlaylistComponent::buttonClicked(juce::Button* button)
 // Import Audio Track
 void PlaylistComponent::importAudioTrack(const juce::File& audioTrackFile)
 {
-	// Retrieve the title, URL, and length of audio track
-	juce::String audioTrackTitle = getAudioTrackTitle(audioTrackFile);
-	juce::String audioTrackURL = getAudioTrackURL(audioTrackFile);
-	juce::String audioTrackLength = getFormattedAudioTrackLength(juce::URL(audioTrackURL));
-	juce::String audioFileType = getAudioFileType(audioTrackFile);
+	// Retrieve the tags, length, and format of audio track in the background
+	trackImporter.importFile(audioTrackFile);
+}
 
-	// Check if the audio track hasn't imported yet
-	if (!audioTrackExist(audioTrackTitle))
-	{
-		// Then push it into the new AudioTeack instance
-		AudioTrack uniqueAudioTrack{ audioTrackTitle, audioTrackURL , audioTrackLength, audioFileType};
-		audioTracks.push_back(uniqueAudioTrack);
+// Import every audio track inside a folder
+void PlaylistComponent::importAudioFolder(const juce::File& folder)
+{
+	importedRootFolders.addIfNotAlreadyThere(folder);
+	libraryWatcher.watchFolder(folder, true);
 
-		// Update the table component, reflecting changes
-		tableComponent.updateContent();
-	}
-	else
+	// Its parent too, so renaming the folder is followed
+	libraryWatcher.watchFolder(folder.getParentDirectory(), false);
+
+	for (const auto& audioTrackFile : folder.findChildFiles(juce::File::findFiles, true, formatManager.getWildcardForAllFormats()))
 	{
-		// If the track already imported, prompt this message
-		DBG("< The audio track: << " << audioTrackTitle << " >> has already been imported >");
+		importAudioTrack(audioTrackFile);
 	}
-	// Update the table component regardless the track was added or not
-	tableComponent.updateContent();
 }
 
-// Extract audio track title
-juce::String PlaylistComponent::getAudioTrackTitle(const juce::File& audioTrackFile)
+// Apply file changes reported by the library watcher
+void PlaylistComponent::applyLibraryChanges(const LibraryWatcher::Changes& changes)
 {
-	juce::String fileName = audioTrackFile.getFileNameWithoutExtension();
+	bool libraryChanged = false;
 
-	// Find the pos of the last "-"
-	int dash = fileName.indexOf("-");
+	// Imported folders that moved keep picking up new audio tracks
+	for (const auto& movedFile : changes.movedFiles)
+	{
+		for (auto& rootFolder : importedRootFolders)
+		{
+			if (rootFolder == movedFile.first || rootFolder.isAChildOf(movedFile.first))
+			{
+				rootFolder = movedFile.second.getChildFile(rootFolder.getRelativePathFrom(movedFile.first));
+			}
+		}
+	}
 
-	if (dash != -1 && dash < fileName.length() - 1)
+	if (!changes.movedFiles.empty() || !changes.removedFiles.isEmpty())
 	{
-		// Extract the title starting from the character after "-"
-		return fileName.substring(dash + 1).trim();
+		// Paths looked up by name, so each audio track's file is read once
+		std::unordered_map<juce::String, juce::File> movedPaths;
+		std::unordered_set<juce::String> removedPaths;
+
+		for (const auto& movedFile : changes.movedFiles)
+		{
+			movedPaths[movedFile.first.getFullPathName()] = movedFile.second;
+		}
+
+		for (const auto& removedFile : changes.removedFiles)
+		{
+			removedPaths.insert(removedFile.getFullPathName());
+		}
+
+		const int numTracks = trackLibrary.getNumTracks();
+		std::vector<bool> shouldRemove(static_cast<size_t>(numTracks), false);
+		bool anyRemoved = false;
+
+		for (int trackIndex = 0; trackIndex < numTracks; ++trackIndex)
+		{
+			juce::File audioTrackFile = trackLibrary.getFile(trackIndex);
+
+			// Relocate audio tracks that moved, or whose folder did, the closest entry winning
+			for (juce::File path = audioTrackFile; !movedPaths.empty(); path = path.getParentDirectory())
+			{
+				auto moved = movedPaths.find(path.getFullPathName());
+
+				if (moved != movedPaths.end())
+				{
+					juce::File newFile = moved->second.getChildFile(audioTrackFile.getRelativePathFrom(path));
+
+					DBG("< Audio track moved << " << audioTrackFile.getFullPathName() << " >> to << " << newFile.getFullPathName() << " >> >");
+					trackLibrary.relocateTrack(trackIndex, juce::URL{ newFile }.toString(false));
+					audioTrackFile = newFile;
+					libraryChanged = true;
+					break;
+				}
+
+				if (path == path.getParentDirectory())
+				{
+					break;
+				}
+			}
+
+			// Remove audio tracks that were deleted, or whose folder was
+			for (juce::File path = audioTrackFile; !removedPaths.empty(); path = path.getParentDirectory())
+			{
+				if (removedPaths.count(path.getFullPathName()) > 0)
+				{
+					DBG("< Audio track deleted << " << audioTrackFile.getFullPathName() << " >> >");
+					shouldRemove[static_cast<size_t>(trackIndex)] = true;
+					anyRemoved = true;
+					break;
+				}
+
+				if (path == path.getParentDirectory())
+				{
+					break;
+				}
+			}
+		}
+
+		if (anyRemoved)
+		{
+			trackLibrary.removeTracks(shouldRemove);
+			libraryChanged = true;
+		}
 	}
-	else
+
+	// Import new audio tracks that appear inside imported folders
+	for (const auto& addedFile : changes.addedFiles)
 	{
-		// Return the file name without extension if no "-" found or if it's the last character
-		return fileName;
+		bool insideImportedFolder = false;
+		for (const auto& rootFolder : importedRootFolders)
+		{
+			insideImportedFolder = insideImportedFolder || addedFile.isAChildOf(rootFolder);
+		}
+
+		if (!insideImportedFolder)
+		{
+			continue;
+		}
+
+		if (addedFile.isDirectory())
+		{
+			for (const auto& audioTrackFile : addedFile.findChildFiles(juce::File::findFiles, true, formatManager.getWildcardForAllFormats()))
+			{
+				importAudioTrack(audioTrackFile);
+			}
+		}
+		else if (formatManager.findFormatForFileExtension(addedFile.getFileExtension()) != nullptr)
+		{
+			importAudioTrack(addedFile);
+		}
 	}
-}
 
-// Extract audio track URL
-juce::String PlaylistComponent::getAudioTrackURL(const juce::File& audioTrackFile)
-{
-	return juce::URL{ audioTrackFile }.toString(false);
+	// Update the table component once for the whole batch
+	if (libraryChanged)
+	{
+		refreshSearchCandidates();
+	}
 }
 
-// Extract audio track length
-juce::String PlaylistComponent::getFormattedAudioTrackLength(const juce::URL& audioURL)
+// Add the audio tracks read by the importer
+void PlaylistComponent::addImportedTracks(const std::vector<TrackLibrary::TrackInfo>& importedTracks)
 {
-    // Create an AudioFormatReader for each audio track URL
-    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(audioURL.createInputStream(false)));
-
-    if (reader != nullptr) {
-        // Get the length of the audio track in seconds
-        double audioLengthInSeconds = reader->lengthInSamples / static_cast<double>(reader->sampleRate);
-
-		// Convert to hours, minutes, and seconds
-        int hours = static_cast<int>(audioLengthInSeconds / 3600);
-        int minutes = static_cast<int>((audioLengthInSeconds - hours * 3600) / 60);
-        int seconds = static_cast<int>(audioLengthInSeconds - hours * 3600 - minutes * 60);
-
-        // Format the track length as hour:minute:second
-        return juce::String::formatted("%02d : %02d : %02d", hours, minutes, seconds);
-    }
-    else {
-        // Return default value if error occur
-        return "00:00:00";
-    }
+	for (const auto& trackInfo : importedTracks)
+	{
+		// Check if the audio track hasn't imported yet
+		if (!audioTrackExist(trackInfo.url))
+		{
+			// Then add it into the track library
+			trackLibrary.addTrack(trackInfo);
+
+			// And follow its file if it is moved or deleted, and its folder if that is renamed
+			const juce::File folder = juce::URL(trackInfo.url).getLocalFile().getParentDirectory();
+			libraryWatcher.watchFolder(folder, false);
+			libraryWatcher.watchFolder(folder.getParentDirectory(), false);
+
+			// Then measure its loudness in the background
+			trackAnalyser.analyseFile(juce::URL(trackInfo.url).getLocalFile());
+		}
+		else
+		{
+			// If the track already imported, prompt this message
+			DBG("< The audio track: << " << trackInfo.title << " >> has already been imported >");
+		}
+	}
+
+	// Make the new tracks searchable and update the table component once for the whole batch
+	refreshSearchCandidates();
 }
 
-juce::String PlaylistComponent::getAudioFileType(const juce::File& audioTrackFile)
+// Store the analyses of audio tracks still in the playlist
+void PlaylistComponent::applyTrackAnalyses(const std::vector<TrackAnalyser::Analysis>& analyses)
 {
-	// Get file extension
-	juce::String fileExtension = audioTrackFile.getFileExtension();
+	for (const auto& analysis : analyses)
+	{
+		// Audio tracks removed or moved while being analysed are skipped
+		int trackIndex = trackLibrary.indexOfURL(analysis.url);
+		if (trackIndex < 0)
+		{
+			continue;
+		}
 
-	// Convert to upper case for consistency
-	fileExtension = fileExtension.toUpperCase();
+		trackLibrary.setLoudness(trackIndex, analysis.loudness);
+		trackLibrary.setDetectedKey(trackIndex, analysis.key);
 
-	// Remove dot
-	if (fileExtension.startsWithChar('.'))
-	{
-		fileExtension = fileExtension.substring(1);
+		// Trim the audio track straight away if it is already on a deck
+		for (auto* deckGUI : { deckGUI1, deckGUI2 })
+		{
+			if (deckGUI != nullptr)
+			{
+				deckGUI->setTrackLoudness(juce::URL(analysis.url), analysis.loudness);
+			}
+		}
 	}
 
-	// Return audio file type
-	return fileExtension;
+	// Sorting and searching by loudness or key must see the new values
+	refreshSearchCandidates();
 }
 
-
-// Chekcs if audio track with same title already exists in the playlist.
-bool PlaylistComponent::audioTrackExist(const juce::String& importedTrackTitle) const
+// Compare the audio track's key with the keys loaded on the decks
+bool PlaylistComponent::isHarmonicMatchForDecks(int trackIndex)
 {
-	// Store the titles of imported audio tracks in a set
-	std::unordered_set<juce::String> audioTrackTitles;
+	const int key = trackLibrary.getDetectedKey(trackIndex);
+	const DeckGUI* decks[] = { deckGUI1, deckGUI2 };
 
-	// Populate with existing track titles
-	for (const auto& track : audioTracks)
+	for (size_t deck = 0; deck < deckKeys.size(); ++deck)
 	{
-		audioTrackTitles.insert(track.getAudioTrackTitle());
+		if (decks[deck] == nullptr)
+		{
+			continue;
+		}
+
+		auto& deckKey = deckKeys[deck];
+
+		if (!deckKey.valid || deckKey.url != decks[deck]->getLoadedURL())
+		{
+			// Audio tracks dropped straight onto a deck are not in the library
+			deckKey.url = decks[deck]->getLoadedURL();
+			deckKey.trackIndex = trackLibrary.indexOfURL(deckKey.url.toString(false));
+			deckKey.key = deckKey.trackIndex >= 0 ? trackLibrary.getDetectedKey(deckKey.trackIndex) : KeyDetector::unknownKey;
+			deckKey.valid = true;
+		}
+
+		if (deckKey.trackIndex >= 0 && deckKey.trackIndex != trackIndex
+			&& KeyDetector::isHarmonicMatch(deckKey.key, key))
+		{
+			return true;
+		}
 	}
 
-	// Check if the imported track title exists.
-	return audioTrackTitles.find(importedTrackTitle) != audioTrackTitles.end();
+	return false;
+}
+
+// Chekcs if audio track with same file already exists in the playlist.
+bool PlaylistComponent::audioTrackExist(const juce::String& importedTrackURL) const
+{
+	// Check if the imported track file exists.
+	return trackLibrary.containsURL(importedTrackURL);
 }
 
 // Loads selected track to specified track.
 void PlaylistComponent::loadTrackToDeck(DeckGUI* deckGUI, int selectedRow)
 {
 	// Ensure selected track index is within valid range.
-	if (selectedRow < audioTracks.size())
+	int trackIndex = trackView.getTrackIndex(selectedRow);
+	if (trackIndex >= 0)
 	{
 		// Retrieve title.
-		juce::String audioTrackTitle = audioTracks[selectedRow].getAudioTrackTitle();
+		juce::String audioTrackTitle = trackLibrary.getTitle(trackIndex);
 
 		// Printing message indicating the chosen deck (A or B) and the title of 
 		// the selected track intended for loading.
@@ -409,11 +670,15 @@ void PlaylistComponent::loadTrackToDeck(DeckGUI* deckGUI, int selectedRow)
 		if (deckGUI != nullptr)
 		{
 			// Get the URL of the selected audio track.
-			juce::String audioURLString = audioTracks[selectedRow].getAudioTrackURL();
+			juce::String audioURLString = trackLibrary.getURL(trackIndex);
 			juce::URL audioURL(audioURLString);
 
 			// Load to specified deck.
-			deckGUI->loadToPlaylist(audioURL);
+			deckGUI->loadToPlaylist(audioURL, trackLibrary.getBpm(trackIndex), &trackLibrary.getHotCues(trackIndex));
+			deckGUI->setTrackLoudness(audioURL, trackLibrary.getLoudness(trackIndex));
+
+			// Highlight the keys that mix with the new audio track
+			tableComponent.repaint();
 		}
 		else
 		{
@@ -441,7 +706,15 @@ void PlaylistComponent::filesDropped(const juce::StringArray& files, int x, int
 	for (const auto& file : files)
 	{
 		juce::File audioTrackFile{ file };
-		importAudioTrack(audioTrackFile);
+
+		if (audioTrackFile.isDirectory())
+		{
+			importAudioFolder(audioTrackFile);
+		}
+		else
+		{
+			importAudioTrack(audioTrackFile);
+		}
 	}
 }
 
@@ -449,31 +722,90 @@ void PlaylistComponent::filesDropped(const juce::StringArray& files, int x, int
 void PlaylistComponent::removeSelectedTrack(int id)
 {
 	// Erase the audio track at the specified index
-	audioTracks.erase(audioTracks.begin() + id);
+	trackLibrary.removeTrack(id);
 }
 
 // Searches for the particular audio track in the playlist.
 void PlaylistComponent::textEditorTextChanged(juce::TextEditor& searchText)
 {
-	// Get the text in the search bar, trim whitespace, and convert to uppercase
-	auto searchQuery = searchText.getText().trim().toUpperCase();
-	
-	// If search query is empty after trimming whitespace, deselect all rows
-	if (searchQuery.isEmpty()) {
+	updateVisibleTracks();
+
+	// Highlight the best match, or deselect all rows if nothing matches
+	if (searchText.getText().trim().isNotEmpty() && trackView.getNumRows() > 0)
+	{
+		tableComponent.selectRow(0);
+	}
+	else
+	{
 		tableComponent.deselectAllRows();
-		return;
 	}
+}
 
-	// Find the first matching track
-	for (int trackIndex = 0; trackIndex < audioTracks.size(); ++trackIndex)
+// Shows the ranked search results, or every audio track when not searching.
+void PlaylistComponent::updateVisibleTracks()
+{
+	auto searchQuery = searchBar.getText().trim();
+
+	if (searchQuery.isEmpty())
 	{
-		if (audioTracks[trackIndex].getAudioTrackTitle().containsIgnoreCase(searchQuery))
+		// Show every audio track
+		trackView.clearFilter();
+	}
+	else
+	{
+		// Show matching audio tracks, ordered by score unless a column is sorted
+		std::vector<int> matches;
+		for (const auto& result : trackSearch.search(searchQuery))
+		{
+			matches.push_back(result.index);
+		}
+		trackView.setFilter(matches);
+	}
+
+	tableComponent.updateContent();
+	tableComponent.repaint();
+}
+
+// Reloads the searchable text whenever the playlist changes.
+void PlaylistComponent::refreshSearchCandidates()
+{
+	juce::StringArray searchableText;
+
+	// Search the title first, then the tags, the tempo, the key and its Camelot code
+	for (int trackIndex = 0; trackIndex < trackLibrary.getNumTracks(); ++trackIndex)
+	{
+		juce::String text = trackLibrary.getTitle(trackIndex) + " "
+			+ trackLibrary.getArtist(trackIndex) + " "
+			+ trackLibrary.getAlbum(trackIndex) + " "
+			+ trackLibrary.getGenre(trackIndex);
+
+		const float bpm = trackLibrary.getBpm(trackIndex);
+		if (bpm > 0.0f)
+		{
+			text << " " << juce::roundToInt(bpm);
+		}
+
+		if (trackLibrary.getKey(trackIndex).isNotEmpty())
+		{
+			text << " " << trackLibrary.getKey(trackIndex);
+		}
+
+		const int detectedKey = trackLibrary.getDetectedKey(trackIndex);
+		if (detectedKey != KeyDetector::unknownKey)
 		{
-			// Select the row when a match is found
-			tableComponent.selectRow(trackIndex);
-			return;
+			text << " " << KeyDetector::getCamelotCode(detectedKey);
 		}
+
+		searchableText.add(text);
+	}
+
+	// Indexes and keys of the decks' audio tracks may have changed
+	for (auto& deckKey : deckKeys)
+	{
+		deckKey.valid = false;
 	}
-	// Deselect all rows if no match is found
-	tableComponent.deselectAllRows();
+
+	trackSearch.setCandidates(searchableText);
+	trackView.tracksChanged();
+	updateVisibleTracks();
 }
@@ -11,12 +11,23 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include <string>
 #include <vector>
-#include "AudioTrack.h"
+#include "TrackLibrary.h"
 #include "DeckGUI.h"
 #include "CustomDesign.h"
 #include "DJAudioPlayer.h"
+#include "TrackSearch.h"
+#include "TrackView.h"
+#include "TrackImporter.h"
+#include "TrackAnalyser.h"
+#include "LibraryWatcher.h"
+#include "KeyDetector.h"
+
+// Hot cues are handed between the library and the decks as is
+static_assert(std::is_same<TrackLibrary::HotCues, DJAudioPlayer::HotCues>::value,
+	"TrackLibrary and DJAudioPlayer must store the same number of hot cues");
 
 /**
  * PlaylistComponent class represent a GUI component for managing audio tracks 
@@ -101,6 +112,15 @@ public:
 		int height,
 		bool rowIsSelected) override;
 
+	/**
+	 * TableListBoxModel virtual functions.
+	 * Called when a column header is clicked to sort the PlaylistComponent.
+	 *
+	 * @param newSortColumnId		Column ID to sort by.
+	 * @param isForwards			True for ascending, false for descending.
+	 */
+	void sortOrderChanged(int newSortColumnId, bool isForwards) override;
+
 	/**
 	 * Refreshes component cell in the PlaylistComponent.
 	 *
@@ -156,7 +176,8 @@ public:
 	/**
 	 * When files are drag and drop onto the PlaylistComponent, it will iterates 
 	 * through the string array of selected dropped file and imports each of the
-	 * audio track into PlaylistComponent.
+	 * audio track into PlaylistComponent. Dropped folders are imported with all
+	 * their audio tracks and kept in sync as files are added to them.
 	 * 
 	 * @param files		Array of file that have been dropped onto the PlaylistComponent.
 	 * @param x			The x-coordinate of the drop location.
@@ -175,52 +196,63 @@ private:
 	// Import audio track
 	/**
 	 * Imports audio track specified by the given file.
-	 * Then, retrieves the track's title, URL, and length, and adds it to the playlist if it's unique.
-	 * Finally, updates the table component to reflect the changes.
+	 * The track's tags, length, and format are read on a background worker,
+	 * then addImportedTracks adds it to the playlist.
 	 *
 	 * @param audioTrackFile		The file representing the audio track to import.
 	 */
 	void importAudioTrack(const juce::File& audioTrackFile);
 
 	/**
-	 * Extracts audio track's title from the provided file.
+	 * Imports every audio track inside the folder and watches it for new,
+	 * removed, and moved audio tracks.
 	 *
-	 * @param audioTrackFile		The file representing the audio track.
-	 * @return						The audio track's title.
+	 * @param folder				The folder to import.
 	 */
-	juce::String getAudioTrackTitle(const juce::File& audioTrackFile);
+	void importAudioFolder(const juce::File& folder);
 
 	/**
-	 * Extracts audio track's URL from the provided file.
+	 * Applies a batch of file changes reported by the library watcher.
+	 * Moved audio tracks are relocated, deleted ones are removed, and new
+	 * files inside imported folders are imported.
 	 *
-	 * @param audioTrackFile		The file representing the audio track.
-	 * @return						The audio track's URL.
+	 * @param changes				The coalesced file changes.
 	 */
-	juce::String getAudioTrackURL(const juce::File& audioTrackFile);
+	void applyLibraryChanges(const LibraryWatcher::Changes& changes);
 
 	/**
-	 * Retrieves the formatted length of the audio track specified by the URL.
+	 * Adds the audio tracks read by the importer to the playlist if they are unique.
+	 * Finally, updates the table component to reflect the changes.
 	 *
-	 * @param audioURL				The audio track's URL.
-	 * @return						The formatted length of the audio track in "hour:minute:second" format.
+	 * @param importedTracks		The imported audio tracks' metadata.
 	 */
-	juce::String getFormattedAudioTrackLength(const juce::URL& audioURL);
+	void addImportedTracks(const std::vector<TrackLibrary::TrackInfo>& importedTracks);
 
 	/**
-	 * Extracts audio track's type from the provided file.
+	 * Stores the analyses of audio tracks still in the playlist and passes
+	 * their loudness to any deck they are loaded on.
 	 *
-	 * @param audioTrackFile		The file representing the audio track.
-	 * @return						The audio track's type.
+	 * @param analyses				The audio tracks' analyses.
 	 */
-	juce::String getAudioFileType(const juce::File& audioTrackFile);
+	void applyTrackAnalyses(const std::vector<TrackAnalyser::Analysis>& analyses);
 
 	/**
-	 * Checks if the audio track with the given title already exists in the playlist.
+	 * Checks if an audio track's key mixes harmonically with the key of the
+	 * audio track loaded on either deck. The decks' keys are looked up once
+	 * per audio track loaded, not for every cell painted.
 	 *
-	 * @param importedTrackTitle	The audio track's title to check.
+	 * @param trackIndex			The audio track's index.
+	 * @return						True if the keys are next to each other on the Camelot wheel.
+	 */
+	bool isHarmonicMatchForDecks(int trackIndex);
+
+	/**
+	 * Checks if the audio track with the given URL already exists in the playlist.
+	 *
+	 * @param importedTrackURL		The audio track's URL to check.
 	 * @return						True if the audio track exists; otherwise, False.
 	 */
-	bool audioTrackExist(const juce::String& importedTrackTitle) const;
+	bool audioTrackExist(const juce::String& importedTrackURL) const;
 
 	/**
 	 * Loads selected audio track onto the specified deck.
@@ -240,21 +272,63 @@ private:
 	/**
 	 * TextEditor::Listener
 	 * Called when the text within the text editor changes.
-	 * Searches for specified title in the playlist.
-	 * Highlight the first matching title.
+	 * Fuzzy searches the playlist and shows the matching titles ranked by score.
+	 * Highlight the best matching title.
 	 * Deselect all tracks if no match is found.
 	 *
 	 * @param searchText			Reference to the text editor containing the search query.
 	 */
 	void textEditorTextChanged(juce::TextEditor& searchText) override;
 
+	/**
+	 * Rebuilds the rows shown in the table from the current search query.
+	 * Shows every audio track in playlist order when the query is empty.
+	 */
+	void updateVisibleTracks();
+
+	/**
+	 * Reloads the track titles and tags into the fuzzy search after the playlist changes,
+	 * then refreshes the visible rows.
+	 */
+	void refreshSearchCandidates();
+
 	juce::AudioFormatManager& formatManager;
 	juce::TableListBox tableComponent;
 	
 	/** 
-	 * Vector to store relevant metadata of each audio track.
+	 * Column store of the relevant metadata of each audio track.
+	 */
+	TrackLibrary trackLibrary;
+
+	/**
+	 * Filtered and sorted view mapping each table row to an audio track.
+	 */
+	TrackView trackView{ trackLibrary };
+
+	/**
+	 * Fuzzy search ranking for the search bar.
+	 */
+	TrackSearch trackSearch;
+
+	/**
+	 * Reads imported audio tracks' metadata on background workers.
+	 */
+	TrackImporter trackImporter{ formatManager };
+
+	/**
+	 * Measures imported audio tracks' loudness and key on background workers.
 	 */
-	std::vector<AudioTrack> audioTracks;
+	TrackAnalyser trackAnalyser{ formatManager };
+
+	/**
+	 * Keeps the playlist in sync with the audio tracks' folders.
+	 */
+	LibraryWatcher libraryWatcher;
+
+	/**
+	 * Folders imported as a whole, new audio tracks in them are imported automatically.
+	 */
+	juce::Array<juce::File> importedRootFolders;
 
 	/** 
 	 * Select audio track files.
@@ -283,6 +357,19 @@ private:
 	 */
 	DeckGUI* deckGUI1; 
 	DeckGUI* deckGUI2;
+
+	/**
+	 * Audio track loaded on each deck, with its index and key in the playlist.
+	 * Looked up again when the deck loads another audio track or the playlist changes.
+	 */
+	struct DeckKey
+	{
+		juce::URL url;
+		int trackIndex = -1;
+		int key = KeyDetector::unknownKey;
+		bool valid = false;
+	};
+	std::array<DeckKey, 2> deckKeys;
 	
 	/**
 	 * Pointer to DJAudioPlater
@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+	RecorderGUI.cpp
+	Created: 24 Oct 2026 11:02:15am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "RecorderGUI.h"
+
+RecorderGUI::RecorderGUI(MixRecorder& _recorder)
+	: recorder(_recorder)
+{
+	// Record switch, red while recording
+	addAndMakeVisible(recordButton);
+	recordButton.addListener(this);
+	recordButton.setTooltip("Record the master output");
+	recordButton.setColour(juce::TextButton::buttonColourId, juce::Colours::transparentBlack);
+	recordButton.setColour(juce::TextButton::buttonOnColourId, juce::Colours::red.withAlpha(0.8f));
+	recordButton.setColour(juce::TextButton::textColourOffId, juce::Colours::cyan);
+	recordButton.setColour(juce::TextButton::textColourOnId, juce::Colours::white);
+	recordButton.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+
+	// File format of the next recording
+	addAndMakeVisible(formatButton);
+	formatButton.addListener(this);
+	formatButton.setTooltip("Record to WAV or FLAC");
+	formatButton.setColour(juce::TextButton::buttonColourId, juce::Colours::transparentBlack);
+	formatButton.setColour(juce::TextButton::textColourOffId, juce::Colours::cyan);
+	formatButton.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+
+	addAndMakeVisible(statusLabel);
+	statusLabel.setTooltip("Recording length and blocks dropped because the disk fell behind");
+	statusLabel.setColour(juce::Label::textColourId, juce::Colours::cyan);
+	statusLabel.setJustificationType(juce::Justification::centredLeft);
+}
+
+RecorderGUI::~RecorderGUI()
+{
+	stopTimer();
+}
+
+void RecorderGUI::resized()
+{
+	float buttonW = getHeight() * 1.5f;
+
+	recordButton.setBounds(0, 0, buttonW, getHeight());
+	formatButton.setBounds(buttonW * 1.1f, 0, buttonW, getHeight());
+	statusLabel.setBounds(buttonW * 2.2f, 0, getWidth() - buttonW * 2.2f, getHeight());
+	statusLabel.setFont(customDesign.getSelectedFont().withHeight(getHeight() * 0.5f));
+}
+
+void RecorderGUI::buttonClicked(juce::Button* button)
+{
+	if (button == &recordButton)
+	{
+		if (recorder.isRecording())
+		{
+			recorder.stopRecording();
+			stopTimer();
+
+			DBG("< REC > button was clicked << Saved " << recorder.getFile().getFullPathName() << " >>");
+		}
+		else
+		{
+			juce::File folder = juce::File::getSpecialLocation(juce::File::userMusicDirectory).getChildFile("Otodecks Recordings");
+			folder.createDirectory();
+
+			juce::File file = folder.getChildFile("Mix " + juce::Time::getCurrentTime().formatted("%Y-%m-%d %H-%M-%S")
+				+ MixRecorder::getFileExtension(format));
+
+			if (!recorder.startRecording(file, format))
+			{
+				statusLabel.setText("CANNOT RECORD", juce::dontSendNotification);
+				statusLabel.setColour(juce::Label::textColourId, juce::Colours::red);
+				return;
+			}
+
+			DBG("< REC > button was clicked << Recording to " << file.getFullPathName() << " >>");
+			startTimer(200);
+		}
+
+		recordButton.setToggleState(recorder.isRecording(), juce::dontSendNotification);
+		formatButton.setEnabled(!recorder.isRecording());
+		updateStatus();
+	}
+	else if (button == &formatButton)
+	{
+		format = (format == MixRecorder::Format::WAV) ? MixRecorder::Format::FLAC : MixRecorder::Format::WAV;
+		formatButton.setButtonText(format == MixRecorder::Format::WAV ? "WAV" : "FLAC");
+	}
+}
+
+void RecorderGUI::timerCallback()
+{
+	updateStatus();
+}
+
+void RecorderGUI::updateStatus()
+{
+	if (recorder.getFile() == juce::File())
+	{
+		statusLabel.setText({}, juce::dontSendNotification);
+		return;
+	}
+
+	const int seconds = static_cast<int>(recorder.getRecordedSeconds());
+	const int dropped = recorder.getNumDroppedBlocks();
+
+	statusLabel.setText(juce::String::formatted("%02d:%02d  DROP %d", seconds / 60, seconds % 60, dropped),
+		juce::dontSendNotification);
+
+	// Dropped blocks are gaps in the recording
+	statusLabel.setColour(juce::Label::textColourId, dropped > 0 ? juce::Colours::red : juce::Colours::cyan);
+}
@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+	RecorderGUI.h
+	Created: 24 Oct 2026 11:02:15am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "MixRecorder.h"
+#include "CustomDesign.h"
+
+/**
+ * RecorderGUI class holds the controls of the mix recorder: the REC
+ * button, a button choosing WAV or FLAC, and the length of the recording
+ * with the number of blocks dropped so far.
+ *
+ * Recordings are saved to "Otodecks Recordings" in the user's music folder,
+ * named by the time they started.
+ */
+class RecorderGUI : public juce::Component,
+	public juce::Button::Listener,
+	public juce::Timer
+{
+public:
+	/**
+	 * Constructor for the RecorderGUI class.
+	 *
+	 * @param _recorder		Reference to the mix recorder.
+	 */
+	RecorderGUI(MixRecorder& _recorder);
+
+	/**
+	 * Destructor for the RecorderGUI class.
+	 */
+	~RecorderGUI() override;
+
+	/**
+	 * Resizes and positions the controls.
+	 */
+	void resized() override;
+
+	/**
+	 * Button::Listener
+	 * Starts or stops recording, or switches the file format.
+	 *
+	 * @param button	Pointer to the button that was clicked.
+	 */
+	void buttonClicked(juce::Button* button) override;
+
+	/**
+	 * Timer
+	 * Updates the recording length and dropped blocks.
+	 */
+	void timerCallback() override;
+
+private:
+	/**
+	 * Shows the recorder's state in the status label.
+	 */
+	void updateStatus();
+
+	/**
+	 * Reference to the mix recorder.
+	 */
+	MixRecorder& recorder;
+
+	/**
+	 * Format of the next recording.
+	 */
+	MixRecorder::Format format = MixRecorder::Format::WAV;
+
+	juce::TextButton recordButton{ "REC" };
+	juce::TextButton formatButton{ "WAV" };
+	juce::Label statusLabel;
+
+	/**
+	 * Custom design for the status font.
+	 */
+	CustomDesign customDesign;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RecorderGUI)
+};
@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+	SamplePack.cpp
+	Created: 19 Oct 2026 2:15:48pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "SamplePack.h"
+
+SamplePack::SamplePack(const juce::String& _name)
+	: name(_name)
+{
+
+}
+
+SamplePack::Ptr SamplePack::loadFromFolder(juce::AudioFormatManager& formatManager, const juce::File& folder)
+{
+	juce::Array<juce::File> padFiles = folder.findChildFiles(juce::File::findFiles, false,
+		formatManager.getWildcardForAllFormats());
+
+	// Pads are laid out in file name order
+	juce::File::NaturalFileComparator comparator(false);
+	padFiles.sort(comparator);
+
+	SamplePack::Ptr pack = new SamplePack(folder.getFileName());
+	pack->pads.reserve(static_cast<size_t>(padFiles.size()));
+
+	for (const juce::File& padFile : padFiles)
+	{
+		std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(padFile));
+
+		if (reader == nullptr)
+		{
+			DBG("Error: Sound effect cannot be decoded: " << padFile.getFullPathName());
+			continue;
+		}
+
+		if (reader->lengthInSamples > static_cast<juce::int64>(reader->sampleRate * maxPadLengthInSeconds))
+		{
+			DBG("Error: Sound effect is too long to load as a pad: " << padFile.getFullPathName());
+			continue;
+		}
+
+		// Decode the whole file once, so triggering never touches the disk
+		Pad pad;
+		pad.name = padFile.getFileNameWithoutExtension();
+		pad.sampleRate = reader->sampleRate;
+		pad.buffer.setSize(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+		reader->read(&pad.buffer, 0, static_cast<int>(reader->lengthInSamples), 0, true, true);
+
+		pack->pads.push_back(std::move(pad));
+	}
+
+	if (pack->pads.empty())
+	{
+		DBG("Error: No sound effects found in: " << folder.getFullPathName());
+		return nullptr;
+	}
+
+	return pack;
+}
+
+const juce::String& SamplePack::getName() const
+{
+	return name;
+}
+
+int SamplePack::getNumPads() const
+{
+	return static_cast<int>(pads.size());
+}
+
+const SamplePack::Pad& SamplePack::getPad(int padIndex) const
+{
+	return pads[static_cast<size_t>(padIndex)];
+}
+
+size_t SamplePack::getMemoryUsage() const
+{
+	size_t bytes = 0;
+
+	for (const auto& pad : pads)
+	{
+		bytes += static_cast<size_t>(pad.buffer.getNumChannels()) * static_cast<size_t>(pad.buffer.getNumSamples()) * sizeof(float);
+	}
+
+	return bytes;
+}
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+	SamplePack.h
+	Created: 19 Oct 2026 2:15:48pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * SamplePack class holds a set of sound effect pads decoded into memory.
+ *
+ * A pack is loaded from a folder, one pad per audio file. Packs are
+ * reference counted so the SamplerEngine can keep using a pack after it has
+ * been replaced, until its last voice has finished.
+ */
+class SamplePack : public juce::ReferenceCountedObject
+{
+public:
+	using Ptr = juce::ReferenceCountedObjectPtr<SamplePack>;
+
+	/**
+	 * Decoded audio of a pad.
+	 */
+	struct Pad
+	{
+		juce::String name;
+		juce::AudioBuffer<float> buffer;
+		double sampleRate = 44100.0;
+	};
+
+	/**
+	 * Constructor for the SamplePack class.
+	 *
+	 * @param _name		Name of the pack.
+	 */
+	SamplePack(const juce::String& _name);
+
+	/**
+	 * Decodes every audio file in a folder into a new pack, in file name order.
+	 * Blocks while decoding, so call it on a background thread.
+	 *
+	 * @param formatManager		Audio format manager used to decode the files.
+	 * @param folder			Folder holding the pack's audio files.
+	 * @return					The pack, or nullptr if no file could be decoded.
+	 */
+	static Ptr loadFromFolder(juce::AudioFormatManager& formatManager, const juce::File& folder);
+
+	/**
+	 * Returns the name of the pack.
+	 *
+	 * @return The name of the pack.
+	 */
+	const juce::String& getName() const;
+
+	/**
+	 * Returns the number of pads.
+	 *
+	 * @return The number of pads.
+	 */
+	int getNumPads() const;
+
+	/**
+	 * Returns a pad's decoded audio.
+	 *
+	 * @param padIndex		The pad's index.
+	 * @return				The pad.
+	 */
+	const Pad& getPad(int padIndex) const;
+
+	/**
+	 * Returns the memory held by the decoded audio of every pad.
+	 *
+	 * @return The memory use in bytes.
+	 */
+	size_t getMemoryUsage() const;
+
+	/**
+	 * Files longer than this are not loaded as pads.
+	 */
+	static constexpr double maxPadLengthInSeconds = 60.0;
+
+private:
+	friend class SamplerEngine;
+
+	/**
+	 * Name of the pack.
+	 */
+	juce::String name;
+
+	/**
+	 * Pads in file name order.
+	 */
+	std::vector<Pad> pads;
+
+	/**
+	 * Order the pack was handed to the SamplerEngine, used to free replaced packs.
+	 */
+	juce::uint32 sequenceNumber = 0;
+
+	/**
+	 * A pad's activity, kept by the SamplerEngine. The message thread counts
+	 * the presses it queues and the audio thread the ones it read this block,
+	 * then publishes whether the pad is playing or waiting for its beat.
+	 */
+	struct PadActivity
+	{
+		std::atomic<int> numQueued{ 0 };
+		bool lastQueuedStart = false;
+		int numRead = 0;
+		bool playing = false;
+		std::atomic<bool> active{ false };
+	};
+
+	/**
+	 * Activity of every pad, allocated when the pack is handed to the SamplerEngine.
+	 */
+	std::unique_ptr<PadActivity[]> padActivity;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SamplePack)
+};
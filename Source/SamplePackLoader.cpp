@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+	SamplePackLoader.cpp
+	Created: 19 Oct 2026 2:41:09pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "SamplePackLoader.h"
+
+SamplePackLoader::SamplePackLoader(juce::AudioFormatManager& _formatManager)
+	: formatManager(_formatManager)
+{
+
+}
+
+SamplePackLoader::~SamplePackLoader()
+{
+	pool.removeAllJobs(true, 5000);
+	cancelPendingUpdate();
+}
+
+void SamplePackLoader::loadFolder(const juce::File& folder)
+{
+	pool.addJob([this, folder]()
+		{
+			SamplePack::Ptr pack = SamplePack::loadFromFolder(formatManager, folder);
+
+			if (pack != nullptr)
+			{
+				{
+					const juce::ScopedLock sl(pendingLock);
+					pendingPacks.add(pack);
+				}
+
+				triggerAsyncUpdate();
+			}
+		});
+}
+
+void SamplePackLoader::handleAsyncUpdate()
+{
+	juce::ReferenceCountedArray<SamplePack> loadedPacks;
+
+	{
+		const juce::ScopedLock sl(pendingLock);
+		loadedPacks.swapWith(pendingPacks);
+	}
+
+	if (onPackLoaded != nullptr)
+	{
+		for (auto* pack : loadedPacks)
+		{
+			onPackLoaded(pack);
+		}
+	}
+}
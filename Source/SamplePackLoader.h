@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+	SamplePackLoader.h
+	Created: 19 Oct 2026 2:41:09pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include "SamplePack.h"
+
+/**
+ * SamplePackLoader class decodes sample packs on a background worker so
+ * the interface and the audio keep running while a pack loads.
+ *
+ * This class inherits from juce::AsyncUpdater to deliver loaded packs on
+ * the message thread.
+ */
+class SamplePackLoader : private juce::AsyncUpdater
+{
+public:
+	/**
+	 * Constructor for the SamplePackLoader class.
+	 *
+	 * @param _formatManager	Reference to the audio format manager.
+	 */
+	SamplePackLoader(juce::AudioFormatManager& _formatManager);
+
+	/**
+	 * Destructor for the SamplePackLoader class.
+	 * Waits for a running load and drops its result.
+	 */
+	~SamplePackLoader() override;
+
+	/**
+	 * Queues a folder to be decoded into a sample pack.
+	 *
+	 * @param folder	Folder holding the pack's audio files.
+	 */
+	void loadFolder(const juce::File& folder);
+
+	/**
+	 * Called on the message thread with each pack decoded.
+	 */
+	std::function<void(SamplePack::Ptr)> onPackLoaded;
+
+private:
+	/**
+	 * AsyncUpdater
+	 * Hands the loaded packs to onPackLoaded.
+	 */
+	void handleAsyncUpdate() override;
+
+	/**
+	 * Reference to the audio format manager.
+	 */
+	juce::AudioFormatManager& formatManager;
+
+	/**
+	 * Background worker decoding the packs, one at a time.
+	 */
+	juce::ThreadPool pool{ 1 };
+
+	/**
+	 * Packs decoded but not yet handed to the message thread.
+	 */
+	juce::CriticalSection pendingLock;
+	juce::ReferenceCountedArray<SamplePack> pendingPacks;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SamplePackLoader)
+};
@@ -0,0 +1,572 @@
+/*
+  ==============================================================================
+
+	SamplerEngine.cpp
+	Created: 19 Oct 2026 9:40:03am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "SamplerEngine.h"
+
+SamplerEngine::SamplerEngine(int maxVoices)
+	: voices(static_cast<size_t>(juce::jmax(1, maxVoices) * 2)),
+	maxPolyphony(juce::jmax(1, maxVoices)),
+	polyphony(juce::jmax(1, maxVoices))
+{
+	startTimer(500);
+}
+
+SamplerEngine::~SamplerEngine()
+{
+	stopTimer();
+}
+
+void SamplerEngine::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+	outputSampleRate = sampleRate;
+	schedulingDelay = juce::jmax(1, samplesPerBlockExpected);
+
+	// Stopping a voice fades it over 5ms to avoid a click
+	fadeOutSamples = juce::jmax(1, juce::roundToInt(sampleRate * 0.005));
+}
+
+void SamplerEngine::releaseResources()
+{
+	for (auto& voice : voices)
+	{
+		voice.padIndex = -1;
+	}
+
+	numScheduledEvents = 0;
+	publishPadActivity();
+}
+
+void SamplerEngine::setSamplePack(SamplePack::Ptr pack)
+{
+	if (pack == nullptr)
+	{
+		return;
+	}
+
+	pack->sequenceNumber = nextSequenceNumber++;
+
+	if (pack->padActivity == nullptr)
+	{
+		pack->padActivity = std::make_unique<SamplePack::PadActivity[]>(static_cast<size_t>(pack->getNumPads()));
+	}
+
+	// Keep the old pack alive until the audio thread has let go of it
+	if (latestPack != nullptr)
+	{
+		retiredPacks.add(latestPack);
+	}
+	latestPack = pack;
+
+	pendingPack = pack.get();
+}
+
+SamplePack::Ptr SamplerEngine::getSamplePack() const
+{
+	return latestPack;
+}
+
+void SamplerEngine::timerCallback()
+{
+	const juce::uint32 oldestInUse = oldestPackInUse;
+
+	for (int i = retiredPacks.size(); --i >= 0;)
+	{
+		if (retiredPacks[i]->sequenceNumber < oldestInUse)
+		{
+			DBG("SamplerEngine freed sample pack: " << retiredPacks[i]->getName());
+			retiredPacks.remove(i);
+		}
+	}
+}
+
+void SamplerEngine::swapInPendingPack()
+{
+	SamplePack* newPack = pendingPack.exchange(nullptr);
+
+	if (newPack == nullptr)
+	{
+		return;
+	}
+
+	currentPack = newPack;
+
+	// Pad numbers of waiting presses belong to the old pack
+	numScheduledEvents = 0;
+
+	for (auto& voice : voices)
+	{
+		if (voice.isActive() && voice.pack != currentPack && voice.fadeOutRemaining < 0)
+		{
+			voice.fadeOutRemaining = fadeOutSamples;
+		}
+	}
+}
+
+void SamplerEngine::triggerPad(int padIndex, const PadSettings& settings, Quantise quantise)
+{
+	pushEvent({ latestPack.get(), padIndex, true, settings, quantise, juce::Time::getHighResolutionTicks(), -1 });
+}
+
+void SamplerEngine::triggerPadAtSample(int padIndex, const PadSettings& settings, juce::int64 _samplePosition)
+{
+	pushEvent({ latestPack.get(), padIndex, true, settings, Quantise::Off, juce::Time::getHighResolutionTicks(), _samplePosition });
+}
+
+void SamplerEngine::stopPad(int padIndex)
+{
+	pushEvent({ latestPack.get(), padIndex, false, PadSettings(), Quantise::Off, juce::Time::getHighResolutionTicks(), -1 });
+}
+
+void SamplerEngine::pushEvent(const TriggerEvent& event)
+{
+	const auto scope = eventFifo.write(1);
+
+	if (scope.blockSize1 > 0)
+	{
+		eventQueue[static_cast<size_t>(scope.startIndex1)] = event;
+
+		// Counted before the write is committed, so the audio thread never reads it first
+		if (event.pack != nullptr && juce::isPositiveAndBelow(event.padIndex, event.pack->getNumPads()))
+		{
+			auto& activity = event.pack->padActivity[static_cast<size_t>(event.padIndex)];
+			activity.lastQueuedStart = event.start;
+			++activity.numQueued;
+		}
+	}
+	else
+	{
+		DBG("SamplerEngine event queue is full, pad event dropped");
+	}
+}
+
+void SamplerEngine::setGain(double _gain)
+{
+	if (_gain < 0 || _gain > 1.0)
+	{
+		DBG("SamplerEngine::setGain gain should be between 0 and 1");
+		return;
+	}
+
+	gain = static_cast<float>(_gain);
+}
+
+void SamplerEngine::setSpeed(double ratio)
+{
+	if (ratio <= 0 || ratio > 3.0)
+	{
+		DBG("SamplerEngine::setSpeed ratio should be between 0 and 3");
+		return;
+	}
+
+	speed = ratio;
+}
+
+void SamplerEngine::setPolyphony(int numVoices)
+{
+	polyphony = juce::jlimit(1, maxPolyphony, numVoices);
+}
+
+void SamplerEngine::setOutputLatency(int latencyInSamples)
+{
+	outputLatencySamples = juce::jmax(0, latencyInSamples);
+}
+
+void SamplerEngine::setBeatClock(double beatPosition, double beatsPerSample)
+{
+	clockBeatPosition = beatPosition;
+	clockBeatsPerSample = beatsPerSample;
+}
+
+double SamplerEngine::getLastTriggerLatencyMs() const
+{
+	return lastTriggerLatencyMs;
+}
+
+bool SamplerEngine::isPadActive(int padIndex) const
+{
+	if (latestPack == nullptr || !juce::isPositiveAndBelow(padIndex, latestPack->getNumPads()))
+	{
+		return false;
+	}
+
+	const auto& activity = latestPack->padActivity[static_cast<size_t>(padIndex)];
+
+	// The audio thread has not caught up with the last press yet
+	if (activity.numQueued > 0)
+	{
+		return activity.lastQueuedStart;
+	}
+
+	return activity.active;
+}
+
+void SamplerEngine::processEvents(int numSamples)
+{
+	// Blocks larger than expected would make presses late, so wait longer
+	schedulingDelay = juce::jmax(schedulingDelay, numSamples);
+
+	const int numReady = eventFifo.getNumReady();
+
+	if (numReady > 0)
+	{
+		const auto scope = eventFifo.read(numReady);
+		const juce::int64 nowTicks = juce::Time::getHighResolutionTicks();
+
+		auto addEvent = [this, nowTicks](const TriggerEvent& event)
+			{
+				const bool validPad = event.pack != nullptr && juce::isPositiveAndBelow(event.padIndex, event.pack->getNumPads());
+
+				// Pad numbers of presses queued before a pack change belong to the old pack
+				if (event.pack != currentPack)
+				{
+					if (validPad)
+					{
+						--event.pack->padActivity[static_cast<size_t>(event.padIndex)].numQueued;
+					}
+					return;
+				}
+
+				// Still counted as queued until its effect is published at the end of the block
+				if (validPad)
+				{
+					++currentPack->padActivity[static_cast<size_t>(event.padIndex)].numRead;
+				}
+
+				const ScheduledEvent scheduled = scheduleEvent(event, nowTicks);
+
+				// A stop cancels presses of the pad still waiting for their beat
+				if (!event.start)
+				{
+					int numKept = 0;
+					for (int i = 0; i < numScheduledEvents; ++i)
+					{
+						const auto& waiting = scheduledEvents[static_cast<size_t>(i)];
+						if (!(waiting.event.start && waiting.event.padIndex == event.padIndex
+							&& waiting.event.targetSample > scheduled.event.targetSample))
+						{
+							scheduledEvents[static_cast<size_t>(numKept++)] = waiting;
+						}
+					}
+					numScheduledEvents = numKept;
+				}
+
+				if (numScheduledEvents < eventQueueSize)
+				{
+					scheduledEvents[static_cast<size_t>(numScheduledEvents++)] = scheduled;
+				}
+			};
+
+		for (int i = 0; i < scope.blockSize1; ++i)
+		{
+			addEvent(eventQueue[static_cast<size_t>(scope.startIndex1 + i)]);
+		}
+
+		for (int i = 0; i < scope.blockSize2; ++i)
+		{
+			addEvent(eventQueue[static_cast<size_t>(scope.startIndex2 + i)]);
+		}
+	}
+
+	// Apply the events due in this block, in the order they were pressed
+	const juce::int64 blockEnd = samplePosition + numSamples;
+	int numKept = 0;
+
+	for (int i = 0; i < numScheduledEvents; ++i)
+	{
+		const auto& scheduled = scheduledEvents[static_cast<size_t>(i)];
+
+		if (scheduled.event.targetSample < blockEnd)
+		{
+			applyEvent(scheduled);
+		}
+		else
+		{
+			scheduledEvents[static_cast<size_t>(numKept++)] = scheduled;
+		}
+	}
+
+	numScheduledEvents = numKept;
+}
+
+SamplerEngine::ScheduledEvent SamplerEngine::scheduleEvent(const TriggerEvent& event, juce::int64 nowTicks)
+{
+	ScheduledEvent scheduled{ event, samplePosition };
+
+	if (event.targetSample >= 0)
+	{
+		// Already given an exact sample
+		scheduled.pressSample = juce::jmin(samplePosition, event.targetSample);
+		return scheduled;
+	}
+
+	// Work back from the block start to the sample the press happened at,
+	// then play it a fixed delay later so every press gets the same latency
+	const double secondsSincePress = juce::Time::highResolutionTicksToSeconds(nowTicks - event.triggerTicks);
+	scheduled.pressSample = samplePosition - static_cast<juce::int64>(secondsSincePress * outputSampleRate);
+
+	juce::int64 targetSample = juce::jmax(samplePosition, scheduled.pressSample + schedulingDelay);
+
+	if (event.quantise != Quantise::Off && clockBeatsPerSample > 0.0)
+	{
+		// Round up to the next beat or bar of the beat clock
+		const double beatsPerStep = event.quantise == Quantise::Bar ? 4.0 : 1.0;
+		const double targetBeat = clockBeatPosition + (targetSample - samplePosition) * clockBeatsPerSample;
+		const double nextStepBeat = std::ceil(targetBeat / beatsPerStep - 1.0e-9) * beatsPerStep;
+
+		targetSample = samplePosition + static_cast<juce::int64>(std::ceil((nextStepBeat - clockBeatPosition) / clockBeatsPerSample));
+	}
+
+	scheduled.event.targetSample = targetSample;
+	return scheduled;
+}
+
+void SamplerEngine::applyEvent(const ScheduledEvent& scheduled)
+{
+	const TriggerEvent& event = scheduled.event;
+
+	if (currentPack == nullptr || !juce::isPositiveAndBelow(event.padIndex, currentPack->getNumPads()))
+	{
+		return;
+	}
+
+	if (!event.start)
+	{
+		for (auto& voice : voices)
+		{
+			if (voice.pack == currentPack && voice.padIndex == event.padIndex && voice.fadeOutRemaining < 0)
+			{
+				voice.fadeOutRemaining = fadeOutSamples;
+			}
+		}
+		return;
+	}
+
+	if (currentPack->getPad(event.padIndex).buffer.getNumSamples() == 0)
+	{
+		return;
+	}
+
+	const juce::int64 startSample = juce::jmax(samplePosition, event.targetSample);
+
+	// Play modes only change how the voice is set up, the render loop is the same for all
+	Voice& voice = allocateVoice(event.settings.chokeGroup);
+	voice.pack = currentPack;
+	voice.padIndex = event.padIndex;
+	voice.position = 0.0;
+	voice.looping = event.settings.mode == PlayMode::Loop;
+	voice.chokeGroup = event.settings.chokeGroup;
+	voice.startOrder = nextStartOrder++;
+	voice.fadeOutRemaining = -1;
+	voice.startOffset = static_cast<int>(startSample - samplePosition);
+
+	// Waiting for a beat is intended, so only unquantised presses are measured
+	if (event.quantise == Quantise::Off)
+	{
+		const double scheduledSeconds = (startSample - scheduled.pressSample) / outputSampleRate;
+		const double outputSeconds = outputLatencySamples / outputSampleRate;
+		lastTriggerLatencyMs = (scheduledSeconds + outputSeconds) * 1000.0;
+	}
+}
+
+SamplerEngine::Voice& SamplerEngine::allocateVoice(int chokeGroup)
+{
+	int numSounding = 0;
+	Voice* freeVoice = nullptr;
+	Voice* oldestVoice = nullptr;
+	Voice* quietestFadingVoice = nullptr;
+
+	for (auto& voice : voices)
+	{
+		if (!voice.isActive())
+		{
+			if (freeVoice == nullptr)
+			{
+				freeVoice = &voice;
+			}
+			continue;
+		}
+
+		// Cut off the rest of the choke group
+		if (chokeGroup > 0 && voice.chokeGroup == chokeGroup && voice.fadeOutRemaining < 0)
+		{
+			voice.fadeOutRemaining = fadeOutSamples;
+		}
+
+		// Fading voices are on their way out and do not count against the polyphony
+		if (voice.fadeOutRemaining >= 0)
+		{
+			if (quietestFadingVoice == nullptr || voice.fadeOutRemaining < quietestFadingVoice->fadeOutRemaining)
+			{
+				quietestFadingVoice = &voice;
+			}
+			continue;
+		}
+
+		++numSounding;
+
+		if (oldestVoice == nullptr || voice.startOrder < oldestVoice->startOrder)
+		{
+			oldestVoice = &voice;
+		}
+	}
+
+	// Out of voices, the oldest fades out in its own slot while the new one starts in another
+	if (numSounding >= polyphony && oldestVoice != nullptr)
+	{
+		oldestVoice->fadeOutRemaining = fadeOutSamples;
+	}
+
+	if (freeVoice != nullptr)
+	{
+		return *freeVoice;
+	}
+
+	// Every slot is still fading, so cut the one closest to silence
+	return quietestFadingVoice != nullptr ? *quietestFadingVoice : *oldestVoice;
+}
+
+void SamplerEngine::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+	bufferToFill.clearActiveBufferRegion();
+
+	swapInPendingPack();
+	processEvents(bufferToFill.numSamples);
+
+	const float gainValue = gain;
+
+	for (auto& voice : voices)
+	{
+		if (voice.isActive())
+		{
+			renderVoice(voice, *bufferToFill.buffer, bufferToFill.startSample, bufferToFill.numSamples, gainValue);
+		}
+	}
+
+	samplePosition += bufferToFill.numSamples;
+	publishPadActivity();
+
+	// Tell the message thread which packs are still read
+	juce::uint32 oldestInUse = currentPack != nullptr ? currentPack->sequenceNumber : 0;
+
+	for (const auto& voice : voices)
+	{
+		if (voice.isActive())
+		{
+			oldestInUse = juce::jmin(oldestInUse, voice.pack->sequenceNumber);
+		}
+	}
+
+	oldestPackInUse = oldestInUse;
+}
+
+void SamplerEngine::publishPadActivity()
+{
+	if (currentPack == nullptr)
+	{
+		return;
+	}
+
+	const int numPads = currentPack->getNumPads();
+	auto* activity = currentPack->padActivity.get();
+
+	for (int pad = 0; pad < numPads; ++pad)
+	{
+		activity[pad].playing = false;
+	}
+
+	// Voices fading out have been stopped, choked or stolen
+	for (const auto& voice : voices)
+	{
+		if (voice.isActive() && voice.pack == currentPack && voice.fadeOutRemaining < 0)
+		{
+			activity[voice.padIndex].playing = true;
+		}
+	}
+
+	// Presses still waiting for their sample, in the order they were pressed
+	for (int i = 0; i < numScheduledEvents; ++i)
+	{
+		const auto& event = scheduledEvents[static_cast<size_t>(i)].event;
+
+		if (juce::isPositiveAndBelow(event.padIndex, numPads))
+		{
+			activity[event.padIndex].playing = event.start;
+		}
+	}
+
+	// Published before the presses read are let go of, so the message thread always sees one of them
+	for (int pad = 0; pad < numPads; ++pad)
+	{
+		activity[pad].active = activity[pad].playing;
+
+		if (activity[pad].numRead > 0)
+		{
+			activity[pad].numQueued -= activity[pad].numRead;
+			activity[pad].numRead = 0;
+		}
+	}
+}
+
+void SamplerEngine::renderVoice(Voice& voice, juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples, float gainValue)
+{
+	const auto& pad = voice.pack->getPad(voice.padIndex);
+	const int padLength = pad.buffer.getNumSamples();
+	const int padChannels = pad.buffer.getNumChannels();
+	const int outputChannels = outputBuffer.getNumChannels();
+	const double increment = pad.sampleRate / outputSampleRate * speed.load();
+
+	// A voice started in this block begins at its scheduled sample
+	const int firstSample = juce::jmin(voice.startOffset, numSamples);
+	voice.startOffset = 0;
+
+	for (int i = firstSample; i < numSamples; ++i)
+	{
+		if (voice.position >= padLength)
+		{
+			if (!voice.looping)
+			{
+				voice.padIndex = -1;
+				voice.pack = nullptr;
+				return;
+			}
+
+			voice.position -= padLength;
+		}
+
+		float sampleGain = gainValue;
+
+		if (voice.fadeOutRemaining >= 0)
+		{
+			if (voice.fadeOutRemaining == 0)
+			{
+				voice.padIndex = -1;
+				voice.pack = nullptr;
+				return;
+			}
+
+			sampleGain *= static_cast<float>(voice.fadeOutRemaining--) / static_cast<float>(fadeOutSamples);
+		}
+
+		// Linear interpolation between the two nearest pad samples
+		const int index = static_cast<int>(voice.position);
+		const float fraction = static_cast<float>(voice.position - index);
+		const int nextIndex = index + 1 < padLength ? index + 1 : (voice.looping ? 0 : index);
+
+		for (int channel = 0; channel < outputChannels; ++channel)
+		{
+			const float* padData = pad.buffer.getReadPointer(juce::jmin(channel, padChannels - 1));
+			const float sample = padData[index] + fraction * (padData[nextIndex] - padData[index]);
+
+			outputBuffer.addSample(channel, startSample + i, sample * sampleGain);
+		}
+
+		voice.position += increment;
+	}
+}
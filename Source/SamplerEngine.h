@@ -0,0 +1,370 @@
+/*
+  ==============================================================================
+
+	SamplerEngine.h
+	Created: 19 Oct 2026 9:40:03am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+#include "SamplePack.h"
+
+/**
+ * The SamplerEngine class plays the sound effect pads from memory.
+ *
+ * Pads come from a SamplePack decoded into RAM up front. A new pack can be
+ * swapped in while playing: the audio thread picks it up at the next block
+ * and the old pack is freed on the message thread once its last voice has
+ * faded out. Pad presses are queued through a lock-free FIFO and picked up by the audio thread,
+ * which starts a voice without opening files or allocating. Several pads
+ * (or the same pad several times) can sound together up to the polyphony
+ * limit, after which the oldest voice is stolen. A stolen voice fades out
+ * in a spare slot while its replacement starts, so stealing never clicks.
+ *
+ * Presses are timestamped when they happen and start exactly one audio
+ * block later, at the matching sample, so their timing does not depend on
+ * when the message thread or the audio callback happened to run. They can
+ * also be quantised to the next beat or bar of the master deck.
+ *
+ * The time from a pad press to its first sample reaching the output is
+ * measured for every press.
+ */
+class SamplerEngine : public juce::AudioSource,
+					  private juce::Timer
+{
+public:
+	/**
+	 * How a pad plays once pressed.
+	 * OneShot plays to the end, Loop repeats until stopped and Gate plays
+	 * until the pad is released or the sound ends.
+	 */
+	enum class PlayMode
+	{
+		OneShot,
+		Loop,
+		Gate
+	};
+
+	/**
+	 * Playback settings of a pad.
+	 * Starting a pad cuts off every voice in the same choke group, 0 for none.
+	 */
+	struct PadSettings
+	{
+		PlayMode mode = PlayMode::OneShot;
+		int chokeGroup = 0;
+	};
+
+	/**
+	 * When a pad press starts playing.
+	 */
+	enum class Quantise
+	{
+		Off,
+		Beat,
+		Bar
+	};
+
+	/**
+	 * Constructor for the SamplerEngine class.
+	 *
+	 * @param maxVoices		The highest polyphony allowed. Twice as many voices are allocated up front.
+	 */
+	SamplerEngine(int maxVoices = 32);
+
+	/**
+	 * Destructor for the SamplerEngine class.
+	 */
+	~SamplerEngine() override;
+
+	/**
+	 * Prepare the sampler ready for playing.
+	 *
+	 * @param samplesPerBlockExpected	The expected samples number per block.
+	 * @param sampleRate				The audio sample rate.
+	 */
+	void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+
+	/**
+	 * Mixes every active voice into the next audio block.
+	 *
+	 * @param bufferToFill Takes in information about the buffer to be filled.
+	 */
+	void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+	/**
+	 * Release any audio resources.
+	 */
+	void releaseResources() override;
+
+	/**
+	 * Replaces the pads with a new pack, even while playing.
+	 * Voices of the old pack fade out. Call on the message thread.
+	 *
+	 * @param pack	The decoded pack.
+	 */
+	void setSamplePack(SamplePack::Ptr pack);
+
+	/**
+	 * Returns the pack most recently set.
+	 *
+	 * @return The pack, or nullptr if none has been set.
+	 */
+	SamplePack::Ptr getSamplePack() const;
+
+	/**
+	 * Starts a new voice for the pad. Safe to call from the message thread.
+	 *
+	 * @param padIndex		The pad to play.
+	 * @param settings		The pad's play mode and choke group.
+	 * @param quantise		Delays the start to the next beat or bar of the beat clock.
+	 */
+	void triggerPad(int padIndex, const PadSettings& settings, Quantise quantise = Quantise::Off);
+
+	/**
+	 * Starts a new voice for the pad at an exact output sample,
+	 * counted from the first block rendered. Used when rendering offline.
+	 *
+	 * @param padIndex			The pad to play.
+	 * @param settings			The pad's play mode and choke group.
+	 * @param samplePosition	Output sample the pad's first sample is played at.
+	 */
+	void triggerPadAtSample(int padIndex, const PadSettings& settings, juce::int64 samplePosition);
+
+	/**
+	 * Fades out every voice of the pad, used to stop a Loop pad or release a Gate pad.
+	 * Safe to call from the message thread.
+	 *
+	 * @param padIndex		The pad to stop.
+	 */
+	void stopPad(int padIndex);
+
+	/**
+	 * Sets the sampler's output gain.
+	 *
+	 * @param gain The gain value to set, between 0 and 1.
+	 */
+	void setGain(double gain);
+
+	/**
+	 * Sets the playback speed ratio of every voice.
+	 *
+	 * @param ratio The playback speed ratio to set, between 0 and 3.
+	 */
+	void setSpeed(double ratio);
+
+	/**
+	 * Sets how many voices may sound at once.
+	 *
+	 * @param numVoices		Number of voices, limited to the voices allocated up front.
+	 */
+	void setPolyphony(int numVoices);
+
+	/**
+	 * Sets the output latency included in the trigger latency.
+	 *
+	 * @param latencyInSamples	The device's output latency and any delay added after the sampler.
+	 */
+	void setOutputLatency(int latencyInSamples);
+
+	/**
+	 * Sets the master deck's beat position for the next block.
+	 * Called on the audio thread before each getNextAudioBlock.
+	 *
+	 * @param beatPosition		Beat position of the block's first sample.
+	 * @param beatsPerSample	Beats advanced per output sample, 0 if there is no beat clock.
+	 */
+	void setBeatClock(double beatPosition, double beatsPerSample);
+
+	/**
+	 * Returns the time between the last pad press and its first sample reaching the output.
+	 *
+	 * @return The trigger-to-sound latency in milliseconds.
+	 */
+	double getLastTriggerLatencyMs() const;
+
+	/**
+	 * Returns whether a pad of the latest pack is playing, or will once its
+	 * press is played. Follows presses still queued for the audio thread,
+	 * and voices ended by a choke group, stealing or reaching their end.
+	 * Call on the message thread.
+	 *
+	 * @param padIndex		The pad.
+	 * @return				True if the pad is playing or about to.
+	 */
+	bool isPadActive(int padIndex) const;
+
+private:
+	/**
+	 * A playing instance of a pad.
+	 */
+	struct Voice
+	{
+		const SamplePack* pack = nullptr;
+		int padIndex = -1;
+		double position = 0.0;
+		bool looping = false;
+		int chokeGroup = 0;
+		juce::uint64 startOrder = 0;
+		int fadeOutRemaining = -1;
+		int startOffset = 0;
+
+		bool isActive() const { return padIndex >= 0; }
+	};
+
+	/**
+	 * A pad press or release queued for the audio thread.
+	 */
+	struct TriggerEvent
+	{
+		SamplePack* pack;
+		int padIndex;
+		bool start;
+		PadSettings settings;
+		Quantise quantise;
+		juce::int64 triggerTicks;
+		juce::int64 targetSample;
+	};
+
+	/**
+	 * A pad event waiting on the audio thread for its output sample.
+	 */
+	struct ScheduledEvent
+	{
+		TriggerEvent event;
+		juce::int64 pressSample;
+	};
+
+	/**
+	 * Pushes an event into the FIFO, dropping it if the FIFO is full.
+	 */
+	void pushEvent(const TriggerEvent& event);
+
+	/**
+	 * Schedules the queued events and applies those due in this block.
+	 * Called on the audio thread.
+	 */
+	void processEvents(int numSamples);
+
+	/**
+	 * Works out the output sample a queued event is due at.
+	 */
+	ScheduledEvent scheduleEvent(const TriggerEvent& event, juce::int64 nowTicks);
+
+	/**
+	 * Starts or stops voices for an event due in this block.
+	 */
+	void applyEvent(const ScheduledEvent& scheduled);
+
+	/**
+	 * Finds a free voice, fading out the oldest one when the polyphony is used up.
+	 * Voices in the choke group are faded out in the same pass.
+	 */
+	Voice& allocateVoice(int chokeGroup);
+
+	/**
+	 * Mixes one voice into the output.
+	 */
+	void renderVoice(Voice& voice, juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples, float gainValue);
+
+	/**
+	 * Timer
+	 * Frees replaced packs no longer used by the audio thread.
+	 */
+	void timerCallback() override;
+
+	/**
+	 * Picks up a newly set pack at the start of a block.
+	 * Called on the audio thread.
+	 */
+	void swapInPendingPack();
+
+	/**
+	 * Publishes which pads of the current pack are playing or waiting to,
+	 * then lets go of the presses read this block.
+	 * Called on the audio thread at the end of each block.
+	 */
+	void publishPadActivity();
+
+	/**
+	 * The latest pack and the replaced packs still waiting to be freed,
+	 * only touched by the message thread.
+	 */
+	SamplePack::Ptr latestPack;
+	juce::ReferenceCountedArray<SamplePack> retiredPacks;
+	juce::uint32 nextSequenceNumber = 1;
+
+	/**
+	 * A pack set by the message thread but not yet picked up by the audio thread.
+	 */
+	std::atomic<SamplePack*> pendingPack{ nullptr };
+
+	/**
+	 * Pack played by the audio thread, kept alive by latestPack or retiredPacks.
+	 */
+	SamplePack* currentPack = nullptr;
+
+	/**
+	 * Sequence number of the oldest pack the audio thread may still read.
+	 * Packs older than this can be freed.
+	 */
+	std::atomic<juce::uint32> oldestPackInUse{ 0 };
+
+	/**
+	 * Voices, allocated once in the constructor. There are twice as many
+	 * as the highest polyphony, leaving slots for voices fading out.
+	 */
+	std::vector<Voice> voices;
+	const int maxPolyphony;
+	juce::uint64 nextStartOrder = 0;
+
+	/**
+	 * Lock-free queue of pad events from the message thread to the audio thread.
+	 */
+	static constexpr int eventQueueSize = 256;
+	juce::AbstractFifo eventFifo{ eventQueueSize };
+	std::array<TriggerEvent, eventQueueSize> eventQueue;
+
+	/**
+	 * Events waiting for their output sample, only touched by the audio thread.
+	 */
+	std::array<ScheduledEvent, eventQueueSize> scheduledEvents;
+	int numScheduledEvents = 0;
+
+	/**
+	 * Output samples rendered so far, and the delay every press is played
+	 * after so that none of them arrive too late for their sample.
+	 */
+	juce::int64 samplePosition = 0;
+	int schedulingDelay = 512;
+
+	/**
+	 * Beat clock for the current block, set by the audio thread.
+	 */
+	double clockBeatPosition = 0.0;
+	double clockBeatsPerSample = 0.0;
+
+	/**
+	 * Parameters shared with the message thread.
+	 */
+	std::atomic<float> gain{ 0.5f };
+	std::atomic<double> speed{ 1.0 };
+	std::atomic<int> polyphony;
+	std::atomic<int> outputLatencySamples{ 0 };
+	std::atomic<double> lastTriggerLatencyMs{ 0.0 };
+
+	/**
+	 * Output sample rate and the fade applied when a voice is stopped.
+	 */
+	double outputSampleRate = 44100.0;
+	int fadeOutSamples = 256;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SamplerEngine)
+};
@@ -12,29 +12,36 @@
 #include "SoundEffect.h"
 
 //==============================================================================
-SoundEffect::SoundEffect(DJAudioPlayer* _player)
-    : player(_player), isPlaying(false), currentSoundIndex(-1), customDesign()
+SoundEffect::SoundEffect(SamplerEngine* _sampler)
+    : sampler(_sampler), customDesign()
 {
-    // Iterate through buttons vector and init them
-    for (int i = 0; i < buttons.size(); ++i)
-    {
-        addAndMakeVisible(*buttons[i]);
-        buttons[i]->addListener(this);
-        
-        // Apply custom design settings
-        customDesign.buttonDesign(*buttons[i]);
-    }
-
     setupSlider(volSlider, 0.5, 0.0, 1.0, volLabel, "< Volume >");
     setupSlider(speedSlider, 1.0, 0.0, 3.0, speedLabel, "< Speed >");
 
-    // Load sound effect files when SoundEffect is constructed
-    readAudioFiles();
+    statusLabel.setFont(customDesign.getSelectedFont());
+    statusLabel.setColour(juce::Label::textColourId, juce::Colours::darkcyan);
+    statusLabel.setJustificationType(juce::Justification::centred);
+    addAndMakeVisible(statusLabel);
+
+    addAndMakeVisible(quantiseButton);
+    quantiseButton.addListener(this);
+    customDesign.buttonDesign(quantiseButton);
+
+    addAndMakeVisible(loadPackButton);
+    loadPackButton.addListener(this);
+    customDesign.buttonDesign(loadPackButton);
+
+    // Decode the default pack in the background when SoundEffect is constructed
+    soundFormatManager.registerBasicFormats();
+    packLoader.onPackLoaded = [this](SamplePack::Ptr pack) { setSamplePack(pack); };
+    loadDefaultPack();
+
+    startTimer(250);
 }
 
 SoundEffect::~SoundEffect()
 {
-
+    stopTimer();
 }
 
 void SoundEffect::setupSlider(juce::Slider& slider, float initialValue,
@@ -94,85 +101,207 @@ void SoundEffect::resized()
     float btnH = height * 0.8f;
     float btnMarginX = width * 0.075f;
     float btnMarginY = height * 0.1f;
-    
-    sound1.setBounds(btnMarginX * 2           , startH, btnW, btnH);
-    sound2.setBounds(btnMarginX * 3 + btnW    , startH, btnW, btnH);
-    sound3.setBounds(btnMarginX * 4 + btnW * 2, startH, btnW, btnH);
 
-    sound4.setBounds(btnMarginX * 2           , startH + btnH + btnMarginY, btnW, btnH);
-    sound5.setBounds(btnMarginX * 3 + btnW    , startH + btnH + btnMarginY, btnW, btnH);
-    sound6.setBounds(btnMarginX * 4 + btnW * 2, startH + btnH + btnMarginY, btnW, btnH);
+    // Pads fill three columns, rows shrink to fit larger packs in the same area
+    int numRows = juce::jmax(3, (buttons.size() + 2) / 3);
+    float rowH = (btnH + btnMarginY) * 3 / numRows;
+    float padH = rowH - btnMarginY;
 
-    sound7.setBounds(btnMarginX * 2           , startH + (btnH * 2) + (btnMarginY * 2), btnW, btnH);
-    sound8.setBounds(btnMarginX * 3 + btnW    , startH + (btnH * 2) + (btnMarginY * 2), btnW, btnH);
-    sound9.setBounds(btnMarginX * 4 + btnW * 2, startH + (btnH * 2) + (btnMarginY * 2), btnW, btnH);
+    for (int i = 0; i < buttons.size(); ++i)
+    {
+        int column = i % 3;
+        int row = i / 3;
+        buttons[i]->setBounds(btnMarginX * (2 + column) + btnW * column, startH + rowH * row, btnW, padH);
+    }
 
     float bottomH = startH + (btnH * 3) + (btnMarginY * 4);
     float sliderSize = btnW * 0.55;
     float bottomW = getWidth() / 6;
     volSlider.setBounds(bottomW * 1.75, bottomH, sliderSize, sliderSize);
     speedSlider.setBounds(bottomW * 4.25, bottomH, sliderSize, sliderSize);
+
+    float statusH = getHeight() * 0.06f;
+    float statusY = getHeight() - statusH * 1.2f;
+    quantiseButton.setBounds(btnMarginX * 2, statusY, btnW, statusH);
+    statusLabel.setBounds(btnMarginX * 3 + btnW, statusY, btnW, statusH);
+    loadPackButton.setBounds(btnMarginX * 4 + btnW * 2, statusY, btnW, statusH);
 }
 
 void SoundEffect::buttonClicked(juce::Button* button)
 {
-    // Vector of sound effect names corresponding to each buttons
-    std::vector<std::string> soundEffects = {
-        "beat1", "beat2", "beat3", 
-        "DJ Intro", "heartbeat", "alarm", 
-        "sweep down", "clap", "boo"
-    };
+    if (button == &quantiseButton)
+    {
+        // Cycle through off, beat and bar
+        if (quantise == SamplerEngine::Quantise::Off)
+        {
+            quantise = SamplerEngine::Quantise::Beat;
+            quantiseButton.setButtonText("QUANTISE: BEAT");
+        }
+        else if (quantise == SamplerEngine::Quantise::Beat)
+        {
+            quantise = SamplerEngine::Quantise::Bar;
+            quantiseButton.setButtonText("QUANTISE: BAR");
+        }
+        else
+        {
+            quantise = SamplerEngine::Quantise::Off;
+            quantiseButton.setButtonText("QUANTISE: OFF");
+        }
+        return;
+    }
+
+    if (button == &loadPackButton)
+    {
+        DBG("< Load Pack > button was clicked << Select sample pack folder... >>");
+
+        auto folderChooserFlags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectDirectories;
+        packChooser.launchAsync(folderChooserFlags, [this](const juce::FileChooser& chooser)
+            {
+                if (chooser.getResult().isDirectory())
+                {
+                    // The current pack keeps playing while the new one decodes
+                    packLoader.loadFolder(chooser.getResult());
+                }
+            });
+        return;
+    }
 
     // Iterate through the buttons vector to find the clicked button
     for (int i = 0; i < buttons.size(); ++i)
     {
         if (button == buttons[i])
         {
-            // If the clicked button is already playing, 
-            // click the same button again to stop playback.
-            if (isPlaying && i == currentSoundIndex)
+            if (buttons[i]->wasPopupMenuClick)
             {
-                // Stop playback
-                player->stop();
-                // Update flag
-                isPlaying = false;
-                DBG("< Stopped > playback of sound effect: " << soundEffects[i]);
+                showPadMenu(i);
                 return;
             }
-            // Stop playback of any currently playing sound effect
-            // if the clicked button was different.
-            if (isPlaying)
+
+            switch (padSettings[i].mode)
             {
-                player->stop();
+            case SamplerEngine::PlayMode::OneShot:
+                // Every click plays the sound effect again on top of the others
+                sampler->triggerPad(i, padSettings[i], quantise);
+                DBG("< Started > playback of sound effect: " << button->getButtonText());
+                break;
+
+            case SamplerEngine::PlayMode::Loop:
+                // If the clicked button is already playing, 
+                // click the same button again to stop playback.
+                if (sampler->isPadActive(i))
+                {
+                    sampler->stopPad(i);
+                    DBG("< Stopped > playback of sound effect: " << button->getButtonText());
+                }
+                else
+                {
+                    sampler->triggerPad(i, padSettings[i], quantise);
+                    DBG("< Started > playback of sound effect: " << button->getButtonText());
+                }
+                break;
+
+            case SamplerEngine::PlayMode::Gate:
+                // Handled as the button is pressed and released
+                break;
             }
+            return;
+        }
+    }
+}
 
-            // Play the selected sound effect.
-            playSoundEffect(soundEffects[i]);
-            DBG("< Started > playback of sound effect: " << soundEffects[i]);
-            
-            // Update flags
-            isPlaying = true;
-            currentSoundIndex = i;
+void SoundEffect::buttonStateChanged(juce::Button* button)
+{
+    for (int i = 0; i < buttons.size(); ++i)
+    {
+        if (button == buttons[i] && padSettings[i].mode == SamplerEngine::PlayMode::Gate)
+        {
+            if (button->getState() == juce::Button::buttonDown)
+            {
+                // The popup menu button opens the pad menu instead
+                if (!juce::ModifierKeys::currentModifiers.isPopupMenu() && !sampler->isPadActive(i))
+                {
+                    sampler->triggerPad(i, padSettings[i], quantise);
+                }
+            }
+            else if (sampler->isPadActive(i))
+            {
+                sampler->stopPad(i);
+            }
             return;
-            
         }
     }
 }
 
+void SoundEffect::showPadMenu(int padIndex)
+{
+    const auto& settings = padSettings[padIndex];
+
+    juce::PopupMenu chokeMenu;
+    chokeMenu.addItem(10, "None", true, settings.chokeGroup == 0);
+    for (int group = 1; group <= numChokeGroups; ++group)
+    {
+        chokeMenu.addItem(10 + group, "Group " + juce::String(group), true, settings.chokeGroup == group);
+    }
+
+    juce::PopupMenu menu;
+    menu.addItem(1, "One-shot", true, settings.mode == SamplerEngine::PlayMode::OneShot);
+    menu.addItem(2, "Loop", true, settings.mode == SamplerEngine::PlayMode::Loop);
+    menu.addItem(3, "Gate", true, settings.mode == SamplerEngine::PlayMode::Gate);
+    menu.addSeparator();
+    menu.addSubMenu("Choke group", chokeMenu);
+
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(buttons[padIndex]),
+        [this, padIndex](int result)
+        {
+            // The pack may have been replaced while the menu was open
+            if (result == 0 || padIndex >= buttons.size())
+            {
+                return;
+            }
+
+            auto& chosenSettings = padSettings[padIndex];
+
+            if (result >= 10)
+            {
+                chosenSettings.chokeGroup = result - 10;
+            }
+            else
+            {
+                // Stop the pad so it does not keep looping in its old mode
+                if (sampler->isPadActive(padIndex))
+                {
+                    sampler->stopPad(padIndex);
+                }
+
+                chosenSettings.mode = result == 2 ? SamplerEngine::PlayMode::Loop
+                                    : result == 3 ? SamplerEngine::PlayMode::Gate
+                                                  : SamplerEngine::PlayMode::OneShot;
+            }
+
+            const char* modeNames[] = { "One-shot", "Loop", "Gate" };
+            juce::String description = modeNames[static_cast<int>(chosenSettings.mode)];
+            if (chosenSettings.chokeGroup > 0)
+            {
+                description << ", choke group " << chosenSettings.chokeGroup;
+            }
+            buttons[padIndex]->setTooltip(description);
+        });
+}
+
 void SoundEffect::sliderValueChanged(juce::Slider* slider)
 {
     if (slider == &volSlider)
     {
-        player->setGain(slider->getValue());
+        sampler->setGain(slider->getValue());
     }
     
     if (slider == &speedSlider)
     {
-        player->setSpeed(slider->getValue());
+        sampler->setSpeed(slider->getValue());
     }
 }
 
-void SoundEffect::readAudioFiles()
+void SoundEffect::loadDefaultPack()
 {
     // Construct the directory path for sound effect audio files
     juce::File directory = juce::File::getCurrentWorkingDirectory()
@@ -187,51 +316,57 @@ void SoundEffect::readAudioFiles()
         return;
     }
 
-    // Search for the audio file with ".mp3" or ".wav" extension
-    juce::Array<juce::File> soundEffectFiles;
-    directory.findChildFiles(soundEffectFiles, juce::File::findFiles, false, "*.mp3;*.wav");
+    packLoader.loadFolder(directory);
+}
 
-    // Ensure sound effect file was found
-    if (soundEffectFiles.isEmpty())
-    {
-        DBG("Error: Sound effect files not found in the SoundEffect directory.");
-        return;
-    }
+void SoundEffect::setSamplePack(SamplePack::Ptr pack)
+{
+    sampler->setSamplePack(pack);
 
-    // Iterate through the sound effect files
-    for (const juce::File& file : soundEffectFiles)
+    // One button for each pad of the pack
+    buttons.clear();
+    for (int i = 0; i < pack->getNumPads(); ++i)
     {
-        // Extract the sound effect's title
-        juce::String soundTitle = file.getFileNameWithoutExtension();
-        
-        // Convert sound effect's URL as string
-        juce::String soundURL = juce::URL{ file }.toString(false);
-        
-        // Add into the list
-        soundEffects.push_back({ soundTitle,soundURL });
+        auto* button = buttons.add(new PadButton(pack->getPad(i).name));
+        addAndMakeVisible(button);
+        button->addListener(this);
+
+        // Apply custom design settings
+        customDesign.buttonDesign(*button);
     }
+
+    // The old pack's voices fade out when it is replaced
+    padSettings.assign(static_cast<size_t>(buttons.size()), SamplerEngine::PadSettings());
+
+    DBG("Sample pack loaded: " << pack->getName() << " with " << pack->getNumPads()
+        << " pads using " << juce::File::descriptionOfSizeInBytes(static_cast<juce::int64>(pack->getMemoryUsage())));
+
+    updateStatusLabel();
+    resized();
 }
 
+void SoundEffect::timerCallback()
+{
+    updateStatusLabel();
+}
 
-void SoundEffect::playSoundEffect(const juce::String& soundEffectTitle)
+void SoundEffect::updateStatusLabel()
 {
-    // Iterate through sound effects
-    for (int i = 0; i < soundEffects.size(); ++i)
-    {
-        // If the sound effect's title match
-        if (soundEffects[i].getAudioTrackTitle() == soundEffectTitle)
-        {
-            // Then load the sound effect into player
-            player->loadURL(soundEffects[i].getAudioTrackURL());
+    SamplePack::Ptr pack = sampler->getSamplePack();
 
-            DBG("Sound effect are loaded: " << soundEffectTitle);
+    if (pack == nullptr)
+    {
+        return;
+    }
 
-            player->replay(true);
+    juce::String status = juce::File::descriptionOfSizeInBytes(static_cast<juce::int64>(pack->getMemoryUsage()));
 
-            // Start playing the sound effect
-            player->start();
-            return;
-        }
+    double latencyMs = sampler->getLastTriggerLatencyMs();
+    if (latencyMs > 0.0)
+    {
+        status << " | " << juce::String(latencyMs, 1) << " ms";
     }
-    DBG("Error: Sound effect not found: " << soundEffectTitle);
+
+    statusLabel.setText(status, juce::NotificationType::dontSendNotification);
+    statusLabel.setTooltip(pack->getName() + ": " + juce::String(pack->getNumPads()) + " pads");
 }
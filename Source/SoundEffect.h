@@ -11,27 +11,34 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "DJAudioPlayer.h"
-#include "AudioTrack.h"
+#include "SamplerEngine.h"
+#include "SamplePackLoader.h"
 #include "CustomDesign.h"
 
 /**
  * SoundEffect class handles sound effects and their playback.
  * 
- * This class inherits from juce::Component, juce::Button::Listener 
- * and juce::Slider::Listener to handle various interaction functionalities.
+ * Sound effects come from a sample pack decoded on a background worker and
+ * handed to the SamplerEngine, so the pads can be played together without
+ * loading files on each press. A new pack can be loaded while playing,
+ * with one pad per audio file in the chosen folder. Right-click a pad to
+ * choose its play mode and choke group.
+ * 
+ * This class inherits from juce::Component, juce::Button::Listener, 
+ * juce::Slider::Listener and juce::Timer to handle various interaction functionalities.
  */
 class SoundEffect : public juce::Component,
                     public juce::Button::Listener,
-                    public juce::Slider::Listener
+                    public juce::Slider::Listener,
+                    public juce::Timer
 {
 public:
     /**
      * Constructor of SoundEffect class.
      * 
-     * @param _player Pointer to the DJAudioPlayer.
+     * @param _sampler Pointer to the SamplerEngine playing the pads.
      */
-    SoundEffect(DJAudioPlayer* _player);
+    SoundEffect(SamplerEngine* _sampler);
 
     /**
      * Destructor of SoundEffect class.
@@ -57,6 +64,13 @@ public:
      */
     void buttonClicked(juce::Button* button) override;
 
+    /**
+     * Starts and stops Gate pads as they are pressed and released.
+     *
+     * @param button Pointer to the button whose state changed.
+     */
+    void buttonStateChanged(juce::Button* button) override;
+
     /**
      * Handles slider value changes in the SoundEffect.
      *
@@ -64,7 +78,35 @@ public:
      */
     void sliderValueChanged(juce::Slider* slider) override;
 
+    /**
+     * Timer callback to show the latest trigger latency.
+     */
+    void timerCallback() override;
+
 private:
+    /**
+     * Pad button remembering whether it was clicked with the popup menu button.
+     */
+    struct PadButton : public juce::TextButton
+    {
+        using juce::TextButton::TextButton;
+        using juce::TextButton::clicked;
+
+        void clicked(const juce::ModifierKeys& modifiers) override
+        {
+            wasPopupMenuClick = modifiers.isPopupMenu();
+        }
+
+        bool wasPopupMenuClick = false;
+    };
+
+    /**
+     * Shows the menu to choose a pad's play mode and choke group.
+     *
+     * @param padIndex The pad's index.
+     */
+    void showPadMenu(int padIndex);
+
     /**
      * Setup and design sliders with specified parameters.
      *
@@ -80,45 +122,51 @@ private:
         const juce::String& labelText);
 
     /**
-     * Read audio files from the Sound Effect directory.
-     * Populates the soundEffects vector.
+     * Loads the default sample pack from the Sound Effect directory.
      */
-    void readAudioFiles();
+    void loadDefaultPack();
 
     /**
-     * Plays each sound effects.
-     * 
-     * @param soundEffectTitle Title of the sound effect to be played.
+     * Hands a decoded pack to the sampler and creates a button for each pad.
+     *
+     * @param pack The decoded pack.
      */
-    void playSoundEffect(const juce::String& soundEffectTitle);
+    void setSamplePack(SamplePack::Ptr pack);
 
     /**
-     * Vector to store AudioTrack objects representing sound effects.
+     * Updates the label showing the pack, its memory use and the trigger latency.
      */
-    std::vector<AudioTrack> soundEffects;
+    void updateStatusLabel();
 
     /**
-     * Declare text buttons for different sound effects.
+     * Buttons for each pad of the current pack.
      */
-    juce::TextButton sound1{ "beat 1" }
-                    ,sound2{ "beat 2" }
-                    ,sound3{ "beat 3" }
-                    ,sound4{ "DJ\nIntro" }
-                    ,sound5{ "heartbeat" }
-                    ,sound6{ "alarm" }
-                    ,sound7{ "sweep\ndown" }
-                    ,sound8{ "clap" }
-                    ,sound9{ "boo" };
+    juce::OwnedArray<PadButton> buttons;
 
     /**
-     * Vector pointers to text buttons.
+     * Play mode and choke group of each pad, reset when a pack is loaded.
      */
-    std::vector<juce::TextButton*> buttons =
-    {
-        &sound1,&sound2,&sound3,
-        &sound4,&sound5,&sound6,
-        &sound7,&sound8,&sound9
-    };
+    std::vector<SamplerEngine::PadSettings> padSettings;
+
+    /**
+     * Number of choke groups offered in the pad menu.
+     */
+    static constexpr int numChokeGroups = 4;
+
+    /**
+     * Shows each pad's play mode and the pack details on hover.
+     */
+    juce::TooltipWindow tooltipWindow{ this };
+
+    /**
+     * Button to choose a folder to load as a sample pack.
+     */
+    juce::TextButton loadPackButton{ "LOAD PACK" };
+
+    /**
+     * File chooser to select a sample pack folder.
+     */
+    juce::FileChooser packChooser{ "< Select sample pack folder... >" };
 
     /**
      * Slider for volume and speed control.
@@ -131,44 +179,39 @@ private:
     juce::Label volLabel, speedLabel;
 
     /**
-     * Pointer to DJAudioPlayer.
+     * Label showing the pack, its memory use and the time from a pad press to its sound.
      */
-    DJAudioPlayer* player;
+    juce::Label statusLabel;
 
     /**
-     * CustomDesign for customizing button appearance.
+     * Button cycling the pads' quantise between off, beat and bar.
      */
-    CustomDesign customDesign;
+    juce::TextButton quantiseButton{ "QUANTISE: OFF" };
 
     /**
-     * Audio format manager for managing audio formats.
+     * Whether pads wait for the next beat or bar of the master deck.
      */
-    juce::AudioFormatManager soundFormatManager;
+    SamplerEngine::Quantise quantise = SamplerEngine::Quantise::Off;
 
     /**
-     * Unique pointer to AudioFormatReaderSource to play sound effects.
+     * Pointer to SamplerEngine.
      */
-    std::unique_ptr<juce::AudioFormatReaderSource> soundEffect;
+    SamplerEngine* sampler;
 
     /**
-     * Audio transport source for playing audio files.
-     */
-    juce::AudioTransportSource transportSource;
-
-    /**
-     * Standard sample rate for audio playback.
+     * CustomDesign for customizing button appearance.
      */
-    double sampleRate = 44100.0;
+    CustomDesign customDesign;
 
     /**
-     * Indicates whether a sound effect is currently playing.
+     * Audio format manager for managing audio formats.
      */
-    bool isPlaying;
+    juce::AudioFormatManager soundFormatManager;
 
     /**
-     * Index of the currently selected sound effect.
+     * Decodes sample packs on a background worker.
      */
-    int currentSoundIndex;
+    SamplePackLoader packLoader{ soundFormatManager };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SoundEffect)
 };
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+	TrackAnalyser.cpp
+	Created: 23 Oct 2026 11:18:36am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "TrackAnalyser.h"
+
+TrackAnalyser::TrackAnalyser(juce::AudioFormatManager& _formatManager)
+	: formatManager(_formatManager),
+	pool(juce::SystemStats::getNumCpus())
+{
+
+}
+
+TrackAnalyser::~TrackAnalyser()
+{
+	cancelled = true;
+	pool.removeAllJobs(true, 4000);
+	cancelPendingUpdate();
+}
+
+void TrackAnalyser::analyseFile(const juce::File& audioTrackFile)
+{
+	// A new batch starts when nothing is queued
+	if (numQueued++ == 0)
+	{
+		batchStartTime = juce::Time::getMillisecondCounterHiRes();
+	}
+
+	pool.addJob([this, audioTrackFile]()
+		{
+			Analysis analysis = analyse(audioTrackFile);
+
+			if (cancelled)
+			{
+				return;
+			}
+
+			{
+				const juce::ScopedLock sl(pendingLock);
+				pendingAnalyses.push_back(analysis);
+			}
+
+			// Many finished files are delivered in one message thread callback
+			triggerAsyncUpdate();
+		});
+}
+
+TrackAnalyser::Analysis TrackAnalyser::analyse(const juce::File& audioTrackFile)
+{
+	Analysis analysis;
+	analysis.url = juce::URL{ audioTrackFile }.toString(false);
+
+	std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(audioTrackFile));
+
+	if (reader == nullptr || reader->sampleRate <= 0.0)
+	{
+		DBG("< Cannot analyse: " << audioTrackFile.getFullPathName() << " >");
+		return analysis;
+	}
+
+	// Only the first two channels are measured
+	const int numChannels = juce::jlimit(1, 2, static_cast<int>(reader->numChannels));
+	juce::AudioBuffer<float> block(numChannels, blockSize);
+
+	IntegratedLoudness loudness;
+	loudness.prepare(reader->sampleRate);
+
+	KeyDetector keyDetector;
+	keyDetector.prepare(reader->sampleRate);
+
+	// Decode one block at a time, never the whole file
+	for (juce::int64 position = 0; position < reader->lengthInSamples; position += blockSize)
+	{
+		if (cancelled)
+		{
+			return analysis;
+		}
+
+		const int numSamples = static_cast<int>(juce::jmin(static_cast<juce::int64>(blockSize), reader->lengthInSamples - position));
+		reader->read(&block, 0, numSamples, position, true, numChannels > 1);
+
+		const float* left = block.getReadPointer(0);
+		const float* right = numChannels > 1 ? block.getReadPointer(1) : nullptr;
+		loudness.process(left, right, numSamples);
+		keyDetector.process(left, right, numSamples);
+	}
+
+	analysis.loudness = loudness.getLoudness();
+	analysis.key = keyDetector.getKey();
+	return analysis;
+}
+
+void TrackAnalyser::handleAsyncUpdate()
+{
+	std::vector<Analysis> analyses;
+
+	{
+		const juce::ScopedLock sl(pendingLock);
+		analyses.swap(pendingAnalyses);
+	}
+
+	if (!analyses.empty() && onTracksAnalysed != nullptr)
+	{
+		onTracksAnalysed(analyses);
+	}
+
+	// Log the analysis rate once the batch is done
+	numQueued -= static_cast<int>(analyses.size());
+	batchSize += static_cast<int>(analyses.size());
+
+	if (numQueued == 0 && batchSize > 0)
+	{
+		DBG("< Analysed " << batchSize << " audio tracks at "
+			<< juce::String(batchSize * 60000.0 / juce::jmax(1.0, juce::Time::getMillisecondCounterHiRes() - batchStartTime), 1)
+			<< " tracks per minute on " << pool.getNumThreads() << " threads >");
+		batchSize = 0;
+	}
+}
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+	TrackAnalyser.h
+	Created: 23 Oct 2026 11:18:36am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <functional>
+#include <vector>
+#include "TrackLibrary.h"
+#include "IntegratedLoudness.h"
+#include "KeyDetector.h"
+
+/**
+ * TrackAnalyser class decodes imported audio tracks on background workers
+ * to measure what the file's header cannot tell: their loudness and key.
+ *
+ * Each file is decoded once, streamed through a fixed size buffer into
+ * every measurement, so an analysis uses the same memory however long the
+ * audio track is. Audio tracks are analysed in parallel, one per core.
+ * Finished analyses are collected and handed back to the message thread in
+ * batches.
+ *
+ * This class inherits from juce::AsyncUpdater to deliver the results on the
+ * message thread.
+ */
+class TrackAnalyser : private juce::AsyncUpdater
+{
+public:
+	/**
+	 * Results of analysing one audio track.
+	 */
+	struct Analysis
+	{
+		juce::String url;
+		float loudness = TrackLibrary::unknownLoudness;
+		int key = KeyDetector::unknownKey;
+	};
+
+	/**
+	 * Constructor for the TrackAnalyser class.
+	 *
+	 * @param _formatManager	Reference to the audio format manager.
+	 */
+	TrackAnalyser(juce::AudioFormatManager& _formatManager);
+
+	/**
+	 * Destructor for the TrackAnalyser class.
+	 * Stops running analyses and drops any pending results.
+	 */
+	~TrackAnalyser() override;
+
+	/**
+	 * Queues an audio file to be analysed on a background worker.
+	 *
+	 * @param audioTrackFile	The audio track's file.
+	 */
+	void analyseFile(const juce::File& audioTrackFile);
+
+	/**
+	 * Called on the message thread with each batch of analysed audio tracks.
+	 */
+	std::function<void(const std::vector<Analysis>&)> onTracksAnalysed;
+
+private:
+	/**
+	 * Decodes and analyses an audio file. Runs on a background worker.
+	 *
+	 * @param audioTrackFile	The audio track's file.
+	 * @return					The analysis, left unknown if the file cannot be read.
+	 */
+	Analysis analyse(const juce::File& audioTrackFile);
+
+	/**
+	 * AsyncUpdater
+	 * Hands the pending analyses to onTracksAnalysed.
+	 */
+	void handleAsyncUpdate() override;
+
+	/**
+	 * Reference to the audio format manager.
+	 */
+	juce::AudioFormatManager& formatManager;
+
+	/**
+	 * Set when the analyser is destroyed, so running analyses stop early.
+	 */
+	std::atomic<bool> cancelled{ false };
+
+	/**
+	 * Background workers decoding the audio files.
+	 */
+	juce::ThreadPool pool;
+
+	/**
+	 * Analyses finished but not yet handed to the message thread.
+	 */
+	juce::CriticalSection pendingLock;
+	std::vector<Analysis> pendingAnalyses;
+
+	/**
+	 * Audio tracks queued and not yet delivered, and those delivered since the
+	 * queue was last empty with when they were queued, to log the analysis
+	 * rate. Only used on the message thread.
+	 */
+	int numQueued = 0;
+	int batchSize = 0;
+	double batchStartTime = 0.0;
+
+	/**
+	 * Frames decoded at a time.
+	 */
+	static constexpr int blockSize = 16384;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackAnalyser)
+};
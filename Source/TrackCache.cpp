@@ -0,0 +1,331 @@
+/*
+  ==============================================================================
+
+	TrackCache.cpp
+	Created: 20 Oct 2026 10:12:31am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "TrackCache.h"
+
+TrackCache::TrackCache(std::unique_ptr<juce::AudioFormatReader> _reader)
+	: juce::Thread("Track Cache"),
+	reader(std::move(_reader)),
+	numChannels(juce::jlimit(1, 2, static_cast<int>(reader->numChannels))),
+	lengthInSamples(reader->lengthInSamples),
+	numChunks(static_cast<int>((lengthInSamples + chunkSize - 1) / chunkSize)),
+	numSlots(juce::jmin(maxSlots, numChunks)),
+	chunkSlots(new std::atomic<int>[static_cast<size_t>(juce::jmax(1, numChunks))])
+{
+	for (int i = 0; i < numChunks; ++i)
+	{
+		chunkSlots[i] = -1;
+	}
+
+	// Every slot is allocated up front, so the cache never allocates while playing
+	slotData.setSize(numChannels, numSlots * chunkSize);
+	slotChunks.assign(static_cast<size_t>(numSlots), -1);
+
+	startThread();
+}
+
+TrackCache::~TrackCache()
+{
+	stopThread(4000);
+}
+
+int TrackCache::getNumChannels() const
+{
+	return numChannels;
+}
+
+juce::int64 TrackCache::getLengthInSamples() const
+{
+	return lengthInSamples;
+}
+
+double TrackCache::getSampleRate() const
+{
+	return reader->sampleRate;
+}
+
+const float* TrackCache::getChunk(int chunkIndex, int channel) const
+{
+	if (!juce::isPositiveAndBelow(chunkIndex, numChunks))
+	{
+		return nullptr;
+	}
+
+	int slot = chunkSlots[chunkIndex].load(std::memory_order_acquire);
+
+	if (slot < 0 && waitForChunks)
+	{
+		// Ask for the chunk first and wait until the cache thread has decoded it
+		requestedChunk = chunkIndex;
+		readerWaiting = true;
+		notify();
+
+		while ((slot = chunkSlots[chunkIndex].load(std::memory_order_acquire)) < 0 && isThreadRunning())
+		{
+			juce::Thread::yield();
+		}
+
+		readerWaiting = false;
+	}
+
+	// Remember the chunks read this block, a block only reads a few
+	if (slot >= 0 && waitForChunks)
+	{
+		const int numHeld = numHeldChunks;
+		bool isHeld = false;
+
+		for (int i = 0; i < numHeld; ++i)
+		{
+			isHeld = isHeld || heldChunks[static_cast<size_t>(i)] == chunkIndex;
+		}
+
+		if (!isHeld && numHeld < maxHeldChunks)
+		{
+			heldChunks[static_cast<size_t>(numHeld)] = chunkIndex;
+			numHeldChunks = numHeld + 1;
+		}
+	}
+
+	return slot < 0 ? nullptr : slotData.getReadPointer(channel, slot * chunkSize);
+}
+
+void TrackCache::setWaitForChunks(bool shouldWait)
+{
+	waitForChunks = shouldWait;
+}
+
+void TrackCache::audioBlockFinished(juce::int64 position, double velocity)
+{
+	playheadPosition = position;
+	playheadVelocity = velocity;
+	numHeldChunks = 0;
+	++audioBlockCount;
+}
+
+void TrackCache::setPinnedRegion(int regionIndex, juce::Range<juce::int64> region)
+{
+	if (!juce::isPositiveAndBelow(regionIndex, maxPinnedRegions))
+	{
+		return;
+	}
+
+	{
+		const juce::ScopedLock sl(pinnedLock);
+		pinnedRegions[static_cast<size_t>(regionIndex)] = region;
+	}
+
+	notify();
+}
+
+void TrackCache::run()
+{
+	std::vector<int> wantedChunks;
+	wantedChunks.reserve(static_cast<size_t>(numSlots));
+	std::vector<bool> isWanted(static_cast<size_t>(numChunks), false);
+
+	while (!threadShouldExit())
+	{
+		findWantedChunks(wantedChunks);
+
+		for (int chunk : wantedChunks)
+		{
+			isWanted[static_cast<size_t>(chunk)] = true;
+		}
+
+		const int playheadChunk = static_cast<int>(playheadPosition / chunkSize);
+		bool loadedChunk = false;
+		bool lookAgain = false;
+
+		// Load the most urgent missing chunk, then look again in case the playhead jumped
+		for (int chunk : wantedChunks)
+		{
+			if (chunkSlots[chunk] >= 0)
+			{
+				continue;
+			}
+
+			int slot = static_cast<int>(std::find(slotChunks.begin(), slotChunks.end(), -1) - slotChunks.begin());
+
+			if (slot == numSlots)
+			{
+				// Reuse the slot of the unwanted chunk farthest from the playhead
+				int farthestDistance = -1;
+				slot = -1;
+
+				for (int i = 0; i < numSlots; ++i)
+				{
+					const int heldChunk = slotChunks[static_cast<size_t>(i)];
+					const int distance = std::abs(heldChunk - playheadChunk);
+
+					if (!isWanted[static_cast<size_t>(heldChunk)] && distance > farthestDistance)
+					{
+						farthestDistance = distance;
+						slot = i;
+					}
+				}
+
+				if (slot < 0)
+				{
+					break;
+				}
+
+				const int removedChunk = slotChunks[static_cast<size_t>(slot)];
+				chunkSlots[removedChunk] = -1;
+				slotChunks[static_cast<size_t>(slot)] = -1;
+				waitForAudioBlock();
+
+				// A reader that started waiting meanwhile may still read the chunk, so keep it
+				if (isHeldByWaitingReader(removedChunk))
+				{
+					slotChunks[static_cast<size_t>(slot)] = removedChunk;
+					chunkSlots[removedChunk].store(slot, std::memory_order_release);
+					lookAgain = true;
+					break;
+				}
+			}
+
+			loadChunk(chunk, slot);
+			loadedChunk = true;
+			break;
+		}
+
+		for (int chunk : wantedChunks)
+		{
+			isWanted[static_cast<size_t>(chunk)] = false;
+		}
+
+		if (!loadedChunk && !lookAgain)
+		{
+			wait(10);
+		}
+	}
+}
+
+void TrackCache::findWantedChunks(std::vector<int>& wantedChunks)
+{
+	wantedChunks.clear();
+
+	auto addChunk = [this, &wantedChunks](int chunk)
+		{
+			if (juce::isPositiveAndBelow(chunk, numChunks) && static_cast<int>(wantedChunks.size()) < numSlots
+				&& std::find(wantedChunks.begin(), wantedChunks.end(), chunk) == wantedChunks.end())
+			{
+				wantedChunks.push_back(chunk);
+			}
+		};
+
+	// A chunk the reader is waiting for comes first, and those it is still reading stay
+	addChunk(requestedChunk);
+
+	if (readerWaiting)
+	{
+		const int numHeld = numHeldChunks;
+
+		for (int i = 0; i < numHeld; ++i)
+		{
+			addChunk(heldChunks[static_cast<size_t>(i)]);
+		}
+	}
+
+	// Then the chunks about to be played
+	const int playheadChunk = juce::jlimit(0, juce::jmax(0, numChunks - 1), static_cast<int>(playheadPosition / chunkSize));
+	const int direction = playheadVelocity < 0.0 ? -1 : 1;
+
+	addChunk(playheadChunk);
+
+	for (int i = 1; i <= chunksAhead; ++i)
+	{
+		addChunk(playheadChunk + direction * i);
+	}
+
+	for (int i = 1; i <= chunksBehind; ++i)
+	{
+		addChunk(playheadChunk - direction * i);
+	}
+
+	// Then the regions playback may jump to
+	std::array<juce::Range<juce::int64>, maxPinnedRegions> regions;
+	{
+		const juce::ScopedLock sl(pinnedLock);
+		regions = pinnedRegions;
+	}
+
+	for (const auto& region : regions)
+	{
+		if (!region.isEmpty())
+		{
+			const int firstChunk = static_cast<int>(region.getStart() / chunkSize);
+			const int lastChunk = static_cast<int>((region.getEnd() - 1) / chunkSize);
+
+			for (int chunk = firstChunk; chunk <= lastChunk; ++chunk)
+			{
+				addChunk(chunk);
+			}
+		}
+	}
+}
+
+void TrackCache::loadChunk(int chunkIndex, int slot)
+{
+	const juce::int64 chunkStart = static_cast<juce::int64>(chunkIndex) * chunkSize;
+	const int numSamples = static_cast<int>(juce::jmin(static_cast<juce::int64>(chunkSize), lengthInSamples - chunkStart));
+	const int slotStart = slot * chunkSize;
+
+	reader->read(&slotData, slotStart, numSamples, chunkStart, true, true);
+
+	// The last chunk is shorter than the slot
+	if (numSamples < chunkSize)
+	{
+		for (int channel = 0; channel < numChannels; ++channel)
+		{
+			slotData.clear(channel, slotStart + numSamples, chunkSize - numSamples);
+		}
+	}
+
+	slotChunks[static_cast<size_t>(slot)] = chunkIndex;
+	chunkSlots[chunkIndex].store(slot, std::memory_order_release);
+}
+
+void TrackCache::waitForAudioBlock()
+{
+	const juce::uint32 blockCount = audioBlockCount;
+	const juce::uint32 startTime = juce::Time::getMillisecondCounter();
+
+	while (audioBlockCount == blockCount && !readerWaiting && !threadShouldExit())
+	{
+		// No blocks are being rendered, so nothing can be reading the chunk
+		if (juce::Time::getMillisecondCounter() - startTime > 200)
+		{
+			break;
+		}
+
+		sleep(1);
+	}
+}
+
+bool TrackCache::isHeldByWaitingReader(int chunkIndex) const
+{
+	if (!readerWaiting)
+	{
+		return false;
+	}
+
+	const int numHeld = numHeldChunks;
+
+	for (int i = 0; i < numHeld; ++i)
+	{
+		if (heldChunks[static_cast<size_t>(i)] == chunkIndex)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+	TrackCache.h
+	Created: 20 Oct 2026 10:12:31am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * TrackCache class keeps the parts of a deck's audio track that may be
+ * played soon decoded in memory, so the audio thread never reads the disk.
+ *
+ * The track is split into fixed size chunks. A background thread decodes
+ * the chunks around the playhead, ahead in the direction of playback, and
+ * the chunks of any pinned regions such as hot cues, into a fixed pool of
+ * slots allocated up front. The audio thread only looks chunks up; a chunk
+ * that is not ready yet plays as silence.
+ *
+ * A slot is only reused after the audio thread has finished the block it
+ * was in when the slot's chunk was removed, so chunk pointers stay valid
+ * for the rest of a block but must not be kept between blocks.
+ *
+ * When rendering offline, the reader can instead wait for each chunk it
+ * needs, so the output never depends on how fast the file was decoded.
+ */
+class TrackCache : private juce::Thread
+{
+public:
+	/**
+	 * Frames in each chunk, a power of two.
+	 */
+	static constexpr int chunkSize = 16384;
+
+	/**
+	 * Most chunks held in memory at once, about 35 seconds at 44.1kHz.
+	 */
+	static constexpr int maxSlots = 96;
+
+	/**
+	 * Number of regions that can be kept in memory with setPinnedRegion.
+	 */
+	static constexpr int maxPinnedRegions = 16;
+
+	/**
+	 * Constructor for the TrackCache class.
+	 * Starts decoding from the start of the track.
+	 *
+	 * @param _reader	Reader for the audio track, owned by the cache.
+	 */
+	TrackCache(std::unique_ptr<juce::AudioFormatReader> _reader);
+
+	/**
+	 * Destructor for the TrackCache class.
+	 * Must not be called while the audio thread may be reading the cache.
+	 */
+	~TrackCache() override;
+
+	/**
+	 * Returns the number of channels held, at most two.
+	 *
+	 * @return The number of channels.
+	 */
+	int getNumChannels() const;
+
+	/**
+	 * Returns the track length.
+	 *
+	 * @return The length in source samples.
+	 */
+	juce::int64 getLengthInSamples() const;
+
+	/**
+	 * Returns the track's sample rate.
+	 *
+	 * @return The sample rate of the file.
+	 */
+	double getSampleRate() const;
+
+	/**
+	 * Returns a channel of a chunk's decoded audio. Called on the audio thread.
+	 * The pointer is valid until the end of the current audio block.
+	 *
+	 * @param chunkIndex	The chunk, the source sample divided by chunkSize.
+	 * @param channel		The channel, below getNumChannels().
+	 * @return				chunkSize samples, or nullptr if the chunk is not ready.
+	 */
+	const float* getChunk(int chunkIndex, int channel) const;
+
+	/**
+	 * Makes getChunk wait for a chunk that is not ready instead of returning
+	 * nullptr. Only for offline rendering, never on a real-time audio thread.
+	 *
+	 * @param shouldWait	True to wait for chunks.
+	 */
+	void setWaitForChunks(bool shouldWait);
+
+	/**
+	 * Tells the cache where playback is and which way it is heading.
+	 * Called on the audio thread at the end of every block.
+	 *
+	 * @param position		Playhead in source samples.
+	 * @param velocity		Source samples advanced per output sample, negative when playing backwards.
+	 */
+	void audioBlockFinished(juce::int64 position, double velocity);
+
+	/**
+	 * Keeps a region of the track in memory. Called on the message thread.
+	 *
+	 * @param regionIndex	The region, below maxPinnedRegions.
+	 * @param region		Source sample range to keep, or an empty range to release it.
+	 */
+	void setPinnedRegion(int regionIndex, juce::Range<juce::int64> region);
+
+private:
+	/**
+	 * Thread
+	 * Keeps the wanted chunks decoded until the thread is stopped.
+	 */
+	void run() override;
+
+	/**
+	 * Works out the chunks to hold, most urgent first.
+	 */
+	void findWantedChunks(std::vector<int>& wantedChunks);
+
+	/**
+	 * Decodes one chunk into a slot and makes it visible to the audio thread.
+	 */
+	void loadChunk(int chunkIndex, int slot);
+
+	/**
+	 * Waits until the audio thread has finished a block, so chunks removed
+	 * before the call can no longer be read.
+	 */
+	void waitForAudioBlock();
+
+	/**
+	 * Checks if a reader waiting for a chunk has read another chunk in its
+	 * current block, and may still read it once the wait is over.
+	 */
+	bool isHeldByWaitingReader(int chunkIndex) const;
+
+	/**
+	 * Reader for the audio track, only used by the cache thread.
+	 */
+	std::unique_ptr<juce::AudioFormatReader> reader;
+
+	int numChannels;
+	juce::int64 lengthInSamples;
+	int numChunks;
+	int numSlots;
+
+	/**
+	 * Slot of each chunk, or -1 if not ready. Read by the audio thread.
+	 */
+	std::unique_ptr<std::atomic<int>[]> chunkSlots;
+
+	/**
+	 * Decoded audio, one run of chunkSize samples per slot and channel.
+	 */
+	juce::AudioBuffer<float> slotData;
+
+	/**
+	 * Chunk held by each slot, or -1 if free. Only used by the cache thread.
+	 */
+	std::vector<int> slotChunks;
+
+	/**
+	 * Playhead published by the audio thread, and the number of blocks finished.
+	 */
+	std::atomic<juce::int64> playheadPosition{ 0 };
+	std::atomic<double> playheadVelocity{ 1.0 };
+	std::atomic<juce::uint32> audioBlockCount{ 0 };
+
+	/**
+	 * Set when getChunk waits for chunks, and the chunk it is waiting for.
+	 * A waiting reader cannot finish its block, so slots are reused without
+	 * waiting for it, except those of the chunks it has read in the block,
+	 * such as the one a seek crossfade is fading out of.
+	 */
+	std::atomic<bool> waitForChunks{ false };
+	mutable std::atomic<int> requestedChunk{ -1 };
+	mutable std::atomic<bool> readerWaiting{ false };
+	static constexpr int maxHeldChunks = 16;
+	mutable std::array<std::atomic<int>, maxHeldChunks> heldChunks;
+	mutable std::atomic<int> numHeldChunks{ 0 };
+
+	/**
+	 * Regions to keep in memory, set by the message thread.
+	 */
+	juce::CriticalSection pinnedLock;
+	std::array<juce::Range<juce::int64>, maxPinnedRegions> pinnedRegions;
+
+	/**
+	 * Chunks read ahead of the playhead and kept behind it.
+	 */
+	static constexpr int chunksAhead = 8;
+	static constexpr int chunksBehind = 2;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackCache)
+};
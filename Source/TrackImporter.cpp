@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+	TrackImporter.cpp
+	Created: 18 Oct 2026 3:26:54pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "TrackImporter.h"
+
+TrackImporter::TrackImporter(juce::AudioFormatManager& _formatManager)
+	: formatManager(_formatManager),
+	pool(juce::jmax(1, juce::SystemStats::getNumCpus() - 1))
+{
+
+}
+
+TrackImporter::~TrackImporter()
+{
+	pool.removeAllJobs(true, 2000);
+	cancelPendingUpdate();
+}
+
+void TrackImporter::importFile(const juce::File& audioTrackFile)
+{
+	pool.addJob([this, audioTrackFile]()
+		{
+			TrackLibrary::TrackInfo trackInfo = readTrackInfo(audioTrackFile);
+
+			{
+				const juce::ScopedLock sl(pendingLock);
+				pendingTracks.push_back(trackInfo);
+			}
+
+			// Many finished files are delivered in one message thread callback
+			triggerAsyncUpdate();
+		});
+}
+
+TrackLibrary::TrackInfo TrackImporter::readTrackInfo(const juce::File& audioTrackFile)
+{
+	TrackLibrary::TrackInfo trackInfo;
+	trackInfo.url = juce::URL{ audioTrackFile }.toString(false);
+	trackInfo.format = TrackLibrary::getFormatFromFile(audioTrackFile);
+
+	// Tags stored in the file are the most reliable, read them first
+	TrackTagReader::readFileTags(audioTrackFile, trackInfo);
+
+	// An MP3 reader scans every frame to find the length, so skip it when the tags had the length
+	if (trackInfo.format == TrackLibrary::AudioFormat::MP3 && trackInfo.lengthInSamples > 0)
+	{
+		readFileNameTags(audioTrackFile, trackInfo);
+		return trackInfo;
+	}
+
+	// Opening a reader parses the header, except for an MP3 without its length in the tags
+	std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(audioTrackFile));
+
+	if (reader != nullptr)
+	{
+		trackInfo.lengthInSamples = reader->lengthInSamples;
+		trackInfo.sampleRate = static_cast<juce::uint32>(reader->sampleRate);
+
+		TrackTagReader::readReaderMetadata(reader->metadataValues, trackInfo);
+	}
+	else
+	{
+		// Leave the length at zero if error occur
+		DBG("< Cannot read the length of: " << audioTrackFile.getFullPathName() << " >");
+	}
+
+	// Fall back to the file name for anything still missing
+	readFileNameTags(audioTrackFile, trackInfo);
+
+	return trackInfo;
+}
+
+void TrackImporter::readFileNameTags(const juce::File& audioTrackFile, TrackLibrary::TrackInfo& trackInfo)
+{
+	juce::String fileName = audioTrackFile.getFileNameWithoutExtension();
+
+	// Find the pos of the first "-"
+	int dash = fileName.indexOf("-");
+
+	if (dash != -1 && dash < fileName.length() - 1)
+	{
+		// Extract the title starting from the character after "-"
+		if (trackInfo.title.isEmpty())
+		{
+			trackInfo.title = fileName.substring(dash + 1).trim();
+		}
+
+		// And the artist before it
+		if (trackInfo.artist.isEmpty())
+		{
+			trackInfo.artist = fileName.substring(0, dash).trim();
+		}
+	}
+	else if (trackInfo.title.isEmpty())
+	{
+		// Use the file name without extension if no "-" found or if it's the last character
+		trackInfo.title = fileName;
+	}
+}
+
+void TrackImporter::handleAsyncUpdate()
+{
+	std::vector<TrackLibrary::TrackInfo> importedTracks;
+
+	{
+		const juce::ScopedLock sl(pendingLock);
+		importedTracks.swap(pendingTracks);
+	}
+
+	if (!importedTracks.empty() && onTracksImported != nullptr)
+	{
+		onTracksImported(importedTracks);
+	}
+}
@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+	TrackImporter.h
+	Created: 18 Oct 2026 3:26:54pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <vector>
+#include "TrackLibrary.h"
+#include "TrackTagReader.h"
+
+/**
+ * TrackImporter class reads the metadata of imported audio files on
+ * background workers so the playlist stays responsive while importing.
+ *
+ * Each file's length, sample rate and tags are read from its header,
+ * never decoding any audio. An MP3's length comes from its Xing, Info or
+ * VBRI frame or its ID3 length; only an MP3 with none of these is opened
+ * with a reader, which scans its frames. Finished audio tracks are
+ * collected and handed back to the message thread in batches.
+ *
+ * This class inherits from juce::AsyncUpdater to deliver the results on the
+ * message thread.
+ */
+class TrackImporter : private juce::AsyncUpdater
+{
+public:
+	/**
+	 * Constructor for the TrackImporter class.
+	 *
+	 * @param _formatManager	Reference to the audio format manager.
+	 */
+	TrackImporter(juce::AudioFormatManager& _formatManager);
+
+	/**
+	 * Destructor for the TrackImporter class.
+	 * Waits for running workers and drops any pending results.
+	 */
+	~TrackImporter() override;
+
+	/**
+	 * Queues an audio file to be read on a background worker.
+	 *
+	 * @param audioTrackFile	The audio track's file.
+	 */
+	void importFile(const juce::File& audioTrackFile);
+
+	/**
+	 * Called on the message thread with each batch of imported audio tracks.
+	 */
+	std::function<void(const std::vector<TrackLibrary::TrackInfo>&)> onTracksImported;
+
+	/**
+	 * Extracts audio track's title and artist from a "Artist - Title" file name.
+	 * Used when the file has no tags.
+	 *
+	 * @param audioTrackFile	The audio track's file.
+	 * @param trackInfo			The audio track's metadata to fill in.
+	 */
+	static void readFileNameTags(const juce::File& audioTrackFile, TrackLibrary::TrackInfo& trackInfo);
+
+private:
+	/**
+	 * Reads the metadata of an audio file. Runs on a background worker.
+	 *
+	 * @param audioTrackFile	The audio track's file.
+	 * @return					The audio track's metadata.
+	 */
+	TrackLibrary::TrackInfo readTrackInfo(const juce::File& audioTrackFile);
+
+	/**
+	 * AsyncUpdater
+	 * Hands the pending audio tracks to onTracksImported.
+	 */
+	void handleAsyncUpdate() override;
+
+	/**
+	 * Reference to the audio format manager.
+	 */
+	juce::AudioFormatManager& formatManager;
+
+	/**
+	 * Background workers reading the audio files.
+	 */
+	juce::ThreadPool pool;
+
+	/**
+	 * Audio tracks read but not yet handed to the message thread.
+	 */
+	juce::CriticalSection pendingLock;
+	std::vector<TrackLibrary::TrackInfo> pendingTracks;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackImporter)
+};
@@ -0,0 +1,320 @@
+/*
+  ==============================================================================
+
+	TrackLibrary.cpp
+	Created: 18 Oct 2026 1:12:09pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "TrackLibrary.h"
+
+// Keeps the values whose flag is false, in order
+template <typename ValueType>
+static void removeFlagged(std::vector<ValueType>& values, const std::vector<bool>& shouldRemove)
+{
+	size_t kept = 0;
+
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		if (!shouldRemove[i])
+		{
+			values[kept++] = std::move(values[i]);
+		}
+	}
+
+	values.resize(kept);
+}
+
+TrackLibrary::TrackLibrary()
+{
+
+}
+
+TrackLibrary::~TrackLibrary()
+{
+
+}
+
+int TrackLibrary::addTrack(const TrackInfo& track)
+{
+	titleIds.push_back(intern(track.title));
+	artistIds.push_back(intern(track.artist));
+	albumIds.push_back(intern(track.album));
+	genreIds.push_back(intern(track.genre));
+	keyIds.push_back(intern(track.key));
+	bpms.push_back(track.bpm);
+	urlIds.push_back(intern(track.url));
+	lengthsInSamples.push_back(track.lengthInSamples);
+	sampleRates.push_back(track.sampleRate);
+	formats.push_back(track.format);
+
+	// New audio tracks start without hot cues
+	HotCues noHotCues;
+	noHotCues.fill(-1);
+	hotCues.push_back(noHotCues);
+
+	loudnesses.push_back(track.loudness);
+	detectedKeys.push_back(static_cast<juce::int8>(track.detectedKey));
+
+	return getNumTracks() - 1;
+}
+
+void TrackLibrary::removeTrack(int index)
+{
+	if (index < 0 || index >= getNumTracks())
+	{
+		DBG("TrackLibrary::removeTrack index out of range");
+		return;
+	}
+
+	titleIds.erase(titleIds.begin() + index);
+	artistIds.erase(artistIds.begin() + index);
+	albumIds.erase(albumIds.begin() + index);
+	genreIds.erase(genreIds.begin() + index);
+	keyIds.erase(keyIds.begin() + index);
+	bpms.erase(bpms.begin() + index);
+	urlIds.erase(urlIds.begin() + index);
+	lengthsInSamples.erase(lengthsInSamples.begin() + index);
+	sampleRates.erase(sampleRates.begin() + index);
+	formats.erase(formats.begin() + index);
+	hotCues.erase(hotCues.begin() + index);
+	loudnesses.erase(loudnesses.begin() + index);
+	detectedKeys.erase(detectedKeys.begin() + index);
+}
+
+void TrackLibrary::removeTracks(const std::vector<bool>& shouldRemove)
+{
+	if (static_cast<int>(shouldRemove.size()) != getNumTracks())
+	{
+		DBG("TrackLibrary::removeTracks needs a flag for every audio track");
+		return;
+	}
+
+	removeFlagged(titleIds, shouldRemove);
+	removeFlagged(artistIds, shouldRemove);
+	removeFlagged(albumIds, shouldRemove);
+	removeFlagged(genreIds, shouldRemove);
+	removeFlagged(keyIds, shouldRemove);
+	removeFlagged(bpms, shouldRemove);
+	removeFlagged(urlIds, shouldRemove);
+	removeFlagged(lengthsInSamples, shouldRemove);
+	removeFlagged(sampleRates, shouldRemove);
+	removeFlagged(formats, shouldRemove);
+	removeFlagged(hotCues, shouldRemove);
+	removeFlagged(loudnesses, shouldRemove);
+	removeFlagged(detectedKeys, shouldRemove);
+}
+
+void TrackLibrary::relocateTrack(int index, const juce::String& url)
+{
+	if (index < 0 || index >= getNumTracks())
+	{
+		DBG("TrackLibrary::relocateTrack index out of range");
+		return;
+	}
+
+	urlIds[index] = intern(url);
+}
+
+int TrackLibrary::getNumTracks() const
+{
+	return static_cast<int>(titleIds.size());
+}
+
+bool TrackLibrary::containsURL(const juce::String& url) const
+{
+	return indexOfURL(url) >= 0;
+}
+
+int TrackLibrary::indexOfURL(const juce::String& url) const
+{
+	auto interned = internedIds.find(url);
+	if (interned == internedIds.end())
+	{
+		return -1;
+	}
+
+	auto found = std::find(urlIds.begin(), urlIds.end(), interned->second);
+	return found != urlIds.end() ? static_cast<int>(found - urlIds.begin()) : -1;
+}
+
+juce::File TrackLibrary::getFile(int index) const
+{
+	return juce::URL(getURL(index)).getLocalFile();
+}
+
+const juce::String& TrackLibrary::getTitle(int index) const
+{
+	return internedStrings.getReference(titleIds[index]);
+}
+
+const juce::String& TrackLibrary::getArtist(int index) const
+{
+	return internedStrings.getReference(artistIds[index]);
+}
+
+const juce::String& TrackLibrary::getAlbum(int index) const
+{
+	return internedStrings.getReference(albumIds[index]);
+}
+
+const juce::String& TrackLibrary::getGenre(int index) const
+{
+	return internedStrings.getReference(genreIds[index]);
+}
+
+const juce::String& TrackLibrary::getKey(int index) const
+{
+	return internedStrings.getReference(keyIds[index]);
+}
+
+float TrackLibrary::getBpm(int index) const
+{
+	return bpms[index];
+}
+
+const juce::String& TrackLibrary::getURL(int index) const
+{
+	return internedStrings.getReference(urlIds[index]);
+}
+
+juce::int64 TrackLibrary::getLengthInSamples(int index) const
+{
+	return lengthsInSamples[index];
+}
+
+juce::uint32 TrackLibrary::getSampleRate(int index) const
+{
+	return sampleRates[index];
+}
+
+double TrackLibrary::getLengthInSeconds(int index) const
+{
+	if (sampleRates[index] == 0)
+	{
+		return 0.0;
+	}
+	return lengthsInSamples[index] / static_cast<double>(sampleRates[index]);
+}
+
+TrackLibrary::AudioFormat TrackLibrary::getFormat(int index) const
+{
+	return formats[index];
+}
+
+const TrackLibrary::HotCues& TrackLibrary::getHotCues(int index) const
+{
+	return hotCues[index];
+}
+
+float TrackLibrary::getLoudness(int index) const
+{
+	return loudnesses[index];
+}
+
+int TrackLibrary::getDetectedKey(int index) const
+{
+	return detectedKeys[index];
+}
+
+void TrackLibrary::setHotCue(int index, int cueIndex, juce::int64 position)
+{
+	if (index < 0 || index >= getNumTracks() || cueIndex < 0 || cueIndex >= numHotCues)
+	{
+		DBG("TrackLibrary::setHotCue index out of range");
+		return;
+	}
+
+	hotCues[index][cueIndex] = position < 0 ? -1 : position;
+}
+
+void TrackLibrary::setLoudness(int index, float loudness)
+{
+	if (index < 0 || index >= getNumTracks())
+	{
+		DBG("TrackLibrary::setLoudness index out of range");
+		return;
+	}
+
+	loudnesses[index] = loudness;
+}
+
+void TrackLibrary::setDetectedKey(int index, int key)
+{
+	if (index < 0 || index >= getNumTracks())
+	{
+		DBG("TrackLibrary::setDetectedKey index out of range");
+		return;
+	}
+
+	detectedKeys[index] = static_cast<juce::int8>(juce::isPositiveAndBelow(key, KeyDetector::numKeys) ? key : KeyDetector::unknownKey);
+}
+
+TrackLibrary::AudioFormat TrackLibrary::getFormatFromFile(const juce::File& audioTrackFile)
+{
+	// Get file extension without the dot
+	juce::String fileExtension = audioTrackFile.getFileExtension().toLowerCase().trimCharactersAtStart(".");
+
+	if (fileExtension == "mp3")							return AudioFormat::MP3;
+	if (fileExtension == "wav")							return AudioFormat::WAV;
+	if (fileExtension == "aif" || fileExtension == "aiff")	return AudioFormat::AIFF;
+	if (fileExtension == "flac")						return AudioFormat::FLAC;
+	if (fileExtension == "ogg")							return AudioFormat::OGG;
+	if (fileExtension == "m4a")							return AudioFormat::M4A;
+	if (fileExtension == "wma")							return AudioFormat::WMA;
+
+	return AudioFormat::Other;
+}
+
+juce::String TrackLibrary::getFormatName(AudioFormat format)
+{
+	switch (format)
+	{
+	case AudioFormat::MP3:		return "MP3";
+	case AudioFormat::WAV:		return "WAV";
+	case AudioFormat::AIFF:		return "AIFF";
+	case AudioFormat::FLAC:		return "FLAC";
+	case AudioFormat::OGG:		return "OGG";
+	case AudioFormat::M4A:		return "M4A";
+	case AudioFormat::WMA:		return "WMA";
+	case AudioFormat::Other:
+	default:					return "OTHER";
+	}
+}
+
+juce::String TrackLibrary::formatLength(double lengthInSeconds)
+{
+	// Convert to hours, minutes, and seconds
+	int hours = static_cast<int>(lengthInSeconds / 3600);
+	int minutes = static_cast<int>((lengthInSeconds - hours * 3600) / 60);
+	int seconds = static_cast<int>(lengthInSeconds - hours * 3600 - minutes * 60);
+
+	// Format the track length as hour:minute:second
+	return juce::String::formatted("%02d : %02d : %02d", hours, minutes, seconds);
+}
+
+juce::String TrackLibrary::formatLoudness(float loudness)
+{
+	if (loudness == unknownLoudness)
+	{
+		return "...";
+	}
+	return juce::String(loudness, 1) + " LUFS";
+}
+
+int TrackLibrary::intern(const juce::String& text)
+{
+	auto interned = internedIds.find(text);
+	if (interned != internedIds.end())
+	{
+		return interned->second;
+	}
+
+	int id = internedStrings.size();
+	internedStrings.add(text);
+	internedIds.emplace(text, id);
+
+	return id;
+}
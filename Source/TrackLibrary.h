@@ -0,0 +1,254 @@
+/*
+  ==============================================================================
+
+	TrackLibrary.h
+	Created: 18 Oct 2026 1:12:09pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+#include "KeyDetector.h"
+
+/**
+ * TrackLibrary class stores the playlist's track metadata as typed columns.
+ *
+ * Each field lives in its own contiguous vector indexed by track, text is
+ * interned so repeated values share one string, the length is kept as a
+ * sample count with its sample rate, and the file type is a small enum.
+ * Display strings are only formatted when a cell is painted, which keeps
+ * each track small and lets sorting and searching scan plain arrays.
+ */
+class TrackLibrary
+{
+public:
+	/**
+	 * Audio file formats recognised by the library.
+	 */
+	enum class AudioFormat : juce::uint8 { MP3, WAV, AIFF, FLAC, OGG, M4A, WMA, Other };
+
+	/**
+	 * Number of hot cues stored per audio track.
+	 */
+	static constexpr int numHotCues = 8;
+
+	/**
+	 * Hot cue positions in samples of the audio file, -1 if not set.
+	 */
+	using HotCues = std::array<juce::int64, numHotCues>;
+
+	/**
+	 * Loudness of an audio track that has not been analysed yet.
+	 */
+	static constexpr float unknownLoudness = -std::numeric_limits<float>::infinity();
+
+	/**
+	 * Metadata of a single audio track, used to add tracks to the library.
+	 */
+	struct TrackInfo
+	{
+		juce::String title;
+		juce::String artist;
+		juce::String album;
+		juce::String genre;
+		juce::String key;
+		float bpm = 0.0f;
+		juce::String url;
+		juce::int64 lengthInSamples = 0;
+		juce::uint32 sampleRate = 0;
+		AudioFormat format = AudioFormat::Other;
+		float loudness = unknownLoudness;
+		int detectedKey = KeyDetector::unknownKey;
+	};
+
+	/**
+	 * Constructor for the TrackLibrary class.
+	 */
+	TrackLibrary();
+
+	/**
+	 * Destructor for the TrackLibrary class.
+	 */
+	~TrackLibrary();
+
+	/**
+	 * Appends an audio track to the library.
+	 *
+	 * @param track		The audio track's metadata.
+	 * @return			Index of the new audio track.
+	 */
+	int addTrack(const TrackInfo& track);
+
+	/**
+	 * Removes the audio track at the given index.
+	 * Later audio tracks move down by one index.
+	 *
+	 * @param index		The audio track's index.
+	 */
+	void removeTrack(int index);
+
+	/**
+	 * Removes every flagged audio track in one pass over each column.
+	 * The remaining audio tracks keep their order.
+	 *
+	 * @param shouldRemove	A flag for each audio track, true to remove it.
+	 */
+	void removeTracks(const std::vector<bool>& shouldRemove);
+
+	/**
+	 * Points the audio track at the given index to a new file location.
+	 *
+	 * @param index		The audio track's index.
+	 * @param url		The audio track's new URL.
+	 */
+	void relocateTrack(int index, const juce::String& url);
+
+	/**
+	 * Returns the number of audio tracks.
+	 *
+	 * @return The number of audio tracks.
+	 */
+	int getNumTracks() const;
+
+	/**
+	 * Checks if an audio track with the given URL already exists.
+	 *
+	 * @param url		The audio track's URL.
+	 * @return			True if the audio track exists; otherwise, False.
+	 */
+	bool containsURL(const juce::String& url) const;
+
+	/**
+	 * Finds the audio track with the given URL.
+	 *
+	 * @param url		The audio track's URL.
+	 * @return			The audio track's index, or -1 if not found.
+	 */
+	int indexOfURL(const juce::String& url) const;
+
+	/**
+	 * Returns the local file of the audio track at the given index.
+	 *
+	 * @param index		The audio track's index.
+	 * @return			The audio track's file.
+	 */
+	juce::File getFile(int index) const;
+
+	/**
+	 * Getters for each column of the audio track at the given index.
+	 */
+	const juce::String& getTitle(int index) const;
+	const juce::String& getArtist(int index) const;
+	const juce::String& getAlbum(int index) const;
+	const juce::String& getGenre(int index) const;
+	const juce::String& getKey(int index) const;
+	float getBpm(int index) const;
+	const juce::String& getURL(int index) const;
+	juce::int64 getLengthInSamples(int index) const;
+	juce::uint32 getSampleRate(int index) const;
+	double getLengthInSeconds(int index) const;
+	AudioFormat getFormat(int index) const;
+	const HotCues& getHotCues(int index) const;
+	float getLoudness(int index) const;
+	int getDetectedKey(int index) const;
+
+	/**
+	 * Sets or clears a hot cue of the audio track at the given index.
+	 *
+	 * @param index		The audio track's index.
+	 * @param cueIndex	The hot cue, below numHotCues.
+	 * @param position	The cue position in samples of the audio file, or -1 to clear it.
+	 */
+	void setHotCue(int index, int cueIndex, juce::int64 position);
+
+	/**
+	 * Stores the analysed loudness of the audio track at the given index.
+	 *
+	 * @param index		The audio track's index.
+	 * @param loudness	The integrated loudness in LUFS.
+	 */
+	void setLoudness(int index, float loudness);
+
+	/**
+	 * Formats a loudness as "-9.5 LUFS", or "..." while unknown.
+	 *
+	 * @param loudness	The loudness in LUFS.
+	 * @return			The formatted loudness.
+	 */
+	static juce::String formatLoudness(float loudness);
+
+	/**
+	 * Stores the key detected in the audio track at the given index.
+	 * Kept apart from the key tag, which may be in any notation.
+	 *
+	 * @param index		The audio track's index.
+	 * @param key		The key as numbered by KeyDetector.
+	 */
+	void setDetectedKey(int index, int key);
+
+	/**
+	 * Works out the audio format from a file's extension.
+	 *
+	 * @param audioTrackFile	The audio track's file.
+	 * @return					The audio format.
+	 */
+	static AudioFormat getFormatFromFile(const juce::File& audioTrackFile);
+
+	/**
+	 * Returns the display name of an audio format.
+	 *
+	 * @param format	The audio format.
+	 * @return			Upper case format name.
+	 */
+	static juce::String getFormatName(AudioFormat format);
+
+	/**
+	 * Formats a length as "hour : minute : second".
+	 *
+	 * @param lengthInSeconds	The length in seconds.
+	 * @return					The formatted length.
+	 */
+	static juce::String formatLength(double lengthInSeconds);
+
+private:
+	/**
+	 * Returns the id of the shared copy of the text, adding it if new.
+	 *
+	 * @param text		Text to intern.
+	 * @return			Interned string id.
+	 */
+	int intern(const juce::String& text);
+
+	/**
+	 * Interned strings and their lookup table.
+	 * Strings are kept for the lifetime of the library.
+	 */
+	juce::StringArray internedStrings;
+	std::unordered_map<juce::String, int> internedIds;
+
+	/**
+	 * One column per field, indexed by audio track.
+	 */
+	std::vector<int> titleIds;
+	std::vector<int> artistIds;
+	std::vector<int> albumIds;
+	std::vector<int> genreIds;
+	std::vector<int> keyIds;
+	std::vector<float> bpms;
+	std::vector<int> urlIds;
+	std::vector<juce::int64> lengthsInSamples;
+	std::vector<juce::uint32> sampleRates;
+	std::vector<AudioFormat> formats;
+	std::vector<HotCues> hotCues;
+	std::vector<float> loudnesses;
+	std::vector<juce::int8> detectedKeys;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackLibrary)
+};
@@ -0,0 +1,255 @@
+/*
+  ==============================================================================
+
+	TrackSearch.cpp
+	Created: 18 Oct 2026 10:04:12am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "TrackSearch.h"
+
+TrackSearch::TrackSearch()
+	: pool(juce::SystemStats::getNumCpus())
+{
+
+}
+
+TrackSearch::~TrackSearch()
+{
+	pool.removeAllJobs(true, 1000);
+}
+
+void TrackSearch::setCandidates(const juce::StringArray& candidates)
+{
+	foldedCandidates.clear();
+	foldedCandidates.reserve(candidates.size());
+
+	// Fold once here so every search only compares raw bytes
+	for (const auto& candidate : candidates)
+	{
+		foldedCandidates.push_back(foldText(candidate));
+	}
+}
+
+std::vector<TrackSearch::Result> TrackSearch::search(const juce::String& query)
+{
+	std::vector<Result> results;
+
+	PreparedQuery preparedQuery;
+	preparedQuery.text = foldText(query.trim());
+
+	if (preparedQuery.text.empty())
+	{
+		return results;
+	}
+
+	// Bit masks of where each byte occurs in the query, used by the Myers kernel
+	preparedQuery.charMasks.fill(0);
+	const int maskLength = juce::jmin(64, static_cast<int>(preparedQuery.text.size()));
+	for (int i = 0; i < maskLength; ++i)
+	{
+		preparedQuery.charMasks[static_cast<unsigned char>(preparedQuery.text[i])] |= (juce::uint64)1 << i;
+	}
+
+	// Allow more typos as the query gets longer, counting only the bytes the kernel compares
+	preparedQuery.maxTypos = maskLength < 3 ? 0 : (maskLength < 6 ? 1 : (maskLength < 10 ? 2 : 3));
+
+	const int numCandidates = static_cast<int>(foldedCandidates.size());
+	scores.assign(numCandidates, -1);
+
+	if (numCandidates < parallelThreshold)
+	{
+		scoreRange(preparedQuery, 0, numCandidates);
+	}
+	else
+	{
+		// Split into a few chunks per worker so uneven chunks still balance out
+		const int chunkSize = juce::jmax(1, numCandidates / (pool.getNumThreads() * 4));
+		const int numChunks = (numCandidates + chunkSize - 1) / chunkSize;
+
+		std::atomic<int> remainingChunks{ numChunks };
+		juce::WaitableEvent allChunksScored;
+
+		for (int start = 0; start < numCandidates; start += chunkSize)
+		{
+			const int end = juce::jmin(numCandidates, start + chunkSize);
+
+			pool.addJob([this, &preparedQuery, &remainingChunks, &allChunksScored, start, end]()
+				{
+					scoreRange(preparedQuery, start, end);
+
+					if (--remainingChunks == 0)
+					{
+						allChunksScored.signal();
+					}
+				});
+		}
+		allChunksScored.wait();
+	}
+
+	// Collect matches in playlist order, then rank them by score
+	for (int i = 0; i < numCandidates; ++i)
+	{
+		if (scores[i] >= 0)
+		{
+			results.push_back({ i, scores[i] });
+		}
+	}
+
+	std::stable_sort(results.begin(), results.end(), [](const Result& a, const Result& b)
+		{
+			return a.score > b.score;
+		});
+
+	return results;
+}
+
+// Lower case ASCII only, so the kernels never need to decode UTF-8
+std::string TrackSearch::foldText(const juce::String& text)
+{
+	std::string folded(text.toRawUTF8());
+
+	for (auto& c : folded)
+	{
+		if (c >= 'A' && c <= 'Z')
+		{
+			c = static_cast<char>(c + ('a' - 'A'));
+		}
+	}
+	return folded;
+}
+
+int TrackSearch::scoreSubsequence(const std::string& query, const std::string& candidate)
+{
+	const size_t queryLength = query.size();
+	const size_t candidateLength = candidate.size();
+
+	size_t queryIndex = 0;
+	int lastMatch = -2;
+	int score = 0;
+
+	for (size_t i = 0; i < candidateLength && queryIndex < queryLength; ++i)
+	{
+		if (candidate[i] != query[queryIndex])
+		{
+			continue;
+		}
+
+		score += 10;
+
+		// Reward runs of consecutive characters
+		if (static_cast<int>(i) == lastMatch + 1)
+		{
+			score += 15;
+		}
+
+		// Reward matches at the start of a word
+		if (i == 0 || !juce::CharacterFunctions::isLetterOrDigit(candidate[i - 1]))
+		{
+			score += 20;
+		}
+
+		// Penalise a late first match
+		if (queryIndex == 0)
+		{
+			score -= juce::jmin(static_cast<int>(i), 20);
+		}
+
+		lastMatch = static_cast<int>(i);
+		++queryIndex;
+	}
+
+	if (queryIndex < queryLength)
+	{
+		return -1;
+	}
+
+	// Prefer shorter titles when everything else is equal
+	score -= static_cast<int>((candidateLength - queryLength) / 8);
+
+	return juce::jmax(score, 0);
+}
+
+int TrackSearch::approximateDistance(const PreparedQuery& query, const std::string& candidate)
+{
+	const int queryLength = juce::jmin(64, static_cast<int>(query.text.size()));
+	const juce::uint64 lastBit = (juce::uint64)1 << (queryLength - 1);
+
+	// Vertical positive and negative deltas of the edit distance matrix
+	juce::uint64 positiveVertical = ~(juce::uint64)0;
+	juce::uint64 negativeVertical = 0;
+
+	int distance = queryLength;
+	int bestDistance = queryLength;
+
+	for (const char c : candidate)
+	{
+		const juce::uint64 equal = query.charMasks[static_cast<unsigned char>(c)];
+		const juce::uint64 xVertical = equal | negativeVertical;
+		const juce::uint64 xHorizontal = (((equal & positiveVertical) + positiveVertical) ^ positiveVertical) | equal;
+
+		juce::uint64 positiveHorizontal = negativeVertical | ~(xHorizontal | positiveVertical);
+		juce::uint64 negativeHorizontal = positiveVertical & xHorizontal;
+
+		if (positiveHorizontal & lastBit)
+		{
+			++distance;
+		}
+		else if (negativeHorizontal & lastBit)
+		{
+			--distance;
+		}
+
+		// No carry into bit 0: a match may start anywhere in the candidate
+		positiveHorizontal <<= 1;
+		negativeHorizontal <<= 1;
+
+		positiveVertical = negativeHorizontal | ~(xVertical | positiveHorizontal);
+		negativeVertical = positiveHorizontal & xVertical;
+
+		bestDistance = juce::jmin(bestDistance, distance);
+
+		if (bestDistance == 0)
+		{
+			break;
+		}
+	}
+	return bestDistance;
+}
+
+int TrackSearch::scoreCandidate(const PreparedQuery& query, const std::string& candidate)
+{
+	if (candidate.empty())
+	{
+		return -1;
+	}
+
+	// Exact subsequence matches always rank above typo matches
+	const int subsequenceScore = scoreSubsequence(query.text, candidate);
+	if (subsequenceScore >= 0)
+	{
+		return 1000 + subsequenceScore;
+	}
+
+	if (query.maxTypos == 0)
+	{
+		return -1;
+	}
+
+	const int distance = approximateDistance(query, candidate);
+	if (distance <= query.maxTypos)
+	{
+		return 500 - distance * 100;
+	}
+	return -1;
+}
+
+void TrackSearch::scoreRange(const PreparedQuery& query, int start, int end)
+{
+	for (int i = start; i < end; ++i)
+	{
+		scores[i] = scoreCandidate(query, foldedCandidates[i]);
+	}
+}
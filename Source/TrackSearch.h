@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+	TrackSearch.h
+	Created: 18 Oct 2026 10:04:12am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <string>
+#include <vector>
+
+/**
+ * TrackSearch class ranks the playlist's audio tracks against a search query
+ * with typo-tolerant fuzzy matching.
+ *
+ * Every candidate is scored by an ordered subsequence match (bonuses for
+ * consecutive characters and word starts) and, when that fails, by the
+ * approximate edit distance between the query and the best matching window
+ * of the candidate. Candidates are case folded once into plain byte strings
+ * so the scoring kernels run over contiguous memory, and large libraries are
+ * split into chunks that are scored in parallel on a thread pool.
+ */
+class TrackSearch
+{
+public:
+	/**
+	 * A single ranked search result.
+	 */
+	struct Result
+	{
+		int index;		// Index of the candidate passed to setCandidates().
+		int score;		// Higher is better.
+	};
+
+	/**
+	 * Constructor for the TrackSearch class.
+	 * Creates one worker per CPU core for scoring large libraries.
+	 */
+	TrackSearch();
+
+	/**
+	 * Destructor for the TrackSearch class.
+	 */
+	~TrackSearch();
+
+	/**
+	 * Replaces the searchable candidates.
+	 * Call whenever the playlist content changes.
+	 *
+	 * @param candidates	Text to search for each audio track, in playlist order.
+	 */
+	void setCandidates(const juce::StringArray& candidates);
+
+	/**
+	 * Ranks every candidate against the query.
+	 *
+	 * @param query		The search query.
+	 * @return			Matching candidates ordered by descending score,
+	 *					ties resolved by playlist order.
+	 */
+	std::vector<Result> search(const juce::String& query);
+
+private:
+	/**
+	 * Query prepared once per search and shared read-only by every worker.
+	 */
+	struct PreparedQuery
+	{
+		std::string text;
+		std::array<juce::uint64, 256> charMasks;
+		int maxTypos;
+	};
+
+	/**
+	 * Lower cases ASCII letters and keeps other bytes of the UTF-8 text untouched.
+	 *
+	 * @param text		Text to fold.
+	 * @return			Case folded UTF-8 bytes.
+	 */
+	static std::string foldText(const juce::String& text);
+
+	/**
+	 * Scores an ordered subsequence match of the query within the candidate.
+	 *
+	 * @param query			Folded query.
+	 * @param candidate		Folded candidate.
+	 * @return				Match score, or -1 when the query is not a subsequence.
+	 */
+	static int scoreSubsequence(const std::string& query, const std::string& candidate);
+
+	/**
+	 * Bit-parallel (Myers) approximate substring matching.
+	 * Computes the smallest edit distance between the query and any window
+	 * of the candidate, processing one candidate byte per step.
+	 *
+	 * @param query			Prepared query (at most 64 bytes are used).
+	 * @param candidate		Folded candidate.
+	 * @return				Smallest edit distance found.
+	 */
+	static int approximateDistance(const PreparedQuery& query, const std::string& candidate);
+
+	/**
+	 * Scores one candidate against the query.
+	 *
+	 * @param query			Prepared query.
+	 * @param candidate		Folded candidate.
+	 * @return				Score, or -1 if the candidate does not match.
+	 */
+	static int scoreCandidate(const PreparedQuery& query, const std::string& candidate);
+
+	/**
+	 * Scores a contiguous range of candidates into the score table.
+	 *
+	 * @param query			Prepared query.
+	 * @param start			First candidate index.
+	 * @param end			One past the last candidate index.
+	 */
+	void scoreRange(const PreparedQuery& query, int start, int end);
+
+	/**
+	 * Case folded text for each candidate.
+	 */
+	std::vector<std::string> foldedCandidates;
+
+	/**
+	 * Score of each candidate for the current search.
+	 */
+	std::vector<int> scores;
+
+	/**
+	 * Workers used to score large libraries in parallel.
+	 */
+	juce::ThreadPool pool;
+
+	/**
+	 * Libraries smaller than this are scored on the calling thread.
+	 */
+	static constexpr int parallelThreshold = 4096;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackSearch)
+};
@@ -0,0 +1,526 @@
+/*
+  ==============================================================================
+
+	TrackTagReader.cpp
+	Created: 18 Oct 2026 2:48:30pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "TrackTagReader.h"
+
+// Standard ID3v1 genres, referenced by number from ID3 tags
+static const char* const id3Genres[] =
+{
+	"Blues", "Classic Rock", "Country", "Dance", "Disco", "Funk", "Grunge", "Hip-Hop",
+	"Jazz", "Metal", "New Age", "Oldies", "Other", "Pop", "R&B", "Rap",
+	"Reggae", "Rock", "Techno", "Industrial", "Alternative", "Ska", "Death Metal", "Pranks",
+	"Soundtrack", "Euro-Techno", "Ambient", "Trip-Hop", "Vocal", "Jazz+Funk", "Fusion", "Trance",
+	"Classical", "Instrumental", "Acid", "House", "Game", "Sound Clip", "Gospel", "Noise",
+	"AlternRock", "Bass", "Soul", "Punk", "Space", "Meditative", "Instrumental Pop", "Instrumental Rock",
+	"Ethnic", "Gothic", "Darkwave", "Techno-Industrial", "Electronic", "Pop-Folk", "Eurodance", "Dream",
+	"Southern Rock", "Comedy", "Cult", "Gangsta", "Top 40", "Christian Rap", "Pop/Funk", "Jungle",
+	"Native American", "Cabaret", "New Wave", "Psychadelic", "Rave", "Showtunes", "Trailer", "Lo-Fi",
+	"Tribal", "Acid Punk", "Acid Jazz", "Polka", "Retro", "Musical", "Rock & Roll", "Hard Rock"
+};
+
+// Text frames above this size are not plain tags (e.g. artwork) and are skipped
+static constexpr int maxTagValueSize = 64 * 1024;
+
+// Maps an ID3v2.2 / v2.3 / v2.4 frame ID to a field name
+static juce::String getID3Field(const juce::String& frameId)
+{
+	if (frameId == "TIT2" || frameId == "TT2")	return "title";
+	if (frameId == "TPE1" || frameId == "TP1")	return "artist";
+	if (frameId == "TALB" || frameId == "TAL")	return "album";
+	if (frameId == "TCON" || frameId == "TCO")	return "genre";
+	if (frameId == "TBPM" || frameId == "TBP")	return "bpm";
+	if (frameId == "TKEY" || frameId == "TKE")	return "key";
+	if (frameId == "TLEN" || frameId == "TLE")	return "length";
+	return {};
+}
+
+// Bytes searched after the ID3v2 tag for the first MPEG audio frame
+static constexpr int maxFrameSearchSize = 64 * 1024;
+
+// Sizes in ID3v2 headers use 7 bits per byte
+static int readSyncsafeInt(const juce::uint8* bytes)
+{
+	return ((bytes[0] & 0x7f) << 21) | ((bytes[1] & 0x7f) << 14) | ((bytes[2] & 0x7f) << 7) | (bytes[3] & 0x7f);
+}
+
+void TrackTagReader::readFileTags(const juce::File& audioTrackFile, TrackLibrary::TrackInfo& trackInfo)
+{
+	std::unique_ptr<juce::FileInputStream> input(audioTrackFile.createInputStream());
+
+	if (input == nullptr || input->failedToOpen())
+	{
+		DBG("TrackTagReader::readFileTags cannot open " << audioTrackFile.getFullPathName());
+		return;
+	}
+
+	if (trackInfo.format == TrackLibrary::AudioFormat::FLAC)
+	{
+		readFlacVorbisComment(*input, trackInfo);
+		return;
+	}
+
+	// ID3v2 at the start first, then the older ID3v1 trailer fills in anything missing
+	juce::int64 audioStart = 0;
+	int tagLengthMs = 0;
+	readID3v2(*input, trackInfo, audioStart, tagLengthMs);
+
+	if (trackInfo.format == TrackLibrary::AudioFormat::MP3)
+	{
+		readID3v1(*input, trackInfo);
+		readMP3Length(*input, audioStart, tagLengthMs, trackInfo);
+	}
+}
+
+void TrackTagReader::readReaderMetadata(const juce::StringPairArray& metadataValues, TrackLibrary::TrackInfo& trackInfo)
+{
+	// Ogg Vorbis comments
+	setField("title", metadataValues.getValue(juce::OggVorbisAudioFormat::id3title, {}), trackInfo);
+	setField("artist", metadataValues.getValue(juce::OggVorbisAudioFormat::id3artist, {}), trackInfo);
+	setField("album", metadataValues.getValue(juce::OggVorbisAudioFormat::id3album, {}), trackInfo);
+	setField("genre", metadataValues.getValue(juce::OggVorbisAudioFormat::id3genre, {}), trackInfo);
+
+	// WAV LIST INFO chunk
+	setField("title", metadataValues.getValue("INAM", {}), trackInfo);
+	setField("artist", metadataValues.getValue("IART", {}), trackInfo);
+	setField("album", metadataValues.getValue("IPRD", {}), trackInfo);
+	setField("genre", metadataValues.getValue("IGNR", {}), trackInfo);
+}
+
+bool TrackTagReader::readID3v2(juce::InputStream& input, TrackLibrary::TrackInfo& trackInfo, juce::int64& audioStart, int& tagLengthMs)
+{
+	juce::uint8 header[10];
+	audioStart = 0;
+	tagLengthMs = 0;
+
+	if (input.read(header, 10) != 10 || std::memcmp(header, "ID3", 3) != 0)
+	{
+		return false;
+	}
+
+	const int majorVersion = header[3];
+	const int flags = header[5];
+
+	if (majorVersion < 2 || majorVersion > 4)
+	{
+		return false;
+	}
+
+	const juce::int64 tagEnd = 10 + readSyncsafeInt(header + 6);
+
+	// An ID3v2.4 tag may end with a 10 byte footer
+	audioStart = tagEnd + ((majorVersion == 4 && (flags & 0x10) != 0) ? 10 : 0);
+
+	// Skip the extended header
+	if (majorVersion >= 3 && (flags & 0x40) != 0)
+	{
+		juce::uint8 sizeBytes[4];
+		if (input.read(sizeBytes, 4) != 4)
+		{
+			return true;
+		}
+
+		int extendedSize = (majorVersion == 4) ? readSyncsafeInt(sizeBytes) - 4
+											   : static_cast<int>(juce::ByteOrder::bigEndianInt(sizeBytes));
+		input.skipNextBytes(extendedSize);
+	}
+
+	const int idLength = (majorVersion == 2) ? 3 : 4;
+	const int frameHeaderSize = (majorVersion == 2) ? 6 : 10;
+	std::vector<juce::uint8> payload;
+
+	while (input.getPosition() + frameHeaderSize <= tagEnd)
+	{
+		juce::uint8 frameHeader[10];
+		if (input.read(frameHeader, frameHeaderSize) != frameHeaderSize)
+		{
+			break;
+		}
+
+		// Padding after the last frame
+		if (frameHeader[0] == 0)
+		{
+			break;
+		}
+
+		int frameSize = 0;
+		if (majorVersion == 2)
+		{
+			frameSize = (frameHeader[3] << 16) | (frameHeader[4] << 8) | frameHeader[5];
+		}
+		else if (majorVersion == 3)
+		{
+			frameSize = static_cast<int>(juce::ByteOrder::bigEndianInt(frameHeader + 4));
+		}
+		else
+		{
+			frameSize = readSyncsafeInt(frameHeader + 4);
+		}
+
+		if (frameSize <= 0 || input.getPosition() + frameSize > tagEnd)
+		{
+			break;
+		}
+
+		juce::String field = getID3Field(juce::String(reinterpret_cast<const char*>(frameHeader), static_cast<size_t>(idLength)));
+
+		if (field.isNotEmpty() && frameSize <= maxTagValueSize)
+		{
+			payload.resize(static_cast<size_t>(frameSize));
+			if (input.read(payload.data(), frameSize) != frameSize)
+			{
+				break;
+			}
+
+			const juce::String value = decodeID3Text(payload.data(), frameSize);
+
+			if (field == "length")
+			{
+				tagLengthMs = value.getIntValue();
+			}
+			else
+			{
+				setField(field, value, trackInfo);
+			}
+		}
+		else
+		{
+			// Never read frames we do not need, such as artwork
+			input.skipNextBytes(frameSize);
+		}
+	}
+	return true;
+}
+
+bool TrackTagReader::readID3v1(juce::InputStream& input, TrackLibrary::TrackInfo& trackInfo)
+{
+	const juce::int64 totalLength = input.getTotalLength();
+
+	if (totalLength < 128 || !input.setPosition(totalLength - 128))
+	{
+		return false;
+	}
+
+	juce::uint8 tag[128];
+	if (input.read(tag, 128) != 128 || std::memcmp(tag, "TAG", 3) != 0)
+	{
+		return false;
+	}
+
+	// Fixed width ISO-8859-1 fields padded with zeros or spaces
+	auto readText = [&tag](int offset, int length)
+		{
+			juce::String text;
+			for (int i = offset; i < offset + length && tag[i] != 0; ++i)
+			{
+				text += static_cast<juce::juce_wchar>(tag[i]);
+			}
+			return text.trim();
+		};
+
+	setField("title", readText(3, 30), trackInfo);
+	setField("artist", readText(33, 30), trackInfo);
+	setField("album", readText(63, 30), trackInfo);
+
+	const int genre = tag[127];
+	if (genre < juce::numElementsInArray(id3Genres))
+	{
+		setField("genre", id3Genres[genre], trackInfo);
+	}
+	return true;
+}
+
+bool TrackTagReader::readMP3Length(juce::InputStream& input, juce::int64 audioStart, int tagLengthMs, TrackLibrary::TrackInfo& trackInfo)
+{
+	if (!input.setPosition(audioStart))
+	{
+		return false;
+	}
+
+	std::vector<juce::uint8> data(static_cast<size_t>(maxFrameSearchSize));
+	const int numRead = input.read(data.data(), maxFrameSearchSize);
+
+	// The first frame header: 11 sync bits, then a valid version, layer and sample rate
+	for (int i = 0; i + 4 <= numRead; ++i)
+	{
+		const juce::uint8* frame = data.data() + i;
+
+		if (frame[0] != 0xff || (frame[1] & 0xe0) != 0xe0)
+		{
+			continue;
+		}
+
+		const int version = (frame[1] >> 3) & 3;		// 0 is MPEG 2.5, 2 is MPEG 2, 3 is MPEG 1
+		const int layer = (frame[1] >> 1) & 3;			// 1 is Layer III, 2 is Layer II, 3 is Layer I
+		const int bitrateIndex = frame[2] >> 4;
+		const int sampleRateIndex = (frame[2] >> 2) & 3;
+
+		if (version == 1 || layer == 0 || bitrateIndex == 15 || sampleRateIndex == 3)
+		{
+			continue;
+		}
+
+		const int sampleRates[] = { 44100, 48000, 32000 };
+		const int sampleRate = sampleRates[sampleRateIndex] >> (version == 3 ? 0 : (version == 2 ? 1 : 2));
+		const bool isMpeg1 = version == 3;
+		const bool isMono = (frame[3] >> 6) == 3;
+		const int samplesPerFrame = layer == 3 ? 384 : (layer == 2 || isMpeg1 ? 1152 : 576);
+
+		trackInfo.sampleRate = static_cast<juce::uint32>(sampleRate);
+
+		auto readBigEndian = [&](int offset)
+			{
+				return i + offset + 4 <= numRead ? static_cast<juce::int64>(juce::ByteOrder::bigEndianInt(frame + offset)) : 0;
+			};
+
+		// Encoders write the frame count into the first frame, as a Xing or Info tag after the side information
+		const int xingOffset = 4 + (isMpeg1 ? (isMono ? 17 : 32) : (isMono ? 9 : 17));
+
+		if (layer == 1 && i + xingOffset + 8 <= numRead
+			&& (std::memcmp(frame + xingOffset, "Xing", 4) == 0 || std::memcmp(frame + xingOffset, "Info", 4) == 0)
+			&& (readBigEndian(xingOffset + 4) & 1) != 0)
+		{
+			trackInfo.lengthInSamples = readBigEndian(xingOffset + 8) * samplesPerFrame;
+			return trackInfo.lengthInSamples > 0;
+		}
+
+		// or as a VBRI tag 32 bytes after the header
+		if (layer == 1 && i + 36 + 18 <= numRead && std::memcmp(frame + 36, "VBRI", 4) == 0)
+		{
+			trackInfo.lengthInSamples = readBigEndian(36 + 14) * samplesPerFrame;
+			return trackInfo.lengthInSamples > 0;
+		}
+
+		// Otherwise the ID3 tag's length, if it has one
+		if (tagLengthMs > 0)
+		{
+			trackInfo.lengthInSamples = static_cast<juce::int64>(tagLengthMs) * sampleRate / 1000;
+			return true;
+		}
+
+		return false;
+	}
+
+	return false;
+}
+
+bool TrackTagReader::readFlacVorbisComment(juce::InputStream& input, TrackLibrary::TrackInfo& trackInfo)
+{
+	char magic[4];
+	if (input.read(magic, 4) != 4 || std::memcmp(magic, "fLaC", 4) != 0)
+	{
+		return false;
+	}
+
+	for (;;)
+	{
+		juce::uint8 blockHeader[4];
+		if (input.read(blockHeader, 4) != 4)
+		{
+			return false;
+		}
+
+		const bool isLastBlock = (blockHeader[0] & 0x80) != 0;
+		const int blockType = blockHeader[0] & 0x7f;
+		const int blockSize = (blockHeader[1] << 16) | (blockHeader[2] << 8) | blockHeader[3];
+
+		// Type 4 is VORBIS_COMMENT, every other block (including artwork) is skipped
+		if (blockType == 4 && blockSize <= 1024 * 1024)
+		{
+			std::vector<juce::uint8> block(static_cast<size_t>(blockSize));
+			if (input.read(block.data(), blockSize) != blockSize)
+			{
+				return false;
+			}
+
+			// Little endian length prefixed vendor string, comment count, then "KEY=value" comments
+			int position = 0;
+			auto readLength = [&block, &position, blockSize]() -> int
+				{
+					if (position + 4 > blockSize)
+					{
+						return -1;
+					}
+					int length = static_cast<int>(juce::ByteOrder::littleEndianInt(block.data() + position));
+					position += 4;
+					return length;
+				};
+
+			int vendorLength = readLength();
+			if (vendorLength < 0 || position + vendorLength > blockSize)
+			{
+				return false;
+			}
+			position += vendorLength;
+
+			int numComments = readLength();
+			for (int i = 0; i < numComments; ++i)
+			{
+				int commentLength = readLength();
+				if (commentLength < 0 || position + commentLength > blockSize)
+				{
+					break;
+				}
+
+				juce::String comment = juce::String::fromUTF8(reinterpret_cast<const char*>(block.data() + position), commentLength);
+				position += commentLength;
+
+				juce::String key = comment.upToFirstOccurrenceOf("=", false, false).toLowerCase();
+				juce::String value = comment.fromFirstOccurrenceOf("=", false, false);
+
+				if (key == "initialkey")
+				{
+					key = "key";
+				}
+				setField(key, value, trackInfo);
+			}
+			return true;
+		}
+
+		input.skipNextBytes(blockSize);
+
+		if (isLastBlock)
+		{
+			return false;
+		}
+	}
+}
+
+juce::String TrackTagReader::decodeID3Text(const juce::uint8* data, int size)
+{
+	if (size < 1)
+	{
+		return {};
+	}
+
+	const int encoding = data[0];
+	const juce::uint8* text = data + 1;
+	const int length = size - 1;
+	juce::String result;
+
+	if (encoding == 0)
+	{
+		// ISO-8859-1
+		for (int i = 0; i < length && text[i] != 0; ++i)
+		{
+			result += static_cast<juce::juce_wchar>(text[i]);
+		}
+	}
+	else if (encoding == 3)
+	{
+		// UTF-8
+		int end = 0;
+		while (end < length && text[end] != 0)
+		{
+			++end;
+		}
+		result = juce::String::fromUTF8(reinterpret_cast<const char*>(text), end);
+	}
+	else
+	{
+		// UTF-16 with a byte order mark (1) or big endian without one (2)
+		bool bigEndian = (encoding == 2);
+		int i = 0;
+
+		if (encoding == 1 && length >= 2)
+		{
+			bigEndian = (text[0] == 0xfe && text[1] == 0xff);
+			if ((text[0] == 0xfe && text[1] == 0xff) || (text[0] == 0xff && text[1] == 0xfe))
+			{
+				i = 2;
+			}
+		}
+
+		auto readUnit = [text, bigEndian](int index) -> juce::uint32
+			{
+				return bigEndian ? static_cast<juce::uint32>((text[index] << 8) | text[index + 1])
+								 : static_cast<juce::uint32>((text[index + 1] << 8) | text[index]);
+			};
+
+		for (; i + 1 < length; i += 2)
+		{
+			juce::uint32 unit = readUnit(i);
+			if (unit == 0)
+			{
+				break;
+			}
+
+			// Combine surrogate pairs
+			if (unit >= 0xd800 && unit < 0xdc00 && i + 3 < length)
+			{
+				juce::uint32 low = readUnit(i + 2);
+				if (low >= 0xdc00 && low < 0xe000)
+				{
+					unit = 0x10000 + ((unit - 0xd800) << 10) + (low - 0xdc00);
+					i += 2;
+				}
+			}
+			result += static_cast<juce::juce_wchar>(unit);
+		}
+	}
+	return result.trim();
+}
+
+void TrackTagReader::setField(const juce::String& field, const juce::String& value, TrackLibrary::TrackInfo& trackInfo)
+{
+	juce::String trimmedValue = value.trim();
+
+	if (trimmedValue.isEmpty())
+	{
+		return;
+	}
+
+	if (field == "title" && trackInfo.title.isEmpty())
+	{
+		trackInfo.title = trimmedValue;
+	}
+	else if (field == "artist" && trackInfo.artist.isEmpty())
+	{
+		trackInfo.artist = trimmedValue;
+	}
+	else if (field == "album" && trackInfo.album.isEmpty())
+	{
+		trackInfo.album = trimmedValue;
+	}
+	else if (field == "genre" && trackInfo.genre.isEmpty())
+	{
+		trackInfo.genre = resolveGenre(trimmedValue);
+	}
+	else if (field == "bpm" && trackInfo.bpm <= 0.0f)
+	{
+		trackInfo.bpm = trimmedValue.getFloatValue();
+	}
+	else if (field == "key" && trackInfo.key.isEmpty())
+	{
+		trackInfo.key = trimmedValue;
+	}
+}
+
+juce::String TrackTagReader::resolveGenre(const juce::String& genre)
+{
+	// "(17)" or "(17)Rock" in ID3v2.3, or a bare "17" in ID3v2.4
+	juce::String number = genre.startsWithChar('(') ? genre.fromFirstOccurrenceOf("(", false, false).upToFirstOccurrenceOf(")", false, false)
+													: genre;
+
+	if (number.containsOnly("0123456789") && number.isNotEmpty())
+	{
+		juce::String name = genre.fromFirstOccurrenceOf(")", false, false).trim();
+		if (name.isNotEmpty())
+		{
+			return name;
+		}
+
+		int index = number.getIntValue();
+		if (index < juce::numElementsInArray(id3Genres))
+		{
+			return id3Genres[index];
+		}
+	}
+	return genre;
+}
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+	TrackTagReader.h
+	Created: 18 Oct 2026 2:48:30pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TrackLibrary.h"
+
+/**
+ * TrackTagReader class fills in an audio track's artist, title, album, genre,
+ * BPM and key from the tags stored in the audio file.
+ *
+ * ID3v2 frames (MP3), the ID3v1 trailer (MP3) and FLAC Vorbis comments are
+ * parsed directly from the file, reading only the tag bytes and skipping
+ * frames that are not needed (such as embedded artwork). An MP3's length
+ * is read from its first frame or its tag when either records it. Tags exposed by
+ * juce::AudioFormatReader::metadataValues (Ogg Vorbis comments, WAV INFO
+ * chunks) are read from the reader.
+ *
+ * Fields that are already filled in are never overwritten, so the most
+ * reliable source should be read first.
+ */
+class TrackTagReader
+{
+public:
+	/**
+	 * Reads the tags stored in the audio file's header or trailer.
+	 *
+	 * @param audioTrackFile	The audio track's file.
+	 * @param trackInfo			The audio track's metadata to fill in.
+	 */
+	static void readFileTags(const juce::File& audioTrackFile, TrackLibrary::TrackInfo& trackInfo);
+
+	/**
+	 * Reads the tags exposed by an audio format reader.
+	 *
+	 * @param metadataValues	The reader's metadata values.
+	 * @param trackInfo			The audio track's metadata to fill in.
+	 */
+	static void readReaderMetadata(const juce::StringPairArray& metadataValues, TrackLibrary::TrackInfo& trackInfo);
+
+private:
+	/**
+	 * Parses an ID3v2 tag at the start of the stream.
+	 *
+	 * @param audioStart	Set to where the audio starts after the tag, or 0 if there is no tag.
+	 * @param tagLengthMs	Set to the tag's length in milliseconds, or 0 if it has none.
+	 * @return				True if an ID3v2 tag was found.
+	 */
+	static bool readID3v2(juce::InputStream& input, TrackLibrary::TrackInfo& trackInfo, juce::int64& audioStart, int& tagLengthMs);
+
+	/**
+	 * Parses the 128 byte ID3v1 trailer at the end of the stream.
+	 *
+	 * @return True if an ID3v1 tag was found.
+	 */
+	static bool readID3v1(juce::InputStream& input, TrackLibrary::TrackInfo& trackInfo);
+
+	/**
+	 * Reads an MP3's length and sample rate from its first frame, without
+	 * scanning the rest: the frame count of a Xing, Info or VBRI tag, or
+	 * else the length in the ID3 tag.
+	 *
+	 * @param audioStart	Where the audio starts after any ID3v2 tag.
+	 * @param tagLengthMs	The ID3 tag's length in milliseconds, or 0 if it has none.
+	 * @return				True if the length was found.
+	 */
+	static bool readMP3Length(juce::InputStream& input, juce::int64 audioStart, int tagLengthMs, TrackLibrary::TrackInfo& trackInfo);
+
+	/**
+	 * Parses the Vorbis comment block of a FLAC stream.
+	 *
+	 * @return True if a Vorbis comment block was found.
+	 */
+	static bool readFlacVorbisComment(juce::InputStream& input, TrackLibrary::TrackInfo& trackInfo);
+
+	/**
+	 * Decodes the payload of an ID3v2 text frame (encoding byte followed by text).
+	 *
+	 * @param data		Frame payload.
+	 * @param size		Frame payload size in bytes.
+	 * @return			The first text value of the frame.
+	 */
+	static juce::String decodeID3Text(const juce::uint8* data, int size);
+
+	/**
+	 * Stores a tag value in the matching field if that field is still empty.
+	 *
+	 * @param field			Lower case field name (title, artist, album, genre, bpm, key).
+	 * @param value			Tag value.
+	 * @param trackInfo		The audio track's metadata to fill in.
+	 */
+	static void setField(const juce::String& field, const juce::String& value, TrackLibrary::TrackInfo& trackInfo);
+
+	/**
+	 * Replaces numeric ID3 genre references such as "(17)" with their names.
+	 *
+	 * @param genre		Genre text from the tag.
+	 * @return			Readable genre.
+	 */
+	static juce::String resolveGenre(const juce::String& genre);
+};
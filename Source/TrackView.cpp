@@ -0,0 +1,180 @@
+/*
+  ==============================================================================
+
+	TrackView.cpp
+	Created: 18 Oct 2026 11:31:47am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "TrackView.h"
+
+TrackView::TrackView(const TrackLibrary& _trackLibrary)
+	: trackLibrary(_trackLibrary)
+{
+
+}
+
+TrackView::~TrackView()
+{
+
+}
+
+void TrackView::tracksChanged()
+{
+	// Every cached permutation refers to the old audio tracks
+	sortedPermutationValid.fill(false);
+
+	rebuildRows();
+}
+
+void TrackView::setFilter(const std::vector<int>& trackIndices)
+{
+	filterOrder = trackIndices;
+	isFiltered = true;
+
+	rebuildRows();
+}
+
+void TrackView::clearFilter()
+{
+	filterOrder.clear();
+	isFiltered = false;
+
+	rebuildRows();
+}
+
+void TrackView::setSortOrder(SortKey key, bool forwards)
+{
+	sortKey = key;
+	sortForwards = forwards;
+
+	rebuildRows();
+}
+
+int TrackView::getNumRows() const
+{
+	return static_cast<int>(rows.size());
+}
+
+int TrackView::getTrackIndex(int row) const
+{
+	if (row < 0 || row >= static_cast<int>(rows.size()))
+	{
+		return -1;
+	}
+	return rows[row];
+}
+
+const std::vector<int>& TrackView::getSortedPermutation(SortKey key, bool forwards)
+{
+	// Keys sort round the Camelot wheel, minor before major, unknown keys first
+	auto camelotOrder = [](int musicalKey)
+		{
+			if (musicalKey == KeyDetector::unknownKey)
+			{
+				return 0;
+			}
+			return KeyDetector::getCamelotNumber(musicalKey) * 2 + (musicalKey < 12 ? 1 : 0);
+		};
+
+	const int slot = static_cast<int>(key) * 2 + (forwards ? 0 : 1);
+	auto& permutation = sortedPermutations[slot];
+
+	if (!sortedPermutationValid[slot])
+	{
+		const int numTracks = trackLibrary.getNumTracks();
+		permutation.resize(numTracks);
+
+		for (int i = 0; i < numTracks; ++i)
+		{
+			permutation[i] = i;
+		}
+
+		auto isBefore = [this, key, camelotOrder](int a, int b)
+			{
+				switch (key)
+				{
+				case SortKey::Title:
+					return trackLibrary.getTitle(a).compareNatural(trackLibrary.getTitle(b)) < 0;
+				case SortKey::Artist:
+					return trackLibrary.getArtist(a).compareNatural(trackLibrary.getArtist(b)) < 0;
+				case SortKey::Length:
+					return trackLibrary.getLengthInSeconds(a) < trackLibrary.getLengthInSeconds(b);
+				case SortKey::Type:
+					return TrackLibrary::getFormatName(trackLibrary.getFormat(a))
+						.compare(TrackLibrary::getFormatName(trackLibrary.getFormat(b))) < 0;
+				case SortKey::Loudness:
+					return trackLibrary.getLoudness(a) < trackLibrary.getLoudness(b);
+				case SortKey::Key:
+					return camelotOrder(trackLibrary.getDetectedKey(a)) < camelotOrder(trackLibrary.getDetectedKey(b));
+				case SortKey::None:
+				default:
+					return false;
+				}
+			};
+
+		// Stable with the comparison flipped, not reversed, so equal keys keep playlist order
+		std::stable_sort(permutation.begin(), permutation.end(), [&isBefore, forwards](int a, int b)
+			{
+				return forwards ? isBefore(a, b) : isBefore(b, a);
+			});
+
+		sortedPermutationValid[slot] = true;
+	}
+	return permutation;
+}
+
+void TrackView::rebuildRows()
+{
+	const int numTracks = trackLibrary.getNumTracks();
+	rows.clear();
+
+	// Drop filtered indices that no longer exist
+	if (isFiltered)
+	{
+		filterOrder.erase(std::remove_if(filterOrder.begin(), filterOrder.end(),
+			[numTracks](int index) { return index < 0 || index >= numTracks; }),
+			filterOrder.end());
+	}
+
+	if (sortKey == SortKey::None)
+	{
+		if (isFiltered)
+		{
+			rows = filterOrder;
+		}
+		else
+		{
+			rows.resize(numTracks);
+			for (int i = 0; i < numTracks; ++i)
+			{
+				rows[i] = i;
+			}
+		}
+	}
+	else
+	{
+		const auto& permutation = getSortedPermutation(sortKey, sortForwards);
+
+		if (isFiltered)
+		{
+			filterMask.assign(numTracks, false);
+			for (int index : filterOrder)
+			{
+				filterMask[index] = true;
+			}
+		}
+
+		rows.reserve(isFiltered ? filterOrder.size() : permutation.size());
+
+		for (int index : permutation)
+		{
+			if (!isFiltered || filterMask[index])
+			{
+				rows.push_back(index);
+			}
+		}
+	}
+}
@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+	TrackView.h
+	Created: 18 Oct 2026 11:31:47am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+#include "TrackLibrary.h"
+
+/**
+ * TrackView class is a filtered and sorted view over the playlist's track library.
+ *
+ * The table never indexes the track library directly. Instead each table row
+ * is mapped through this view to an audio track index, so sorting and
+ * searching never copy or reorder the audio tracks themselves.
+ *
+ * One sorted permutation is cached per sort key and direction and reused
+ * until the audio tracks change, so switching between columns or directions
+ * only rebuilds the visible rows from a cached permutation.
+ */
+class TrackView
+{
+public:
+	/**
+	 * Columns the view can be sorted by.
+	 */
+	enum class SortKey { None, Title, Artist, Length, Type, Loudness, Key };
+
+	/**
+	 * Constructor for the TrackView class.
+	 *
+	 * @param _trackLibrary		The track library this view maps onto.
+	 */
+	TrackView(const TrackLibrary& _trackLibrary);
+
+	/**
+	 * Destructor for the TrackView class.
+	 */
+	~TrackView();
+
+	/**
+	 * Drops the cached sort orders and rebuilds the rows.
+	 * Call whenever audio tracks are added or removed, or their analysis changes.
+	 */
+	void tracksChanged();
+
+	/**
+	 * Restricts the view to the given audio tracks.
+	 * While unsorted, rows keep the order given here (e.g. search ranking).
+	 *
+	 * @param trackIndices		Audio track indices to show.
+	 */
+	void setFilter(const std::vector<int>& trackIndices);
+
+	/**
+	 * Removes the filter so every audio track is shown.
+	 */
+	void clearFilter();
+
+	/**
+	 * Sorts the view by the given column.
+	 *
+	 * @param key			Column to sort by, or None to keep the filter order.
+	 * @param forwards		True for ascending, false for descending.
+	 */
+	void setSortOrder(SortKey key, bool forwards);
+
+	/**
+	 * Returns the number of visible rows.
+	 *
+	 * @return The number of visible rows.
+	 */
+	int getNumRows() const;
+
+	/**
+	 * Maps a visible row to its audio track index.
+	 *
+	 * @param row		The visible row.
+	 * @return			The audio track index, or -1 if the row is out of range.
+	 */
+	int getTrackIndex(int row) const;
+
+private:
+	/**
+	 * Returns the permutation of all audio tracks for the key and direction,
+	 * sorting only the first time they are requested. Equal keys keep
+	 * playlist order in both directions.
+	 *
+	 * @param key			Column to sort by.
+	 * @param forwards		True for ascending, false for descending.
+	 * @return				Audio track indices in sorted order.
+	 */
+	const std::vector<int>& getSortedPermutation(SortKey key, bool forwards);
+
+	/**
+	 * Rebuilds the visible rows from the filter and sort order.
+	 */
+	void rebuildRows();
+
+	/**
+	 * The track library this view maps onto.
+	 */
+	const TrackLibrary& trackLibrary;
+
+	/**
+	 * Filtered audio track indices in filter order, and a membership flag per track.
+	 */
+	std::vector<int> filterOrder;
+	std::vector<bool> filterMask;
+	bool isFiltered = false;
+
+	/**
+	 * Current sort column and direction.
+	 */
+	SortKey sortKey = SortKey::None;
+	bool sortForwards = true;
+
+	/**
+	 * Cached permutation and validity flag for each sort key, ascending then descending.
+	 */
+	static constexpr int numSortKeys = 7;
+	std::array<std::vector<int>, numSortKeys * 2> sortedPermutations;
+	std::array<bool, numSortKeys * 2> sortedPermutationValid{};
+
+	/**
+	 * Audio track index of each visible row.
+	 */
+	std::vector<int> rows;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackView)
+};
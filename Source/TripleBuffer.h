@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+	TripleBuffer.h
+	Created: 23 Oct 2026 9:40:26am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+/**
+ * TripleBuffer class passes the latest value from one writer thread to one
+ * reader thread without locks or waiting on either side.
+ *
+ * The writer fills its own copy and swaps it with the middle one, the reader
+ * swaps the middle one with its own copy if it is newer. Each side only
+ * ever touches its own copy, so a value is never read while being written.
+ * Values the reader misses are skipped; only the latest one matters.
+ */
+template <typename ValueType>
+class TripleBuffer
+{
+public:
+	/**
+	 * Constructor for the TripleBuffer class.
+	 */
+	TripleBuffer() = default;
+
+	/**
+	 * Returns the writer's copy to fill before publish. Writer thread only.
+	 *
+	 * @return The value being written.
+	 */
+	ValueType& getWriteValue()
+	{
+		return values[static_cast<size_t>(writeIndex)];
+	}
+
+	/**
+	 * Makes the writer's copy the latest value. Writer thread only.
+	 */
+	void publish()
+	{
+		const int previous = middle.exchange(writeIndex | freshFlag, std::memory_order_acq_rel);
+		writeIndex = previous & indexMask;
+	}
+
+	/**
+	 * Returns the latest value published. Reader thread only.
+	 *
+	 * @return The latest value, or the last one read if nothing new was published.
+	 */
+	const ValueType& read()
+	{
+		if ((middle.load(std::memory_order_relaxed) & freshFlag) != 0)
+		{
+			const int previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+			readIndex = previous & indexMask;
+		}
+
+		return values[static_cast<size_t>(readIndex)];
+	}
+
+private:
+	static constexpr int indexMask = 3;
+	static constexpr int freshFlag = 4;
+
+	std::array<ValueType, 3> values{};
+
+	/**
+	 * Copy owned by each side, and the middle one with a flag set when it is new.
+	 */
+	int writeIndex = 0;
+	std::atomic<int> middle{ 1 };
+	int readIndex = 2;
+
+	JUCE_DECLARE_NON_COPYABLE(TripleBuffer)
+};
@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+	VUMeter.cpp
+	Created: 23 Oct 2026 11:14:38am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "VUMeter.h"
+
+//==============================================================================
+VUMeter::VUMeter()
+{
+	setInterceptsMouseClicks(false, false);
+	startTimerHz(30);
+}
+
+VUMeter::~VUMeter()
+{
+	stopTimer();
+}
+
+void VUMeter::setMeter(LevelMeter* _meter)
+{
+	meter = _meter;
+	reading = {};
+	repaint();
+}
+
+void VUMeter::setShowsLimiter(bool shouldShow)
+{
+	showsLimiter = shouldShow;
+	repaint();
+}
+
+void VUMeter::timerCallback()
+{
+	if (meter != nullptr)
+	{
+		reading = meter->getReading();
+		repaint();
+	}
+}
+
+float VUMeter::levelToProportion(float decibels)
+{
+	return juce::jlimit(0.0f, 1.0f, (decibels - minimumDb) / -minimumDb);
+}
+
+void VUMeter::paint(juce::Graphics& g)
+{
+	auto bounds = getLocalBounds().toFloat();
+
+	// The limiter readout along the bottom
+	if (showsLimiter)
+	{
+		const auto readoutArea = bounds.removeFromBottom(bounds.getHeight() * 0.4f);
+
+		g.setColour(reading.gainReductionDb > 0.05f ? juce::Colours::orange : juce::Colours::cyan);
+		g.setFont(readoutArea.getHeight() * 0.9f);
+		g.drawText("TP " + (reading.truePeakDb > minimumDb ? juce::String(reading.truePeakDb, 1) : juce::String("-INF"))
+			+ "  GR " + juce::String(reading.gainReductionDb, 1),
+			readoutArea, juce::Justification::centredRight, true);
+	}
+
+	const bool vertical = bounds.getHeight() > bounds.getWidth();
+
+	g.setColour(juce::Colours::black.withAlpha(0.6f));
+	g.fillRect(bounds);
+
+	// Part of the meter from its start to a level
+	auto levelArea = [&bounds, vertical](float decibels)
+		{
+			const float proportion = levelToProportion(decibels);
+			return vertical ? bounds.withTop(bounds.getBottom() - bounds.getHeight() * proportion)
+				: bounds.withWidth(bounds.getWidth() * proportion);
+		};
+
+	// RMS bar, green up to -18dB, then yellow, then red from -6dB
+	const auto rmsArea = levelArea(reading.rmsDb);
+	g.setColour(reading.rmsDb > -6.0f ? juce::Colours::red
+		: reading.rmsDb > -18.0f ? juce::Colours::yellow : juce::Colours::limegreen);
+	g.fillRect(rmsArea);
+
+	// Peak line and short-term loudness tick
+	auto drawMark = [&g, &bounds, vertical](float proportion, float thickness)
+		{
+			if (vertical)
+			{
+				const float y = bounds.getBottom() - bounds.getHeight() * proportion;
+				g.fillRect(bounds.getX(), y - thickness * 0.5f, bounds.getWidth(), thickness);
+			}
+			else
+			{
+				const float x = bounds.getX() + bounds.getWidth() * proportion;
+				g.fillRect(x - thickness * 0.5f, bounds.getY(), thickness, bounds.getHeight());
+			}
+		};
+
+	if (reading.peakDb > minimumDb)
+	{
+		g.setColour(reading.peakDb > -0.5f ? juce::Colours::red : juce::Colours::white);
+		drawMark(levelToProportion(reading.peakDb), 2.0f);
+	}
+
+	if (reading.shortTermLufs > minimumDb)
+	{
+		g.setColour(juce::Colours::cyan);
+		drawMark(levelToProportion(reading.shortTermLufs), 1.0f);
+	}
+
+	if (showsLimiter)
+	{
+		// Gain reduction hangs down from 0dB, over the levels
+		if (reading.gainReductionDb > 0.05f)
+		{
+			const auto reducedArea = levelArea(-reading.gainReductionDb);
+			g.setColour(juce::Colours::orange.withAlpha(0.6f));
+			g.fillRect(vertical ? bounds.withBottom(reducedArea.getY()) : bounds.withLeft(reducedArea.getRight()));
+		}
+
+		if (reading.truePeakDb > minimumDb)
+		{
+			g.setColour(juce::Colours::orange);
+			drawMark(levelToProportion(reading.truePeakDb), 1.0f);
+		}
+	}
+
+	g.setColour(juce::Colours::darkcyan);
+	g.drawRect(bounds, 1.0f);
+}
@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+	VUMeter.h
+	Created: 23 Oct 2026 11:14:38am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LevelMeter.h"
+
+/**
+ * VUMeter class shows the levels of a LevelMeter: a bar for the RMS level,
+ * a line for the peak, and a tick for the short-term loudness. It is drawn
+ * upwards when taller than wide, otherwise from left to right.
+ *
+ * A meter after a limiter can also show the true peak going into it as an
+ * orange line, the gain reduction as a bar down from 0dB, and both as text
+ * along the bottom.
+ *
+ * The levels are read without locks on a timer, so the meter must be the
+ * LevelMeter's only reader.
+ */
+class VUMeter : public juce::Component,
+	public juce::Timer
+{
+public:
+	/**
+	 * Constructor for the VUMeter class.
+	 */
+	VUMeter();
+
+	/**
+	 * Destructor for the VUMeter class.
+	 */
+	~VUMeter() override;
+
+	/**
+	 * Sets the meter shown.
+	 *
+	 * @param _meter	The meter to read, or nullptr to show nothing.
+	 */
+	void setMeter(LevelMeter* _meter);
+
+	/**
+	 * Shows the true peak and gain reduction of the limiter before the meter.
+	 *
+	 * @param shouldShow	True to show the limiter's levels.
+	 */
+	void setShowsLimiter(bool shouldShow);
+
+	/**
+	 * Paints the levels.
+	 *
+	 * @param g Graphics context to perform drawing operations.
+	 */
+	void paint(juce::Graphics& g) override;
+
+	/**
+	 * Timer
+	 * Reads the latest levels and repaints.
+	 */
+	void timerCallback() override;
+
+private:
+	/**
+	 * Returns how far along the meter a level is drawn.
+	 */
+	static float levelToProportion(float decibels);
+
+	/**
+	 * Meter being shown.
+	 */
+	LevelMeter* meter = nullptr;
+
+	/**
+	 * Levels last read.
+	 */
+	LevelMeter::Reading reading;
+
+	/**
+	 * Whether the limiter's levels are shown.
+	 */
+	bool showsLimiter = false;
+
+	/**
+	 * Lowest level shown, in decibels.
+	 */
+	static constexpr float minimumDb = -48.0f;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VUMeter)
+};
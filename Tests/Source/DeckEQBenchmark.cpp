@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+	DeckEQBenchmark.cpp
+	Created: 25 Oct 2026 11:20:08am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cmath>
+#include "../../Source/DeckEQ.h"
+#include "TestAudioFiles.h"
+
+/**
+ * DeckEQBenchmark class times one deck's EQ on stereo noise, with the band
+ * gains gliding between blocks as when the knobs are turned, and reports
+ * the nanoseconds it takes per sample.
+ */
+class DeckEQBenchmark : public juce::UnitTest
+{
+public:
+	DeckEQBenchmark() : juce::UnitTest("DeckEQ nanoseconds per sample", "Benchmarks") {}
+
+	void runTest() override
+	{
+		beginTest("Stereo " + juce::String(blockSize) + " sample blocks at " + juce::String(sampleRate) + " Hz");
+
+		const juce::AudioBuffer<float> noise = TestAudioFiles::createNoise(0.5f, blockSize);
+		juce::AudioBuffer<float> buffer(2, blockSize);
+		const juce::AudioSourceChannelInfo bufferToFill(&buffer, 0, blockSize);
+
+		DeckEQ eq;
+		eq.prepare(sampleRate);
+
+		double bestNanoseconds = 0.0;
+		double totalNanoseconds = 0.0;
+		float outputSum = 0.0f;
+
+		for (int round = -1; round < numRounds; ++round)
+		{
+			const juce::int64 start = juce::Time::getHighResolutionTicks();
+
+			for (int block = 0; block < blocksPerRound; ++block)
+			{
+				// Keep the gains moving, so the smoothing is timed too
+				const float sweep = (block % 64) / 32.0f;
+				eq.setGain(DeckEQ::Low, sweep);
+				eq.setGain(DeckEQ::High, 2.0f - sweep);
+				eq.setKill(DeckEQ::Mid, block % 128 == 0);
+
+				buffer.makeCopyOf(noise, true);
+				eq.process(bufferToFill);
+				outputSum += buffer.getSample(0, block % blockSize);
+			}
+
+			const double nanoseconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start)
+				* 1.0e9 / (static_cast<double>(blocksPerRound) * blockSize);
+
+			// The first round only warms up the caches
+			if (round >= 0)
+			{
+				bestNanoseconds = round == 0 ? nanoseconds : juce::jmin(bestNanoseconds, nanoseconds);
+				totalNanoseconds += nanoseconds;
+			}
+		}
+
+		logMessage("DeckEQ: best " + juce::String(bestNanoseconds, 2) + " ns, mean "
+			+ juce::String(totalNanoseconds / numRounds, 2) + " ns per stereo sample per deck");
+
+		expect(std::isfinite(outputSum), "the EQ's output is not finite");
+
+		// Anything near a sample period would leave nothing for the rest of the deck
+		expectLessThan(bestNanoseconds, 1.0e9 / sampleRate);
+	}
+
+private:
+	static constexpr double sampleRate = 48000.0;
+	static constexpr int blockSize = 512;
+	static constexpr int numRounds = 5;
+	static constexpr int blocksPerRound = 2000;
+};
+
+static DeckEQBenchmark deckEQBenchmark;
@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+	Main.cpp
+	Created: 25 Oct 2026 10:02:17am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "../../Source/OfflineRenderer.h"
+
+/**
+ * Writes log messages to standard output, where a console shows them on
+ * every platform, instead of the debugger's output.
+ */
+class ConsoleLogger : public juce::Logger
+{
+	void logMessage(const juce::String& message) override
+	{
+		std::cout << message << std::endl;
+	}
+};
+
+//==============================================================================
+/**
+ * Runs the Otodecks tests, or with --bench the benchmarks, and exits with 1
+ * if any failed. With --render <script> <output> it renders a script as the
+ * application does, printing any error to the console.
+ */
+int main(int argc, char* argv[])
+{
+	juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+	ConsoleLogger logger;
+	juce::Logger::setCurrentLogger(&logger);
+
+	// Rebuild the command line as the application gets it, quoting paths with spaces
+	juce::StringArray args;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const juce::String arg = juce::CharPointer_UTF8(argv[i]);
+		args.add(arg.containsChar(' ') ? arg.quoted() : arg);
+	}
+
+	int exitCode = 0;
+
+	if (!OfflineRenderer::runFromCommandLine(args.joinIntoString(" "), exitCode))
+	{
+		juce::UnitTestRunner runner;
+		runner.setAssertOnFailure(false);
+		runner.runTestsInCategory(args.contains("--bench") ? "Benchmarks" : "Otodecks");
+
+		for (int i = 0; i < runner.getNumResults(); ++i)
+		{
+			if (runner.getResult(i)->failures > 0)
+			{
+				exitCode = 1;
+			}
+		}
+	}
+
+	juce::Logger::setCurrentLogger(nullptr);
+	return exitCode;
+}
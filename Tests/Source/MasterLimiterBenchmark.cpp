@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+	MasterLimiterBenchmark.cpp
+	Created: 25 Oct 2026 2:26:55pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/MasterLimiter.h"
+#include "TestAudioFiles.h"
+
+/**
+ * MasterLimiterBenchmark class times the master limiter on stereo noise
+ * loud enough to keep it reducing gain all the time, and reports the
+ * nanoseconds it takes per sample and its share of the block period.
+ */
+class MasterLimiterBenchmark : public juce::UnitTest
+{
+public:
+	MasterLimiterBenchmark() : juce::UnitTest("MasterLimiter cost", "Benchmarks") {}
+
+	void runTest() override
+	{
+		beginTest("Stereo " + juce::String(blockSize) + " sample blocks at 48 kHz, limiting all the time");
+
+		// Peaks over 3 dB above full scale, well over the ceiling
+		const juce::AudioBuffer<float> noise = TestAudioFiles::createNoise(1.5f, blockSize * 64);
+		juce::AudioBuffer<float> buffer(2, blockSize);
+
+		MasterLimiter limiter;
+		limiter.prepare(sampleRate);
+
+		double bestNanoseconds = 0.0;
+		double totalNanoseconds = 0.0;
+		float maxGainReductionDb = 0.0f;
+		float outputPeak = 0.0f;
+
+		for (int round = -1; round < numRounds; ++round)
+		{
+			const juce::int64 start = juce::Time::getHighResolutionTicks();
+
+			for (int block = 0; block < blocksPerRound; ++block)
+			{
+				const int noiseStart = (block % 64) * blockSize;
+				buffer.copyFrom(0, 0, noise, 0, noiseStart, blockSize);
+				buffer.copyFrom(1, 0, noise, 1, noiseStart, blockSize);
+
+				limiter.process(buffer, 0, blockSize);
+
+				maxGainReductionDb = juce::jmax(maxGainReductionDb, limiter.getGainReductionDb());
+				outputPeak = juce::jmax(outputPeak, buffer.getMagnitude(0, blockSize));
+			}
+
+			const double nanoseconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start)
+				* 1.0e9 / (static_cast<double>(blocksPerRound) * blockSize);
+
+			// The first round only warms up the caches
+			if (round >= 0)
+			{
+				bestNanoseconds = round == 0 ? nanoseconds : juce::jmin(bestNanoseconds, nanoseconds);
+				totalNanoseconds += nanoseconds;
+			}
+		}
+
+		const double meanNanoseconds = totalNanoseconds / numRounds;
+		const double shareOfBlock = meanNanoseconds * sampleRate / 1.0e9;
+
+		logMessage("MasterLimiter: best " + juce::String(bestNanoseconds, 2) + " ns, mean "
+			+ juce::String(meanNanoseconds, 2) + " ns per stereo sample, "
+			+ juce::String(shareOfBlock * 100.0, 3) + "% of the block period, "
+			+ juce::String(limiter.getLatencySamples()) + " samples latency, up to "
+			+ juce::String(maxGainReductionDb, 1) + " dB gain reduction");
+
+		// Timed while limiting, and the ceiling held
+		expectGreaterThan(maxGainReductionDb, 3.0f);
+		expectLessOrEqual(outputPeak, juce::Decibels::decibelsToGain(-1.0f) + 1.0e-4f);
+
+		expectLessThan(bestNanoseconds, 1.0e9 / sampleRate);
+	}
+
+private:
+	static constexpr double sampleRate = 48000.0;
+	static constexpr int blockSize = 128;
+	static constexpr int numRounds = 5;
+	static constexpr int blocksPerRound = 8000;
+};
+
+static MasterLimiterBenchmark masterLimiterBenchmark;
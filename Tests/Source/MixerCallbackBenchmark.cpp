@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+	MixerCallbackBenchmark.cpp
+	Created: 25 Oct 2026 1:48:13pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/CallbackProfiler.h"
+#include "../../Source/DJAudioPlayer.h"
+#include "../../Source/MixerEngine.h"
+#include "../../Source/SamplerEngine.h"
+#include "TestAudioFiles.h"
+
+/**
+ * MixerCallbackBenchmark class times the worst case audio callback: both
+ * decks playing off speed with every effect, the filter and the EQ on,
+ * both cued, and sound effect pads playing over them, through the mixer
+ * in 128 sample blocks at 48 kHz.
+ *
+ * Callbacks are timed by the application's own profiler. The 99.9th
+ * percentile must stay under a quarter of the block period; the slowest
+ * callback is logged too, but left unchecked, as a busy machine can
+ * preempt any single callback.
+ */
+class MixerCallbackBenchmark : public juce::UnitTest
+{
+public:
+	MixerCallbackBenchmark() : juce::UnitTest("Mixer worst case callback", "Benchmarks") {}
+
+	void runTest() override
+	{
+		beginTest("Every effect on both decks, " + juce::String(blockSize) + " samples at 48 kHz");
+
+		TestAudioFiles files;
+
+		// 44.1 kHz tracks, so the decks resample as well
+		const juce::File track = files.writeWav("Noise.wav", TestAudioFiles::createNoise(0.5f, 44100 * 30), 44100.0);
+		files.writeWav("Pads/1 Noise.wav", TestAudioFiles::createNoise(0.5f, 48000), 48000.0);
+		files.writeWav("Pads/2 Noise.wav", TestAudioFiles::createNoise(0.5f, 24000, 2), 48000.0);
+
+		juce::AudioFormatManager formatManager;
+		formatManager.registerBasicFormats();
+
+		DJAudioPlayer player1{ formatManager };
+		DJAudioPlayer player2{ formatManager };
+		SamplerEngine sampler;
+		MixerEngine mixerEngine{ player1, player2, sampler };
+		CallbackProfiler profiler;
+
+		mixerEngine.setProfiler(&profiler);
+		mixerEngine.prepareToPlay(blockSize, sampleRate);
+		profiler.prepare(sampleRate);
+
+		for (auto* player : { &player1, &player2 })
+		{
+			player->loadURL(juce::URL(track));
+			player->setBpm(124.0);
+			player->setSpeed(1.03);
+			player->setFilter(0.4);
+			player->setEQGain(DeckEQ::Low, 1.5);
+			player->setEQGain(DeckEQ::High, 0.5);
+			player->setEffectsMix(0.5);
+
+			for (int effect = 0; effect < DeckEffects::numEffects; ++effect)
+			{
+				player->setEffectEnabled(static_cast<DeckEffects::Effect>(effect), true);
+			}
+
+			player->start();
+		}
+
+		mixerEngine.setCue(0, true);
+		mixerEngine.setCue(1, true);
+		mixerEngine.setCueMix(0.5f);
+		sampler.setSamplePack(SamplePack::loadFromFolder(formatManager, files.getFolder().getChildFile("Pads")));
+
+		// Master on the first two channels, cue on the last two
+		juce::AudioBuffer<float> buffer(4, blockSize);
+		const juce::AudioSourceChannelInfo bufferToFill(&buffer, 0, blockSize);
+
+		// A second to let the tracks decode ahead, then time from fresh statistics
+		const int numWarmUpCallbacks = static_cast<int>(sampleRate / blockSize);
+
+		for (int callback = 0; callback < numWarmUpCallbacks + numCallbacks; ++callback)
+		{
+			if (callback == numWarmUpCallbacks)
+			{
+				profiler.reset();
+			}
+
+			// Keep pads playing, past the polyphony so voices are stolen too
+			if (callback % 8 == 0)
+			{
+				sampler.triggerPad((callback / 8) % 2, SamplerEngine::PadSettings());
+			}
+
+			profiler.beginCallback();
+			mixerEngine.getNextAudioBlock(bufferToFill);
+			profiler.endCallback(blockSize);
+		}
+
+		mixerEngine.releaseResources();
+
+		const auto snapshot = profiler.getSnapshot();
+		const double budgetMilliseconds = snapshot.blockMilliseconds * maxShareOfBlock;
+		const double p999Milliseconds = snapshot.getPercentileMilliseconds(99.9);
+
+		logMessage("Mixer callback of " + juce::String(snapshot.blockMilliseconds, 3) + " ms block: mean "
+			+ juce::String(snapshot.meanMilliseconds, 3) + " ms, p99.9 under " + juce::String(p999Milliseconds, 3)
+			+ " ms, max " + juce::String(snapshot.maxMilliseconds, 3) + " ms, budget "
+			+ juce::String(budgetMilliseconds, 3) + " ms, over " + juce::String(snapshot.numCallbacks) + " callbacks");
+
+		logMessage("Decks: A mean " + juce::String(snapshot.deckMeanMilliseconds[0], 3) + " ms, B mean "
+			+ juce::String(snapshot.deckMeanMilliseconds[1], 3) + " ms");
+
+		expectEquals(static_cast<int>(snapshot.numCallbacks), numCallbacks);
+		expectLessThan(p999Milliseconds, budgetMilliseconds);
+	}
+
+private:
+	static constexpr double sampleRate = 48000.0;
+	static constexpr int blockSize = 128;
+	static constexpr int numCallbacks = 8000;
+	static constexpr double maxShareOfBlock = 0.25;
+};
+
+static MixerCallbackBenchmark mixerCallbackBenchmark;
@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+	OfflineRendererTests.cpp
+	Created: 25 Oct 2026 10:11:36am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cmath>
+#include "../../Source/OfflineRenderer.h"
+#include "TestAudioFiles.h"
+
+/**
+ * OfflineRendererTests class renders a scripted tone through the whole
+ * mixer and checks the file against the tone: the same file every time,
+ * the script's length, and the tone's level and pitch.
+ *
+ * The decks' crossover EQ is allpass at flat gains, so the render is not
+ * sample for sample the tone, but its level and pitch are unchanged.
+ */
+class OfflineRendererTests : public juce::UnitTest
+{
+public:
+	OfflineRendererTests() : juce::UnitTest("OfflineRenderer", "Otodecks") {}
+
+	void runTest() override
+	{
+		TestAudioFiles files;
+		files.writeWav("Tone.wav", TestAudioFiles::createSine(1000.0, 0.25f, 3.0, sampleRate), sampleRate);
+
+		const juce::File script = files.writeText("Tone.txt",
+			"# Deck A alone at full level\n"
+			"0 load A Tone.wav\n"
+			"0 crossfader 0\n"
+			"0 play A\n"
+			"2 end\n");
+
+		beginTest("A script error names its line");
+		{
+			OfflineRenderer renderer(sampleRate);
+			const juce::File badScript = files.writeText("Bad.txt", "0 load A Tone.wav\n1 speed A 7\n");
+
+			expect(!renderer.loadScript(badScript));
+			expect(renderer.getError().contains("line 2"), renderer.getError());
+		}
+
+		beginTest("The render is as long as the script");
+		const juce::AudioBuffer<float> first = render(script, files.getFolder().getChildFile("First.wav"));
+		expectEquals(first.getNumChannels(), 2);
+		expectEquals(first.getNumSamples(), static_cast<int>(2.0 * sampleRate));
+
+		beginTest("Rendering again gives the same file");
+		const juce::AudioBuffer<float> second = render(script, files.getFolder().getChildFile("Second.wav"));
+		expectEquals(second.getNumSamples(), first.getNumSamples());
+
+		float maxDifference = 0.0f;
+
+		for (int channel = 0; channel < juce::jmin(first.getNumChannels(), second.getNumChannels()); ++channel)
+		{
+			for (int i = 0; i < juce::jmin(first.getNumSamples(), second.getNumSamples()); ++i)
+			{
+				maxDifference = juce::jmax(maxDifference, std::abs(first.getSample(channel, i) - second.getSample(channel, i)));
+			}
+		}
+
+		expectEquals(maxDifference, 0.0f);
+
+		beginTest("The tone keeps its level and pitch");
+		{
+			// After the play ramp and the EQ settling
+			const int start = static_cast<int>(0.1 * sampleRate);
+			const int numSamples = first.getNumSamples() - start;
+
+			if (numSamples > 0)
+			{
+				const float rms = first.getRMSLevel(0, start, numSamples);
+				expectWithinAbsoluteError(juce::Decibels::gainToDecibels(rms),
+					juce::Decibels::gainToDecibels(0.25f / juce::MathConstants<float>::sqrt2), 0.2f);
+
+				int numCrossings = 0;
+
+				for (int i = start + 1; i < first.getNumSamples(); ++i)
+				{
+					if (first.getSample(0, i - 1) < 0.0f && first.getSample(0, i) >= 0.0f)
+					{
+						++numCrossings;
+					}
+				}
+
+				const double frequency = numCrossings * sampleRate / numSamples;
+				expectWithinAbsoluteError(frequency, 1000.0, 2.0);
+			}
+		}
+	}
+
+private:
+	/**
+	 * Renders a script with a new renderer and reads the file back.
+	 *
+	 * @param script		The script to render.
+	 * @param output		The file to render to.
+	 * @return				The rendered audio, empty if the render failed.
+	 */
+	juce::AudioBuffer<float> render(const juce::File& script, const juce::File& output)
+	{
+		OfflineRenderer renderer(sampleRate);
+		expect(renderer.loadScript(script), renderer.getError());
+		expect(renderer.render(output), renderer.getError());
+
+		return TestAudioFiles::readAudio(output);
+	}
+
+	/**
+	 * Sample rate of the tone and the render.
+	 */
+	static constexpr double sampleRate = 44100.0;
+};
+
+static OfflineRendererTests offlineRendererTests;
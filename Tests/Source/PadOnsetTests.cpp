@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+	PadOnsetTests.cpp
+	Created: 25 Oct 2026 12:15:40pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cmath>
+#include "../../Source/OfflineRenderer.h"
+#include "../../Source/SamplerEngine.h"
+#include "TestAudioFiles.h"
+
+/**
+ * PadOnsetTests class renders pad presses scripted at exact times, from
+ * packs at and off the render's sample rate, and presses queued to the
+ * sampler ahead of time, and checks each click is heard at exactly the
+ * sample it was pressed for.
+ */
+class PadOnsetTests : public juce::UnitTest
+{
+public:
+	PadOnsetTests() : juce::UnitTest("Pad onsets", "Otodecks") {}
+
+	void runTest() override
+	{
+		TestAudioFiles files;
+
+		// A single sample click at the start of each pad
+		files.writeWav("Pads 48k/1 Click.wav", TestAudioFiles::createClicks({ 0 }, 1.0f, 0.1, 48000.0), 48000.0);
+		files.writeWav("Pads 44k/1 Click.wav", TestAudioFiles::createClicks({ 0 }, 1.0f, 0.1, 44100.0), 44100.0);
+
+		const juce::File script = files.writeText("Pads.txt",
+			"0 pads \"Pads 48k\"\n"
+			"0.5 pad 1\n"
+			"0.7503 pad 1\n"
+			"1 pads \"Pads 44k\"\n"
+			"1.2 pad 1\n"
+			"1.40017 pad 1\n"
+			"2 end\n");
+
+		const juce::File output = files.getFolder().getChildFile("Pads.wav");
+
+		beginTest("Pad presses render");
+		{
+			OfflineRenderer renderer(sampleRate, blockSize);
+			expect(renderer.loadScript(script), renderer.getError());
+			expect(renderer.render(output), renderer.getError());
+		}
+
+		const juce::AudioBuffer<float> audio = TestAudioFiles::readAudio(output);
+		expectEquals(audio.getNumSamples(), static_cast<int>(2.0 * sampleRate));
+
+		for (double seconds : { 0.5, 0.7503, 1.2, 1.40017 })
+		{
+			const int expected = static_cast<int>(std::llround(seconds * sampleRate));
+
+			beginTest("Pad scripted at " + juce::String(seconds, 5) + " s starts at sample " + juce::String(expected));
+
+			expectEquals(findOnset(audio, expected - searchRange, expected + searchRange), expected);
+		}
+
+		// The renderer starts a block at each command, so also queue presses ahead, landing inside blocks
+		beginTest("Presses queued ahead start inside a block");
+		{
+			juce::AudioFormatManager formatManager;
+			formatManager.registerBasicFormats();
+
+			SamplerEngine sampler;
+			sampler.setSamplePack(SamplePack::loadFromFolder(formatManager, files.getFolder().getChildFile("Pads 44k")));
+			sampler.prepareToPlay(blockSize, sampleRate);
+
+			const int presses[] = { 1234, 36014, 36014 + blockSize * 3 + 479 };
+
+			for (int press : presses)
+			{
+				sampler.triggerPadAtSample(0, SamplerEngine::PadSettings(), press);
+			}
+
+			juce::AudioBuffer<float> rendered(2, blockSize * 100);
+			rendered.clear();
+
+			for (int start = 0; start < rendered.getNumSamples(); start += blockSize)
+			{
+				sampler.getNextAudioBlock(juce::AudioSourceChannelInfo(&rendered, start, blockSize));
+			}
+
+			sampler.releaseResources();
+
+			for (int press : presses)
+			{
+				expectEquals(findOnset(rendered, press - searchRange / 4, press + searchRange / 4), press);
+			}
+		}
+	}
+
+private:
+	/**
+	 * Finds the first sample louder than the onset threshold.
+	 *
+	 * @param audio		The rendered audio.
+	 * @param start		First sample searched.
+	 * @param end		One past the last sample searched.
+	 * @return			The onset sample, or -1 if there is none.
+	 */
+	static int findOnset(const juce::AudioBuffer<float>& audio, int start, int end)
+	{
+		for (int i = juce::jmax(0, start); i < juce::jmin(end, audio.getNumSamples()); ++i)
+		{
+			if (std::abs(audio.getSample(0, i)) > threshold)
+			{
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+	static constexpr double sampleRate = 48000.0;
+	static constexpr int blockSize = 480;
+	static constexpr int searchRange = 4800;
+	static constexpr float threshold = 0.05f;
+};
+
+static PadOnsetTests padOnsetTests;
@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+	ReverseTests.cpp
+	Created: 25 Oct 2026 4:12:09pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/DeckSource.h"
+#include "../../Source/TrackCache.h"
+#include "TestAudioFiles.h"
+
+/**
+ * ReverseTests class plays reverse and censor through a deck's TrackCache,
+ * from a WAV and an MP3 audio track, waiting for every chunk as a render
+ * does.
+ *
+ * Reverse from a standstill should be the track read backwards, sample for
+ * sample, across the chunks the cache reads behind the playhead. Censor
+ * should carry on from where forward playback would have been.
+ *
+ * The MP3 is Fixtures/Noise.mp3, 3 seconds of random spectral lines at
+ * 48 kHz mono, in frames without a bit reservoir.
+ */
+class ReverseTests : public juce::UnitTest
+{
+public:
+	ReverseTests() : juce::UnitTest("Reverse and censor", "Otodecks") {}
+
+	void runTest() override
+	{
+		formatManager.registerBasicFormats();
+
+		TestAudioFiles files;
+		const juce::File wavFile = files.writeWav("Noise.wav", TestAudioFiles::createNoise(0.5f, 3 * 48000), sampleRate);
+
+		const juce::File mp3File = files.getFolder().getChildFile("Noise.mp3");
+		mp3File.replaceWithData(BinaryData::Noise_mp3, static_cast<size_t>(BinaryData::Noise_mp3Size));
+
+		// 24 bit WAV samples come back exactly; MP3 chunks decode from a seek, primed from earlier frames
+		testReverse(wavFile, 1.0e-6f);
+		testReverse(mp3File, 1.0e-4f);
+
+		testCensor(wavFile, 1.0e-6f);
+		testCensor(mp3File, 1.0e-4f);
+	}
+
+private:
+	/**
+	 * Plays backwards from 2.5 seconds for 2 seconds and compares with the
+	 * track read backwards.
+	 *
+	 * @param file			The audio track.
+	 * @param tolerance		Largest difference allowed from the track read forwards.
+	 */
+	void testReverse(const juce::File& file, float tolerance)
+	{
+		beginTest("Reverse from " + file.getFileExtension().substring(1).toUpperCase() + " reads the track backwards");
+
+		const juce::AudioBuffer<float> source = TestAudioFiles::readAudio(file);
+		DeckSource deck;
+
+		if (!loadTrack(deck, file))
+		{
+			return;
+		}
+
+		const int start = static_cast<int>(2.5 * sampleRate);
+		deck.jumpTo(start);
+		deck.setDirection(DeckSource::Direction::Reverse);
+		deck.start();
+
+		const juce::AudioBuffer<float> output = play(deck, static_cast<int>(2.0 * sampleRate));
+		deck.releaseResources();
+
+		expectGreaterThan(source.getMagnitude(0, 0, source.getNumSamples()), 0.01f, "the track is silent");
+
+		// After the first block, which fades in
+		float maxDifference = 0.0f;
+
+		for (int channel = 0; channel < output.getNumChannels(); ++channel)
+		{
+			const int sourceChannel = juce::jmin(channel, source.getNumChannels() - 1);
+
+			for (int i = blockSize; i < output.getNumSamples() && start - i >= 0; ++i)
+			{
+				maxDifference = juce::jmax(maxDifference, std::abs(output.getSample(channel, i) - source.getSample(sourceChannel, start - i)));
+			}
+		}
+
+		expectLessThan(maxDifference, tolerance);
+	}
+
+	/**
+	 * Plays forwards from 0.5 seconds, censors for a while, releases it and
+	 * compares with the track where forward playback would have been.
+	 *
+	 * @param file			The audio track.
+	 * @param tolerance		Largest difference allowed from the track read forwards.
+	 */
+	void testCensor(const juce::File& file, float tolerance)
+	{
+		beginTest("Censor from " + file.getFileExtension().substring(1).toUpperCase() + " resumes at the forward position");
+
+		const juce::AudioBuffer<float> source = TestAudioFiles::readAudio(file);
+		DeckSource deck;
+
+		if (!loadTrack(deck, file))
+		{
+			return;
+		}
+
+		const int start = static_cast<int>(0.5 * sampleRate);
+		const int numForward = 40 * blockSize;
+		const int numCensored = 40 * blockSize;
+		const int numAfter = 60 * blockSize;
+
+		deck.jumpTo(start);
+		deck.start();
+		play(deck, numForward);
+
+		deck.setDirection(DeckSource::Direction::Censor);
+		play(deck, numCensored);
+
+		// The playhead heard went backwards
+		expectLessThan(deck.getPosition(), static_cast<juce::int64>(start + numForward));
+
+		deck.setDirection(DeckSource::Direction::Forward);
+		const juce::AudioBuffer<float> output = play(deck, numAfter);
+		deck.releaseResources();
+
+		// Underneath, the playhead kept going forwards the whole time
+		const int resumed = start + numForward + numCensored;
+		expectEquals(deck.getPosition(), static_cast<juce::int64>(resumed + numAfter));
+
+		// After the crossfade from the censored position
+		float maxDifference = 0.0f;
+
+		for (int channel = 0; channel < output.getNumChannels(); ++channel)
+		{
+			const int sourceChannel = juce::jmin(channel, source.getNumChannels() - 1);
+
+			for (int i = blockSize; i < output.getNumSamples() && resumed + i < source.getNumSamples(); ++i)
+			{
+				maxDifference = juce::jmax(maxDifference, std::abs(output.getSample(channel, i) - source.getSample(sourceChannel, resumed + i)));
+			}
+		}
+
+		expectLessThan(maxDifference, tolerance);
+	}
+
+	/**
+	 * Prepares a deck and loads an audio track whose cache waits for chunks.
+	 *
+	 * @param deck		The deck.
+	 * @param file		The audio track.
+	 * @return			True if the audio track could be read.
+	 */
+	bool loadTrack(DeckSource& deck, const juce::File& file)
+	{
+		std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+		expect(reader != nullptr, "cannot read " + file.getFullPathName());
+
+		if (reader == nullptr)
+		{
+			return false;
+		}
+
+		expectEquals(reader->sampleRate, sampleRate);
+
+		auto track = std::make_unique<TrackCache>(std::move(reader));
+		track->setWaitForChunks(true);
+
+		deck.prepareToPlay(blockSize, sampleRate);
+		deck.setTrack(std::move(track));
+		return true;
+	}
+
+	/**
+	 * Renders a deck for a number of samples in blocks.
+	 *
+	 * @param deck			The deck.
+	 * @param numSamples	Samples to render, a whole number of blocks.
+	 * @return				The stereo output.
+	 */
+	juce::AudioBuffer<float> play(DeckSource& deck, int numSamples)
+	{
+		juce::AudioBuffer<float> output(2, numSamples);
+		output.clear();
+
+		for (int start = 0; start + blockSize <= numSamples; start += blockSize)
+		{
+			deck.getNextAudioBlock(juce::AudioSourceChannelInfo(&output, start, blockSize));
+		}
+
+		return output;
+	}
+
+	/**
+	 * Track and output sample rate, equal so the playhead moves a whole sample each time.
+	 */
+	static constexpr double sampleRate = 48000.0;
+	static constexpr int blockSize = 480;
+
+	juce::AudioFormatManager formatManager;
+};
+
+static ReverseTests reverseTests;
@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+	SeekTests.cpp
+	Created: 25 Oct 2026 1:02:26pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cmath>
+#include "../../Source/DJAudioPlayer.h"
+#include "../../Source/OfflineRenderer.h"
+#include "TestAudioFiles.h"
+
+/**
+ * SeekTests class checks seeks land on the right source sample when the
+ * audio track's sample rate differs from the output's.
+ *
+ * A render that seeks to just before a click is compared with a render
+ * of a track with the click that far from its start, played at the time
+ * of the seek: both should hear the click at the same sample. Fast-forward
+ * and rewind are checked to move 10 seconds of the track's own samples.
+ */
+class SeekTests : public juce::UnitTest
+{
+public:
+	SeekTests() : juce::UnitTest("Seeks", "Otodecks") {}
+
+	void runTest() override
+	{
+		// Tracks at 44.1 kHz played at 48 kHz, and the other way round
+		testSeekRender(44100.0, 48000.0);
+		testSeekRender(48000.0, 44100.0);
+
+		testFastForwardAndRewind(44100.0, 48000.0);
+		testFastForwardAndRewind(48000.0, 44100.0);
+	}
+
+private:
+	/**
+	 * Renders a seek to 0.1 seconds before a click, and the click played
+	 * from 0.1 seconds into a track, and compares the two.
+	 *
+	 * @param trackRate		The tracks' sample rate.
+	 * @param outputRate	The render's sample rate.
+	 */
+	void testSeekRender(double trackRate, double outputRate)
+	{
+		beginTest("Seek in a " + juce::String(trackRate / 1000.0, 1) + " kHz track rendered at "
+			+ juce::String(outputRate / 1000.0, 1) + " kHz");
+
+		TestAudioFiles files;
+		files.writeWav("Late Click.wav", TestAudioFiles::createClicks({ static_cast<int>(trackRate) }, 0.5f, 2.0, trackRate), trackRate);
+		files.writeWav("Early Click.wav", TestAudioFiles::createClicks({ static_cast<int>(trackRate * 0.1) }, 0.5f, 2.0, trackRate), trackRate);
+
+		// Seeks to 0.9 s at 0.5 s, so the click at 1 s is heard at 0.6 s
+		const juce::File seekScript = files.writeText("Seek.txt",
+			"0 load A \"Late Click.wav\"\n"
+			"0 crossfader 0\n"
+			"0 play A\n"
+			"0.5 seek A 0.9\n"
+			"1 end\n");
+
+		// Plays from the start at 0.5 s, so the click at 0.1 s is heard at 0.6 s
+		const juce::File referenceScript = files.writeText("Reference.txt",
+			"0 load A \"Early Click.wav\"\n"
+			"0 crossfader 0\n"
+			"0.5 play A\n"
+			"1 end\n");
+
+		const juce::AudioBuffer<float> seek = render(seekScript, files.getFolder().getChildFile("Seek.wav"), outputRate);
+		const juce::AudioBuffer<float> reference = render(referenceScript, files.getFolder().getChildFile("Reference.wav"), outputRate);
+
+		expectEquals(seek.getNumSamples(), reference.getNumSamples());
+		expectGreaterThan(reference.getMagnitude(0, 0, reference.getNumSamples()), 0.1f, "the click was not rendered");
+
+		float maxDifference = 0.0f;
+
+		for (int channel = 0; channel < juce::jmin(seek.getNumChannels(), reference.getNumChannels()); ++channel)
+		{
+			for (int i = 0; i < juce::jmin(seek.getNumSamples(), reference.getNumSamples()); ++i)
+			{
+				maxDifference = juce::jmax(maxDifference, std::abs(seek.getSample(channel, i) - reference.getSample(channel, i)));
+			}
+		}
+
+		// Within the 24 bit files' rounding
+		expectLessThan(maxDifference, 1.0e-5f);
+	}
+
+	/**
+	 * Plays a track for a second, fast-forwards, then rewinds, checking the
+	 * position moves 10 seconds of the track's samples each time.
+	 *
+	 * @param trackRate		The track's sample rate.
+	 * @param outputRate	The output sample rate.
+	 */
+	void testFastForwardAndRewind(double trackRate, double outputRate)
+	{
+		beginTest("Fast-forward and rewind a " + juce::String(trackRate / 1000.0, 1) + " kHz track played at "
+			+ juce::String(outputRate / 1000.0, 1) + " kHz");
+
+		TestAudioFiles files;
+		const juce::File track = files.writeWav("Silence.wav", TestAudioFiles::createClicks({}, 0.0f, 25.0, trackRate), trackRate);
+
+		const int blockSize = 480;
+		juce::AudioFormatManager formatManager;
+		formatManager.registerBasicFormats();
+
+		DJAudioPlayer player(formatManager);
+		player.setWaitForAudio(true);
+		player.prepareToPlay(blockSize, outputRate);
+		player.loadURL(juce::URL(track));
+		player.start();
+
+		juce::AudioBuffer<float> buffer(2, blockSize);
+		const juce::AudioSourceChannelInfo bufferToFill(&buffer, 0, blockSize);
+
+		auto playBlocks = [&](int numBlocks)
+			{
+				for (int block = 0; block < numBlocks; ++block)
+				{
+					player.getNextAudioBlock(bufferToFill);
+				}
+			};
+
+		const juce::int64 tenSeconds = static_cast<juce::int64>(trackRate * 10.0);
+		const double blockAdvance = blockSize * trackRate / outputRate;
+
+		const int numBlocks = static_cast<int>(outputRate / blockSize);
+		playBlocks(numBlocks);
+
+		juce::int64 before = player.getPositionInSamples();
+		expectWithinAbsoluteError(static_cast<double>(before), numBlocks * blockAdvance, 2.0);
+
+		player.fastForward();
+		playBlocks(1);
+		expectWithinAbsoluteError(static_cast<double>(player.getPositionInSamples() - before), tenSeconds + blockAdvance, 2.0);
+
+		before = player.getPositionInSamples();
+		player.rewind();
+		playBlocks(1);
+		expectWithinAbsoluteError(static_cast<double>(player.getPositionInSamples() - before), blockAdvance - tenSeconds, 2.0);
+
+		player.releaseResources();
+	}
+
+	/**
+	 * Renders a script with a new renderer and reads the file back.
+	 *
+	 * @param script		The script to render.
+	 * @param output		The file to render to.
+	 * @param sampleRate	The render's sample rate.
+	 * @return				The rendered audio, empty if the render failed.
+	 */
+	juce::AudioBuffer<float> render(const juce::File& script, const juce::File& output, double sampleRate)
+	{
+		OfflineRenderer renderer(sampleRate);
+		expect(renderer.loadScript(script), renderer.getError());
+		expect(renderer.render(output), renderer.getError());
+
+		return TestAudioFiles::readAudio(output);
+	}
+};
+
+static SeekTests seekTests;
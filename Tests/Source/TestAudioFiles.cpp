@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+	TestAudioFiles.cpp
+	Created: 25 Oct 2026 10:04:51am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include "TestAudioFiles.h"
+#include <cmath>
+
+TestAudioFiles::TestAudioFiles()
+	: folder(juce::File::getSpecialLocation(juce::File::tempDirectory)
+		.getChildFile("Otodecks Tests").getNonexistentChildFile("Run", {}, false))
+{
+	folder.createDirectory();
+}
+
+TestAudioFiles::~TestAudioFiles()
+{
+	folder.deleteRecursively();
+}
+
+const juce::File& TestAudioFiles::getFolder() const
+{
+	return folder;
+}
+
+juce::File TestAudioFiles::writeWav(const juce::String& name, const juce::AudioBuffer<float>& audio, double sampleRate) const
+{
+	const juce::File file = folder.getChildFile(name);
+	file.getParentDirectory().createDirectory();
+	file.deleteFile();
+
+	juce::WavAudioFormat wavFormat;
+	std::unique_ptr<juce::OutputStream> stream = file.createOutputStream();
+
+	if (stream != nullptr)
+	{
+		std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(stream.get(), sampleRate,
+			static_cast<unsigned int>(audio.getNumChannels()), 24, {}, 0));
+
+		if (writer != nullptr)
+		{
+			// The writer owns the stream now
+			stream.release();
+			writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples());
+		}
+	}
+
+	return file;
+}
+
+juce::File TestAudioFiles::writeText(const juce::String& name, const juce::String& text) const
+{
+	const juce::File file = folder.getChildFile(name);
+	file.getParentDirectory().createDirectory();
+	file.replaceWithText(text);
+	return file;
+}
+
+juce::AudioBuffer<float> TestAudioFiles::readAudio(const juce::File& file)
+{
+	juce::AudioFormatManager formatManager;
+	formatManager.registerBasicFormats();
+
+	std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+	juce::AudioBuffer<float> audio;
+
+	if (reader != nullptr)
+	{
+		audio.setSize(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+		reader->read(&audio, 0, audio.getNumSamples(), 0, true, true);
+	}
+
+	return audio;
+}
+
+juce::AudioBuffer<float> TestAudioFiles::createSine(double frequency, float amplitude, double seconds, double sampleRate)
+{
+	juce::AudioBuffer<float> audio(2, juce::roundToInt(seconds * sampleRate));
+
+	for (int i = 0; i < audio.getNumSamples(); ++i)
+	{
+		const float sample = amplitude * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * frequency * i / sampleRate));
+		audio.setSample(0, i, sample);
+		audio.setSample(1, i, sample);
+	}
+
+	return audio;
+}
+
+juce::AudioBuffer<float> TestAudioFiles::createClicks(const std::vector<int>& clickSamples, float amplitude, double seconds, double sampleRate)
+{
+	juce::AudioBuffer<float> audio(2, juce::roundToInt(seconds * sampleRate));
+	audio.clear();
+
+	for (int clickSample : clickSamples)
+	{
+		if (juce::isPositiveAndBelow(clickSample, audio.getNumSamples()))
+		{
+			audio.setSample(0, clickSample, amplitude);
+			audio.setSample(1, clickSample, amplitude);
+		}
+	}
+
+	return audio;
+}
+
+juce::AudioBuffer<float> TestAudioFiles::createNoise(float amplitude, int numSamples, juce::int64 seed)
+{
+	juce::Random random(seed);
+	juce::AudioBuffer<float> audio(2, numSamples);
+
+	for (int channel = 0; channel < audio.getNumChannels(); ++channel)
+	{
+		for (int i = 0; i < numSamples; ++i)
+		{
+			audio.setSample(channel, i, amplitude * (random.nextFloat() * 2.0f - 1.0f));
+		}
+	}
+
+	return audio;
+}
@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+	TestAudioFiles.h
+	Created: 25 Oct 2026 10:04:51am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+/**
+ * TestAudioFiles class writes the audio files and scripts a test plays into
+ * a temporary folder, deleted along with it, and reads rendered files back.
+ */
+class TestAudioFiles
+{
+public:
+	/**
+	 * Constructor for the TestAudioFiles class.
+	 * Creates an empty temporary folder.
+	 */
+	TestAudioFiles();
+
+	/**
+	 * Destructor for the TestAudioFiles class.
+	 * Deletes the folder and everything written to it.
+	 */
+	~TestAudioFiles();
+
+	/**
+	 * Returns the temporary folder.
+	 *
+	 * @return The folder files are written to.
+	 */
+	const juce::File& getFolder() const;
+
+	/**
+	 * Writes audio to a 24 bit WAV file in the folder.
+	 *
+	 * @param name			The file's path in the folder.
+	 * @param audio			The audio to write.
+	 * @param sampleRate	The file's sample rate.
+	 * @return				The file written.
+	 */
+	juce::File writeWav(const juce::String& name, const juce::AudioBuffer<float>& audio, double sampleRate) const;
+
+	/**
+	 * Writes text, such as a render script, to a file in the folder.
+	 *
+	 * @param name			The file's path in the folder.
+	 * @param text			The text to write.
+	 * @return				The file written.
+	 */
+	juce::File writeText(const juce::String& name, const juce::String& text) const;
+
+	/**
+	 * Reads a whole audio file.
+	 *
+	 * @param file			The file to read.
+	 * @return				The audio, empty if the file cannot be read.
+	 */
+	static juce::AudioBuffer<float> readAudio(const juce::File& file);
+
+	/**
+	 * Creates a stereo sine tone.
+	 *
+	 * @param frequency		The tone's frequency in Hz.
+	 * @param amplitude		The tone's peak level.
+	 * @param seconds		The length.
+	 * @param sampleRate	The sample rate.
+	 * @return				The tone.
+	 */
+	static juce::AudioBuffer<float> createSine(double frequency, float amplitude, double seconds, double sampleRate);
+
+	/**
+	 * Creates stereo silence with a single sample click at each position.
+	 *
+	 * @param clickSamples	The samples the clicks are at.
+	 * @param amplitude		The clicks' level.
+	 * @param seconds		The length.
+	 * @param sampleRate	The sample rate.
+	 * @return				The clicks.
+	 */
+	static juce::AudioBuffer<float> createClicks(const std::vector<int>& clickSamples, float amplitude, double seconds, double sampleRate);
+
+	/**
+	 * Creates stereo white noise.
+	 *
+	 * @param amplitude		The noise's peak level.
+	 * @param numSamples	The length in samples.
+	 * @param seed			Seed of the random numbers, so every run gets the same noise.
+	 * @return				The noise.
+	 */
+	static juce::AudioBuffer<float> createNoise(float amplitude, int numSamples, juce::int64 seed = 1);
+
+private:
+	/**
+	 * Folder the files are written to.
+	 */
+	juce::File folder;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TestAudioFiles)
+};
@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+	TrackAnalyserBenchmark.cpp
+	Created: 25 Oct 2026 3:05:31pm
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/TrackAnalyser.h"
+#include "TestAudioFiles.h"
+
+/**
+ * TrackAnalyserBenchmark class analyses a batch of generated audio tracks,
+ * two for each core, and reports the tracks analysed per minute, both as
+ * measured and scaled to four minute tracks.
+ *
+ * The results arrive on the message thread, so the test runs the message
+ * loop until every audio track is delivered.
+ */
+class TrackAnalyserBenchmark : public juce::UnitTest
+{
+public:
+	TrackAnalyserBenchmark() : juce::UnitTest("TrackAnalyser tracks per minute", "Benchmarks") {}
+
+	void runTest() override
+	{
+		const int numCores = juce::SystemStats::getNumCpus();
+		const int numTracks = juce::jlimit(2, 32, numCores * 2);
+
+		beginTest(juce::String(numTracks) + " audio tracks of " + juce::String(juce::roundToInt(trackSeconds)) + " s on "
+			+ juce::String(numCores) + " cores");
+
+		// A C major chord, so every audio track has a key to find
+		juce::AudioBuffer<float> chord(2, static_cast<int>(trackSeconds * sampleRate));
+		chord.clear();
+
+		for (double frequency : { 261.63, 329.63, 392.0 })
+		{
+			const auto note = TestAudioFiles::createSine(frequency, 0.2f, trackSeconds, sampleRate);
+
+			for (int channel = 0; channel < chord.getNumChannels(); ++channel)
+			{
+				chord.addFrom(channel, 0, note, channel, 0, chord.getNumSamples());
+			}
+		}
+
+		TestAudioFiles files;
+		juce::Array<juce::File> trackFiles;
+
+		for (int i = 0; i < numTracks; ++i)
+		{
+			trackFiles.add(files.writeWav("Track " + juce::String(i + 1) + ".wav", chord, sampleRate));
+		}
+
+		juce::AudioFormatManager formatManager;
+		formatManager.registerBasicFormats();
+
+		std::vector<TrackAnalyser::Analysis> analyses;
+		TrackAnalyser analyser(formatManager);
+		analyser.onTracksAnalysed = [&analyses](const std::vector<TrackAnalyser::Analysis>& batch)
+			{
+				analyses.insert(analyses.end(), batch.begin(), batch.end());
+			};
+
+		const double startTime = juce::Time::getMillisecondCounterHiRes();
+
+		for (const auto& trackFile : trackFiles)
+		{
+			analyser.analyseFile(trackFile);
+		}
+
+		while (static_cast<int>(analyses.size()) < numTracks
+			&& juce::Time::getMillisecondCounterHiRes() - startTime < timeoutMilliseconds)
+		{
+			juce::MessageManager::getInstance()->runDispatchLoopUntil(10);
+		}
+
+		const double minutes = (juce::Time::getMillisecondCounterHiRes() - startTime) / 60000.0;
+		const double tracksPerMinute = analyses.size() / minutes;
+
+		logMessage("TrackAnalyser: " + juce::String(tracksPerMinute, 1) + " tracks of " + juce::String(juce::roundToInt(trackSeconds))
+			+ " s per minute, " + juce::String(tracksPerMinute * trackSeconds / 240.0, 1)
+			+ " four minute tracks per minute, " + juce::String(tracksPerMinute * trackSeconds / 60.0, 1)
+			+ " minutes of audio per minute");
+
+		expectEquals(static_cast<int>(analyses.size()), numTracks, "not every audio track was analysed in time");
+
+		// Each audio track's loudness is measured and its key is C major or next to it
+		int cMajor = KeyDetector::unknownKey;
+
+		for (int key = 0; key < KeyDetector::numKeys; ++key)
+		{
+			if (KeyDetector::getCamelotCode(key) == "8B")
+			{
+				cMajor = key;
+			}
+		}
+
+		for (const auto& analysis : analyses)
+		{
+			expect(analysis.loudness != TrackLibrary::unknownLoudness, "no loudness for " + analysis.url);
+			expect(KeyDetector::isHarmonicMatch(analysis.key, cMajor),
+				"key " + KeyDetector::getCamelotCode(analysis.key) + " for " + analysis.url);
+		}
+	}
+
+private:
+	static constexpr double sampleRate = 44100.0;
+	static constexpr double trackSeconds = 60.0;
+	static constexpr double timeoutMilliseconds = 600000.0;
+};
+
+static TrackAnalyserBenchmark trackAnalyserBenchmark;
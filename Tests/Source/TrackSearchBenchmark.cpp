@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+	TrackSearchBenchmark.cpp
+	Created: 25 Oct 2026 11:47:52am
+	Author:  cpng
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/TrackSearch.h"
+
+/**
+ * TrackSearchBenchmark class searches a synthetic library of 250,000
+ * tracks, built the way the playlist builds its search text, and reports
+ * the queries per second. The queries mix exact words, typos and words in
+ * no track.
+ */
+class TrackSearchBenchmark : public juce::UnitTest
+{
+public:
+	TrackSearchBenchmark() : juce::UnitTest("TrackSearch queries per second", "Benchmarks") {}
+
+	void runTest() override
+	{
+		beginTest(juce::String(numTracks) + " tracks");
+
+		juce::Random random(26);
+		juce::StringArray candidates;
+		candidates.ensureStorageAllocated(numTracks);
+
+		for (int i = 0; i < numTracks; ++i)
+		{
+			candidates.add(createTrackText(random));
+		}
+
+		// One track to look for, in the middle of the library
+		const int wantedIndex = numTracks / 2;
+		candidates.set(wantedIndex, "Midnight Harbour Lanterns Okonkwo Tidewater House 124 Am 8A");
+
+		TrackSearch trackSearch;
+		trackSearch.setCandidates(candidates);
+
+		const juce::StringArray queries{ "midnight harbour", "midnite harbor", "okonkwo", "okonkow",
+			"lanterns 124", "house 8a", "velvet", "velvte", "zzqx", "tidewater lantern" };
+
+		// Once untimed, to warm up the workers
+		trackSearch.search(queries[0]);
+
+		int numQueries = 0;
+		size_t numResults = 0;
+		const juce::int64 start = juce::Time::getHighResolutionTicks();
+
+		for (int round = 0; round < numRounds; ++round)
+		{
+			for (const auto& query : queries)
+			{
+				numResults += trackSearch.search(query).size();
+				++numQueries;
+			}
+		}
+
+		const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+		const double queriesPerSecond = seconds > 0.0 ? numQueries / seconds : 0.0;
+
+		logMessage("TrackSearch: " + juce::String(queriesPerSecond, 1) + " queries per second over "
+			+ juce::String(numTracks) + " tracks, " + juce::String(1000.0 / queriesPerSecond, 2)
+			+ " ms per query, " + juce::String(static_cast<double>(numResults) / numQueries, 0) + " results per query");
+
+		// The exact query finds the track first, the misspelt one still finds it
+		const auto exact = trackSearch.search("midnight harbour lanterns");
+		expect(!exact.empty() && exact.front().index == wantedIndex, "exact query did not rank the track first");
+
+		const auto typo = trackSearch.search("midnigt harbour");
+		bool typoFound = false;
+
+		for (size_t i = 0; i < juce::jmin<size_t>(10, typo.size()); ++i)
+		{
+			typoFound = typoFound || typo[i].index == wantedIndex;
+		}
+
+		expect(typoFound, "misspelt query did not rank the track in the first 10");
+	}
+
+private:
+	/**
+	 * Creates a track's search text: title, artist, album, genre, tempo and key.
+	 *
+	 * @param random	Random numbers, seeded so every run searches the same library.
+	 * @return			The track's search text.
+	 */
+	static juce::String createTrackText(juce::Random& random)
+	{
+		static const juce::StringArray words{ "love", "night", "city", "dream", "fire", "summer", "lost",
+			"heart", "light", "dance", "gold", "river", "shadow", "velvet", "echo", "storm", "neon",
+			"silver", "wild", "ocean", "electric", "paradise", "sunset", "forever", "rhythm", "horizon" };
+		static const juce::StringArray names{ "Aurora", "Kaskade", "Nova", "Lumen", "Delta", "Vega",
+			"Orion", "Ember", "Solis", "Mira", "Atlas", "Juno" };
+		static const juce::StringArray genres{ "House", "Techno", "Trance", "Drum and Bass", "Disco", "Garage" };
+		static const juce::StringArray keys{ "Am 8A", "C 8B", "Em 9A", "G 9B", "Dm 7A", "F 7B", "Bm 10A", "D 10B" };
+
+		auto pick = [&random](const juce::StringArray& list) { return list[random.nextInt(list.size())]; };
+
+		juce::String text;
+		const int numTitleWords = 2 + random.nextInt(3);
+
+		for (int i = 0; i < numTitleWords; ++i)
+		{
+			const juce::String word = pick(words);
+			text << word.substring(0, 1).toUpperCase() << word.substring(1) << " ";
+		}
+
+		text << pick(names) << " " << pick(names) << " " << pick(words) << " " << pick(genres)
+			<< " " << (110 + random.nextInt(40)) << " " << pick(keys);
+
+		return text;
+	}
+
+	static constexpr int numTracks = 250000;
+	static constexpr int numRounds = 5;
+};
+
+static TrackSearchBenchmark trackSearchBenchmark;